@@ -17,6 +17,7 @@ namespace simgrid {
 namespace kernel {
 namespace activity {
   class ActivityImpl;
+  class ActivitySetImpl;
   XBT_PUBLIC(void) intrusive_ptr_add_ref(ActivityImpl* activity);
   XBT_PUBLIC(void) intrusive_ptr_release(ActivityImpl* activity);
 }
@@ -47,6 +48,7 @@ typedef simgrid::s4u::File s4u_File;
 typedef simgrid::s4u::Storage s4u_Storage;
 typedef simgrid::s4u::NetZone s4u_NetZone;
 typedef simgrid::kernel::activity::ActivityImpl* smx_activity_t;
+typedef simgrid::kernel::activity::ActivitySetImpl* smx_activity_set_t;
 typedef simgrid::kernel::routing::NetPoint routing_NetPoint;
 typedef simgrid::surf::Resource surf_Resource;
 typedef simgrid::trace_mgr::trace tmgr_Trace;
@@ -60,6 +62,7 @@ typedef struct s4u_File s4u_File;
 typedef struct s4u_Storage s4u_Storage;
 typedef struct s4u_NetZone s4u_NetZone;
 typedef struct kernel_Activity* smx_activity_t;
+typedef struct kernel_ActivitySet* smx_activity_set_t;
 typedef struct routing_NetPoint routing_NetPoint;
 typedef struct surf_Resource surf_Resource;
 typedef struct Trace tmgr_Trace;
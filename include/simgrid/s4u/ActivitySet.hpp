@@ -0,0 +1,65 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_S4U_ACTIVITYSET_HPP
+#define SIMGRID_S4U_ACTIVITYSET_HPP
+
+#include <xbt/base.h>
+
+#include <list>
+#include <unordered_map>
+
+#include <simgrid/forward.h>
+#include <simgrid/s4u/Comm.hpp>
+#include <simgrid/s4u/forward.hpp>
+
+namespace simgrid {
+namespace s4u {
+
+/** @brief A set of communications that an actor waits on repeatedly
+ *
+ * Comm::wait_any() registers all the given communications in the kernel at each call, and unregisters them all
+ * afterward, which is costly when waiting in a loop on a large number of communications. An ActivitySet registers
+ * each communication only once, when it is added. Adding a communication, removing it and waiting for the next
+ * terminated one do not depend on the amount of communications in the set.
+ *
+ * Only one actor at a time can wait on a given set. The communications that terminate are returned in their order
+ * of termination, and removed from the set.
+ */
+XBT_PUBLIC_CLASS ActivitySet
+{
+public:
+  ActivitySet();
+  ~ActivitySet();
+  ActivitySet(ActivitySet const&) = delete;
+  ActivitySet& operator=(ActivitySet const&) = delete;
+
+  /** Adds a communication to the set, and starts it if it's not started yet. Detached communications are refused. */
+  void add(CommPtr comm);
+  /** Removes a communication that is still in the set */
+  void remove(CommPtr comm);
+
+  bool empty() const { return comms_.empty(); }
+  size_t size() const { return comms_.size(); }
+
+  /** Blocks until a communication of the set terminates, removes it from the set and returns it.
+   *
+   *  Returns nullptr if the set is empty. If the communication failed, it is removed from the set anyway and the
+   *  exception is raised. */
+  CommPtr wait_any() { return wait_any_for(-1); }
+  /** Same as wait_any(), but returns nullptr if no communication terminates within the timeout */
+  CommPtr wait_any_for(double timeout);
+
+private:
+  CommPtr take(kernel::activity::ActivityImpl* comm);
+
+  std::list<CommPtr> comms_; // in insertion order
+  std::unordered_map<kernel::activity::ActivityImpl*, std::list<CommPtr>::iterator> index_;
+  smx_activity_set_t pimpl_ = nullptr; // Not used when the model-checker is active
+};
+}
+} // namespace simgrid::s4u
+
+#endif /* SIMGRID_S4U_ACTIVITYSET_HPP */
@@ -18,6 +18,7 @@
 
 #include <xbt/Extendable.hpp>
 #include <xbt/functional.hpp>
+#include <xbt/random.hpp>
 #include <xbt/string.hpp>
 
 #include <simgrid/chrono.hpp>
@@ -333,6 +334,14 @@ namespace this_actor {
   /** @brief Returns the name of the current actor. */
   XBT_PUBLIC(std::string) name();
 
+  /** @brief Returns a stream of random numbers of the current actor.
+   *
+   *  The numbers only depend on the seed (--cfg=random/seed), on the pid of the actor and on the index, so that they
+   *  are the same whatever the order in which the actors run. Each call returns the stream from its beginning: keep
+   *  it while drawing, or use another index to get another independent stream.
+   */
+  XBT_PUBLIC(simgrid::xbt::RandomStream) randomStream(uint32_t index = 0);
+
   /** @brief Returns the name of the host on which the process is running. */
   XBT_PUBLIC(Host*) host();
 
@@ -8,6 +8,8 @@
 
 #include <xbt/base.h>
 
+#include <vector>
+
 #include <simgrid/forward.h>
 #include <simgrid/s4u/Activity.hpp>
 #include <simgrid/s4u/forward.hpp>
@@ -20,6 +22,8 @@ namespace s4u {
 XBT_PUBLIC_CLASS Comm : public Activity
 {
   Comm() : Activity() {}
+  friend ActivitySet;
+
 public:
   friend void intrusive_ptr_release(simgrid::s4u::Comm * c);
   friend void intrusive_ptr_add_ref(simgrid::s4u::Comm * c);
@@ -30,12 +34,11 @@ public:
    * iterator on the finished Comms. */
   template <class I> static I wait_any(I first, I last)
   {
+    start_all(first, last);
     // Map to dynar<Synchro*>:
     xbt_dynar_t comms = xbt_dynar_new(sizeof(simgrid::kernel::activity::ActivityImpl*), NULL);
     for (I iter = first; iter != last; iter++) {
       Comm& comm = **iter;
-      if (comm.state_ == inited)
-        comm.start();
       xbt_assert(comm.state_ == started);
       xbt_dynar_push_as(comms, simgrid::kernel::activity::ActivityImpl*, comm.pimpl_);
     }
@@ -53,12 +56,11 @@ public:
   /*! Same as wait_any, but with a timeout. If wait_any_for return because of the timeout last is returned.*/
   template <class I> static I wait_any_for(I first, I last, double timeout)
   {
+    start_all(first, last);
     // Map to dynar<Synchro*>:
     xbt_dynar_t comms = xbt_dynar_new(sizeof(simgrid::kernel::activity::ActivityImpl*), NULL);
     for (I iter = first; iter != last; iter++) {
       Comm& comm = **iter;
-      if (comm.state_ == inited)
-        comm.start();
       xbt_assert(comm.state_ == started);
       xbt_dynar_push_as(comms, simgrid::kernel::activity::ActivityImpl*, comm.pimpl_);
     }
@@ -73,6 +75,20 @@ public:
     (*res)->state_ = finished;
     return res;
   }
+  /*! take a range of s4u::Comm* (last excluded) and start the ones that are not started yet.
+   *
+   * They are all posted in a single simcall (in the order of the range) instead of paying one context switch per
+   * communication. Since this all happens at the same simulated date, the simulated behavior is unchanged. */
+  template <class I> static void start_all(I first, I last)
+  {
+    std::vector<Comm*> comms;
+    for (I iter = first; iter != last; iter++) {
+      Comm& comm = **iter;
+      if (comm.state_ == inited)
+        comms.push_back(&comm);
+    }
+    start_batch(comms);
+  }
   /** Creates (but don't start) an async send to the mailbox @p dest */
   static CommPtr send_init(MailboxPtr dest);
   /** Creates and start an async send to the mailbox @p dest */
@@ -110,6 +126,8 @@ public:
   void cancel();
 
 private:
+  static void start_batch(std::vector<Comm*> const& comms);
+
   double rate_        = -1;
   void* dstBuff_      = nullptr;
   size_t dstBuffSize_ = 0;
@@ -22,6 +22,23 @@ namespace kernel {
 class EngineImpl;
 }
 namespace s4u {
+/** @brief An actor to start with Engine::deploy(), as an <actor> tag of a deployment file would describe it */
+struct ActorDeployment {
+  Host* host;
+  /** Name of the function, as registered with Engine::registerFunction() */
+  const char* function;
+  /** Arguments of the function. The first one is the name of the actor */
+  std::vector<std::string> args;
+};
+
+/** @brief Memory used by a subsystem of the simulator, as returned by Engine::memoryUsage() (in bytes) */
+struct MemoryUsage {
+  /** platform, routing, lmm, stacks, traces, mailboxes, tracing or names */
+  std::string subsystem;
+  size_t current;
+  size_t peak;
+};
+
 /** @brief Simulation engine
  *
  * This class is an interface to the simulation engine.
@@ -58,15 +75,56 @@ public:
   /** @brief Load a deployment file and launch the actors that it contains */
   void loadDeployment(const char* deploy);
 
+  /** @brief Launch a whole table of actors at once
+   *
+   * This is the same as a deployment file, without the cost of the parsing. It is meant for very large populations
+   * of actors: the actors are created in one go, and they only get a context (and a stack) when they first run.
+   */
+  void deploy(std::vector<ActorDeployment> actors);
+
   size_t hostCount();
   void hostList(std::vector<Host*> * whereTo);
 
   /** @brief Run the simulation */
   void run();
 
+  /** @brief Run the simulation until the given date
+   *
+   * The simulation can then be resumed with run() or runUntil(). If it ends before that date, the clock is still
+   * advanced up to it.
+   */
+  void runUntil(double date);
+
+  /** @brief Fork the simulation into several independent branches, that each continue it on their own
+   *
+   * Each branch is a child process that gets a copy of the whole simulation at its current date, typically after a
+   * call to runUntil(). In the children, this returns the index of the branch (from 0 to count-1): they can then
+   * change the platform or the parameters of the actors before resuming the simulation with run(), and report their
+   * results with sendToParent(). The parent waits for the termination of all the children, and returns -1. If not
+   * null, results then contains what each branch sent, by index of branch.
+   *
+   * At most parallelism branches run at the same time (all of them if it is 0). Since the platform is only parsed
+   * once and shared by the branches until they modify it, this is also a cheap way to run a parameter sweep of many
+   * short simulations: fork right after loading the platform, and set up the actors in each branch.
+   *
+   * This is not possible with thread contexts nor with parallel contexts, since only the calling thread survives a
+   * fork. The output of all branches goes to the same terminal and files.
+   */
+  int fork(int count, std::vector<std::string>* results = nullptr, int parallelism = 0);
+
+  /** @brief From a branch created by fork(), send some data to the parent process */
+  void sendToParent(const std::string& data);
+
   /** @brief Retrieve the simulation time */
   static double getClock();
 
+  /** @brief Retrieve the current and peak memory usage of each subsystem of the simulator
+   *
+   * This is only accounted with --cfg=memory/accounting:yes (and all values are 0 otherwise). The same report is
+   * logged at the end of the simulation. The values are estimated from the size of the main data structures.
+   */
+  std::vector<MemoryUsage> memoryUsage();
+
   /** @brief Retrieve the engine singleton */
   static s4u::Engine* instance();
 
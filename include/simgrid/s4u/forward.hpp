@@ -16,6 +16,7 @@ class Actor;
 using ActorPtr = boost::intrusive_ptr<Actor>;
 
 class Activity;
+class ActivitySet;
 class Comm;
 using CommPtr = boost::intrusive_ptr<Comm>;
 class Engine;
@@ -315,6 +315,7 @@ XBT_PUBLIC(unsigned int) simcall_comm_waitany(xbt_dynar_t comms, double timeout)
 XBT_PUBLIC(void) simcall_comm_wait(smx_activity_t comm, double timeout);
 XBT_PUBLIC(int) simcall_comm_test(smx_activity_t comm);
 XBT_PUBLIC(int) simcall_comm_testany(smx_activity_t* comms, size_t count);
+XBT_PUBLIC(smx_activity_t) simcall_activity_set_waitany(smx_activity_set_t set, double timeout);
 
 /************************** Tracing handling **********************************/
 XBT_PUBLIC(void) simcall_set_category(smx_activity_t synchro, const char *category);
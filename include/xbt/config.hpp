@@ -8,6 +8,7 @@
 
 #include <xbt/base.h>
 
+#include <atomic>
 #include <cstdlib>
 
 #include <functional>
@@ -56,10 +57,72 @@ template<class T>
 XBT_PUBLIC(T const&) getConfig(const char* name);
 
 extern template XBT_PUBLIC(int const&) getConfig<int>(const char* name);
+extern template XBT_PUBLIC(unsigned long long const&) getConfig<unsigned long long>(const char* name);
 extern template XBT_PUBLIC(double const&) getConfig<double>(const char* name);
 extern template XBT_PUBLIC(bool const&) getConfig<bool>(const char* name);
 extern template XBT_PUBLIC(std::string const&) getConfig<std::string>(const char* name);
 
+// Watch config
+
+/** Calls the callback with the value of an option, now and whenever it changes
+ *
+ *  When several options are set together (from the command line, or by xbt_cfg_set_parse()), the callbacks are only
+ *  called once they are all set, so that they never see half of the changes.
+ */
+template<class T>
+XBT_PUBLIC(void) watchConfig(const char* name, std::function<void(T const&)> callback);
+
+extern template XBT_PUBLIC(void) watchConfig<int>(const char* name, std::function<void(int const&)> callback);
+extern template XBT_PUBLIC(void)
+    watchConfig<unsigned long long>(const char* name, std::function<void(unsigned long long const&)> callback);
+extern template XBT_PUBLIC(void) watchConfig<double>(const char* name, std::function<void(double const&)> callback);
+extern template XBT_PUBLIC(void) watchConfig<bool>(const char* name, std::function<void(bool const&)> callback);
+extern template XBT_PUBLIC(void)
+    watchConfig<std::string>(const char* name, std::function<void(std::string const&)> callback);
+
+/** Delays the callbacks of watchConfig() until its destruction, for the options changed meanwhile */
+XBT_PUBLIC_CLASS BulkUpdate {
+public:
+  BulkUpdate();
+  ~BulkUpdate();
+  BulkUpdate(BulkUpdate const&) = delete;
+  BulkUpdate& operator=(BulkUpdate const&) = delete;
+};
+
+/** A reference on the value of an option, for the code reading it often
+ *
+ *  The option is looked up by its name once, on the first read, so that a handle can be defined before the option is
+ *  declared. The following reads cost no lookup. A handle must not be read after the destruction of the configuration.
+ *
+ *  <pre><code>
+ *  static simgrid::config::Handle<int> thresh("smpi/async-small-thresh");
+ *  if (size < thresh) ...
+ *  </code></pre>
+ */
+template<class T>
+class Handle {
+  const char* name_;
+  std::atomic<T const*> value_{nullptr};
+
+public:
+  explicit Handle(const char* name) : name_(name) {}
+
+  // No copy:
+  Handle(Handle const&) = delete;
+  Handle& operator=(Handle const&) = delete;
+
+  T const& get()
+  {
+    T const* value = value_.load(std::memory_order_acquire);
+    if (value == nullptr) {
+      value = &getConfig<T>(name_);
+      value_.store(value, std::memory_order_release);
+    }
+    return *value;
+  }
+  operator T const&() { return get(); }
+};
+
 // Register:
 
 /** Register a configuration flag
@@ -75,6 +138,8 @@ XBT_PUBLIC(void) declareFlag(const char* name, const char* description,
 
 extern template XBT_PUBLIC(void) declareFlag(const char* name,
   const char* description, int value, std::function<void(int const &)> callback);
+extern template XBT_PUBLIC(void) declareFlag(const char* name, const char* description, unsigned long long value,
+                                             std::function<void(unsigned long long const&)> callback);
 extern template XBT_PUBLIC(void) declareFlag(const char* name,
   const char* description, double value, std::function<void(double const &)> callback);
 extern template XBT_PUBLIC(void) declareFlag(const char* name,
@@ -0,0 +1,84 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_INTERNED_STRING_HPP
+#define SIMGRID_XBT_INTERNED_STRING_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief A name stored once in the global pool of interned strings
+ *
+ *  Interning the same characters twice gives the same handle: two interned strings are equal if and only if they are
+ *  the same pointer, and they hash by their id. The names of the hosts, links, mailboxes and tracing containers are
+ *  interned, so that the registries only hash the characters once per lookup, and share them.
+ *
+ *  The characters are never moved nor freed: c_str() stays valid until the end of the process, and the ids are given
+ *  from 1 in the order of interning, so that they are the same from one run to another.
+ *
+ *  The handle is a single pointer to the characters, so that the model-checker reads it as a char*. The default one
+ *  is null (id 0, no characters), and is what find() returns for the strings that were not interned.
+ */
+XBT_PUBLIC_CLASS InternedString {
+public:
+  InternedString() = default;
+  InternedString(const char* str, size_t size);
+  explicit InternedString(const char* str) : InternedString(str, strlen(str)) {}
+  explicit InternedString(std::string const& str) : InternedString(str.c_str(), str.size()) {}
+
+  /** The interned string of these characters if there is one, or the null handle (without interning them) */
+  static InternedString find(const char* str, size_t size);
+  static InternedString find(const char* str) { return find(str, strlen(str)); }
+  static InternedString find(std::string const& str) { return find(str.c_str(), str.size()); }
+  /** The interned string of that id, or the null handle */
+  static InternedString byId(uint32_t id);
+
+  /** Amount of interned strings */
+  static size_t count();
+  /** Bytes used by the pool: the characters, their headers and the index */
+  static size_t memory_footprint();
+
+  explicit operator bool() const { return str_ != nullptr; }
+  const char* c_str() const { return str_; }
+  std::string str() const { return std::string(str_, size()); }
+  size_t size() const { return str_ ? header()->size : 0; }
+  uint32_t id() const { return str_ ? header()->id : 0; }
+
+  bool operator==(InternedString that) const { return str_ == that.str_; }
+  bool operator!=(InternedString that) const { return str_ != that.str_; }
+  /** In the order of interning, not the alphabetical one */
+  bool operator<(InternedString that) const { return id() < that.id(); }
+
+  /** Stored right before the characters */
+  struct Header {
+    uint32_t id;
+    uint32_t size;
+  };
+
+private:
+  const char* str_ = nullptr;
+
+  explicit InternedString(const Header* header) : str_(reinterpret_cast<const char*>(header + 1)) {}
+  const Header* header() const { return reinterpret_cast<const Header*>(str_) - 1; }
+  friend class InternedStringPool;
+};
+}
+}
+
+namespace std {
+template <> struct hash<simgrid::xbt::InternedString> {
+  size_t operator()(simgrid::xbt::InternedString str) const { return str.id(); }
+};
+}
+
+#endif
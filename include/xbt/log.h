@@ -317,6 +317,10 @@ XBT_PUBLIC(xbt_log_layout_t) xbt_log_layout_simple_new(char *arg);
 XBT_PUBLIC(xbt_log_layout_t) xbt_log_layout_format_new(char *arg);
 XBT_PUBLIC(xbt_log_appender_t) xbt_log_appender_file_new(char *arg);
 XBT_PUBLIC(xbt_log_appender_t) xbt_log_appender2_file_new(char *arg,int roll);
+/** @brief create a new appender writing to the file (or to stderr if arg is NULL) from a background thread */
+XBT_PUBLIC(xbt_log_appender_t) xbt_log_appender_async_new(char *arg);
+/** @brief Waits until the asynchronous appenders wrote all the messages logged so far */
+XBT_PUBLIC(void) xbt_log_flush(void);
 
 /* ********************************** */
 /* Functions that you shouldn't call  */
@@ -19,7 +19,7 @@ SG_BEGIN_DECL()
   * \ingroup XBT_misc  
   * \brief Parallel map.
   *
-  * A function is applied to all elements of a dynar in parallel with n worker threads.
+  * A function is applied to all elements of a dynar (or of any indexed container) in parallel with n worker threads.
   * The worker threads are persistent until the destruction of the parmap.
   *
   * If there are more than n elements in the dynar, the worker threads are allowed to fetch themselves remaining work
@@ -42,6 +42,9 @@ typedef enum {
 XBT_PUBLIC(xbt_parmap_t) xbt_parmap_new(unsigned int num_workers, e_xbt_parmap_mode_t mode);
 XBT_PUBLIC(void) xbt_parmap_destroy(xbt_parmap_t parmap);
 XBT_PUBLIC(void) xbt_parmap_apply(xbt_parmap_t parmap, void_f_pvoid_t fun, xbt_dynar_t data);
+/** \brief Returns the element of index i of data, or NULL if there is no such element */
+typedef void* (*xbt_parmap_get_f)(void* data, unsigned long i);
+XBT_PUBLIC(void) xbt_parmap_apply_getter(xbt_parmap_t parmap, void_f_pvoid_t fun, void* data, xbt_parmap_get_f get);
 XBT_PUBLIC(void*) xbt_parmap_next(xbt_parmap_t parmap);
 
 /** \} */
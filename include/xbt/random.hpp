@@ -0,0 +1,80 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_RANDOM_HPP
+#define SIMGRID_XBT_RANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief A stream of random numbers from a counter-based generator (Philox4x32-10)
+ *
+ *  The n-th number of a stream is a function of the seed, of the id of the stream and of n only, with no state carried
+ *  from one number to the next. Creating a stream and skipping ahead are thus free, a stream takes 48 bytes, and the
+ *  numbers do not depend on the order in which the streams are used, so that they are the same whatever the amount of
+ *  threads running the actors. The 2^64 streams of a seed each give 2^66 numbers of 32 bits.
+ *
+ *  The bulk functions generate several blocks at once in loops the compiler can vectorize, and give the same numbers
+ *  as the same amount of calls to the scalar functions.
+ */
+XBT_PUBLIC_CLASS RandomStream {
+public:
+  RandomStream(uint64_t seed, uint64_t stream)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}, stream_(stream)
+  {
+  }
+
+  /** The 32 next random bits */
+  uint32_t operator()()
+  {
+    if (index_ == 4)
+      refill();
+    return buffer_[index_++];
+  }
+  /** The 64 next random bits (two numbers of 32 bits) */
+  uint64_t next64()
+  {
+    uint64_t high = (*this)();
+    return (high << 32) | (*this)();
+  }
+  /** Uniform in [0, 1), with 53 random bits (two numbers of 32 bits) */
+  double uniform() { return to_unit(next64()); }
+  /** Uniform in [min, max) */
+  double uniform(double min, double max) { return min + (max - min) * uniform(); }
+  /** Exponential of the given rate, e.g. the delay before the next arrival of a Poisson process */
+  double exponential(double rate);
+
+  /** Amount of numbers of 32 bits drawn so far */
+  uint64_t position() const { return block_ * 4 - (4 - index_); }
+  /** Skips that amount of numbers of 32 bits, in constant time */
+  void skip(uint64_t count);
+
+  void fill(uint32_t* out, size_t count);
+  void fill_uniform(double* out, size_t count, double min = 0.0, double max = 1.0);
+  void fill_exponential(double* out, size_t count, double rate);
+
+  /** The block function: the 4 numbers of 32 bits of a counter of 128 bits, under a key of 64 bits */
+  static void philox(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+private:
+  uint32_t key_[2];
+  uint64_t stream_;
+  uint64_t block_ = 0; // Next block to generate
+  uint32_t buffer_[4];
+  unsigned index_ = 4; // Next number of the buffer to return
+
+  static double to_unit(uint64_t bits) { return static_cast<double>(bits >> 11) * (1.0 / 9007199254740992.0); }
+  void refill();
+  void generate(uint64_t block, size_t count, uint32_t* out) const;
+};
+}
+}
+
+#endif
@@ -14,15 +14,76 @@
 #include <fstream>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace simgrid {
 namespace xbt {
-/* To split the file if a unique one is given (specific variable for the other case live in runner()) */
+/* The fields of a line of a trace file given to a single actor */
 typedef std::vector<std::string> ReplayAction;
-static std::unordered_map<std::string, std::queue<ReplayAction*>*> action_queues;
 
 XBT_PUBLIC_DATA(std::ifstream*) action_fs;
 XBT_PUBLIC(int) replay_runner(int argc, char* argv[]);
+
+/** @brief Opens the trace file shared by all actors, in the text or in the binary format
+ *
+ *  This is equivalent to setting action_fs for a text trace. Close it with replay_close() after the simulation.
+ */
+XBT_PUBLIC(void) replay_open(const char* filename);
+XBT_PUBLIC(void) replay_close();
+
+/** @brief The fields of an action: the actor name, the action name, then the arguments
+ *
+ *  The numeric arguments of the binary traces are decoded once, while the fields of the text traces are parsed when
+ *  requested. The fields are only valid during the callback.
+ */
+class ReplayArgs {
+public:
+  size_t size() const { return fields_.size(); }
+  const char* actor() const { return get_string(0); }
+  const char* name() const { return get_string(1); }
+
+  /** The field as a C string (numbers are formatted in a buffer of the field) */
+  const char* get_string(size_t i) const;
+  /** The field as a double, or an arg_error exception */
+  double get_double(size_t i) const;
+  /** The field as an integer, or an arg_error exception */
+  long long get_int(size_t i) const;
+
+  void clear() { fields_.clear(); }
+  void push_string(const char* value);
+  void push_int(long long value);
+  void push_double(double value);
+
+private:
+  enum class Kind { string, integer, real };
+  struct Field {
+    Kind kind;
+    long long integer;
+    double real;
+    const char* string;
+    mutable char text[32];
+  };
+  std::vector<Field> fields_;
+
+  Field const& field(size_t i) const;
+};
+
+/** Callbacks receiving the typed fields of the actions, instead of the strings of action_fun */
+typedef void (*replay_fun)(ReplayArgs const& args);
+/** @brief Registers a function to handle a kind of action, replacing any previous one */
+XBT_PUBLIC(void) replay_action_register(const char* action_name, replay_fun function);
+
+/** @brief Converts a text trace into a binary one
+ *
+ *  The binary traces intern the actor and action names, encode the numeric arguments as varints or doubles, and
+ *  store the actions of each actor contiguously. They are memory-mapped by the replay, which does not allocate
+ *  anything per action. Replaying them is thus much faster than replaying text traces.
+ */
+XBT_PUBLIC(void) replay_text_to_binary(const char* input, const char* output);
+/** @brief Converts a binary trace into a text one, listing the actions of each actor in turn */
+XBT_PUBLIC(void) replay_binary_to_text(const char* input, const char* output);
+/** @brief Whether that file is a binary trace */
+XBT_PUBLIC(bool) replay_is_binary(const char* filename);
 }
 }
 #endif
@@ -47,12 +47,9 @@ JavaContext* JavaContextFactory::create_context(
 
 void JavaContextFactory::run_all()
 {
-  xbt_dynar_t processes = SIMIX_process_get_runnable();
-  smx_actor_t process;
-  unsigned int cursor;
-  xbt_dynar_foreach(processes, cursor, process) {
-    static_cast<JavaContext*>(SIMIX_process_get_context(process))->resume();
-  }
+  // Indexed loop: the actors that run may add others to the list
+  for (size_t i = 0; i < simix_global->process_to_run.size(); i++)
+    static_cast<JavaContext*>(SIMIX_process_get_context(simix_global->process_to_run[i]))->resume();
 }
 
 JavaContext::JavaContext(std::function<void()> code,
@@ -9,11 +9,20 @@
 #include "surf/surf.h"
 
 #include "src/instr/instr_private.h"
+#include "src/kernel/MemoryAccounting.hpp"
+#include "xbt/interned_string.hpp"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY (instr_paje_containers, instr, "Paje tracing event system (containers)");
 
+/* Memory used by a container, with its id (its name belongs to the pool of interned strings) */
+static size_t container_footprint(container_t container)
+{
+  return sizeof(s_container_t) + strlen(container->id) + 1;
+}
+
 static container_t rootContainer = nullptr;    /* the root container */
-static xbt_dict_t allContainers = nullptr;     /* all created containers indexed by name */
+/* all created containers indexed by name */
+static simgrid::xbt::FlatMap<simgrid::xbt::InternedString, container_t>* allContainers = nullptr;
 xbt_dict_t trivaNodeTypes = nullptr;     /* all host types defined */
 xbt_dict_t trivaEdgeTypes = nullptr;     /* all link types defined */
 
@@ -25,14 +34,15 @@ long long int instr_new_paje_id ()
 
 void PJ_container_alloc ()
 {
-  allContainers = xbt_dict_new_homogeneous(nullptr);
+  allContainers  = new simgrid::xbt::FlatMap<simgrid::xbt::InternedString, container_t>();
   trivaNodeTypes = xbt_dict_new_homogeneous(xbt_free_f);
   trivaEdgeTypes = xbt_dict_new_homogeneous(xbt_free_f);
 }
 
 void PJ_container_release ()
 {
-  xbt_dict_free (&allContainers);
+  delete allContainers;
+  allContainers = nullptr;
   xbt_dict_free (&trivaNodeTypes);
   xbt_dict_free (&trivaEdgeTypes);
 }
@@ -53,10 +63,12 @@ container_t PJ_container_new (const char *name, e_container_types kind, containe
   snprintf (id_str, INSTR_DEFAULT_STR_SIZE, "%lld", container_id);
   container_id++;
 
+  simgrid::xbt::InternedString interned_name(name);
   container_t newContainer = xbt_new0(s_container_t, 1);
-  newContainer->name = xbt_strdup (name); // name of the container
+  newContainer->name = interned_name.c_str(); // name of the container
   newContainer->id = xbt_strdup (id_str); // id (or alias) of the container
   newContainer->father = father;
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::tracing, container_footprint(newContainer));
   sg_host_t sg_host = sg_host_by_name(name);
 
   //Search for network_element_t
@@ -142,11 +154,10 @@ container_t PJ_container_new (const char *name, e_container_types kind, containe
   }
 
   //register all kinds by name
-  if (xbt_dict_get_or_null(allContainers, newContainer->name) != nullptr){
+  if (not allContainers->emplace(interned_name, newContainer).second) {
     THROWF(tracing_error, 1, "container %s already present in allContainers data structure", newContainer->name);
   }
 
-  xbt_dict_set (allContainers, newContainer->name, newContainer, nullptr);
   XBT_DEBUG("Add container name '%s'",newContainer->name);
 
   //register NODE types for triva configuration
@@ -167,7 +178,14 @@ container_t PJ_container_get (const char *name)
 
 container_t PJ_container_get_or_null (const char *name)
 {
-  return static_cast<container_t>(name != nullptr ? xbt_dict_get_or_null(allContainers, name) : nullptr);
+  if (name == nullptr)
+    return nullptr;
+  /* A name that was never interned cannot be the one of a container */
+  simgrid::xbt::InternedString key = simgrid::xbt::InternedString::find(name);
+  if (not key)
+    return nullptr;
+  auto container = allContainers->find(key);
+  return container == allContainers->end() ? nullptr : container->second;
 }
 
 container_t PJ_container_get_root ()
@@ -210,10 +228,10 @@ void PJ_container_free (container_t container)
   }
 
   //remove it from allContainers data structure
-  xbt_dict_remove (allContainers, container->name);
+  allContainers->erase(simgrid::xbt::InternedString::find(container->name));
 
   //free
-  xbt_free (container->name);
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::tracing, container_footprint(container));
   xbt_free (container->id);
   xbt_dict_free (&container->children);
   xbt_free (container);
@@ -245,7 +263,7 @@ void PJ_container_free_all ()
   rootContainer = nullptr;
 
   //checks
-  if (not xbt_dict_is_empty(allContainers)) {
+  if (not allContainers->empty()) {
     THROWF(tracing_error, 0, "some containers still present even after destroying all of them");
   }
 }
@@ -6,10 +6,12 @@
 
 #include "src/instr/instr_private.h"
 #include "src/instr/instr_smpi.h"
+#include "src/kernel/Profiler.hpp"
 #include "src/smpi/private.hpp"
 #include "typeinfo"
 #include "xbt/virtu.h" /* sg_cmdline */
 #include "simgrid/sg_config.h"
+#include "xbt/config.hpp"
 
 #include <sstream>
 #include <vector>
@@ -29,6 +31,11 @@ FILE *tracing_file = nullptr;
 static xbt_dict_t tracing_files = nullptr; // TI specific
 static double prefix=0.0; // TI specific
 
+#if HAVE_SMPI
+/* Read at each state change */
+static simgrid::config::Handle<bool> smpi_trace_call_location("smpi/trace-call-location");
+#endif
+
 
 void print_NULL(PajeEvent* event){}
 
@@ -78,6 +85,7 @@ void TRACE_paje_dump_buffer (int force)
 {
   if (not TRACE_is_enabled())
     return;
+  simgrid::kernel::profiler::Scope scope(simgrid::kernel::profiler::Phase::tracing);
   XBT_DEBUG("%s: dump until %f. starts", __FUNCTION__, TRACE_last_timestamp_to_dump);
   if (force){
     for (auto event : buffer){
@@ -569,7 +577,7 @@ SetStateEvent::SetStateEvent (double timestamp, container_t container, type_t ty
   this->value     = value;
 
 #if HAVE_SMPI
-  if (xbt_cfg_get_boolean("smpi/trace-call-location")) {
+  if (smpi_trace_call_location) {
     smpi_trace_call_location_t* loc = smpi_trace_get_call_location();
     filename   = loc->filename;
     linenumber = loc->linenumber;
@@ -590,7 +598,7 @@ void SetStateEvent::print() {
     stream << " " << type->id << " " << container->id;
     stream << " " << value->id;
 #if HAVE_SMPI
-    if (xbt_cfg_get_boolean("smpi/trace-call-location")) {
+    if (smpi_trace_call_location) {
       stream << " \"" << filename << "\" " << linenumber;
     }
 #endif
@@ -612,7 +620,7 @@ PushStateEvent::PushStateEvent (double timestamp, container_t container, type_t
   this->extra_     = extra;
 
 #if HAVE_SMPI
-  if (xbt_cfg_get_boolean("smpi/trace-call-location")) {
+  if (smpi_trace_call_location) {
     smpi_trace_call_location_t* loc = smpi_trace_get_call_location();
     filename   = loc->filename;
     linenumber = loc->linenumber;
@@ -645,7 +653,7 @@ void PushStateEvent::print() {
       }
     }
 #if HAVE_SMPI
-    if (xbt_cfg_get_boolean("smpi/trace-call-location")) {
+    if (smpi_trace_call_location) {
       stream << " \"" << filename << "\" " << linenumber;
     }
 #endif
@@ -35,7 +35,7 @@ static type_t newType (const char *typeNameBuff, const char *key, const char *co
   ret->father = father;
   ret->kind = kind;
   ret->children = xbt_dict_new_homogeneous(nullptr);
-  ret->values = xbt_dict_new_homogeneous(nullptr);
+  ret->values   = new simgrid::xbt::FlatMap<std::string, val_t>();
   ret->color = xbt_strdup (color);
 
   char str_id[INSTR_DEFAULT_STR_SIZE];
@@ -51,13 +51,9 @@ static type_t newType (const char *typeNameBuff, const char *key, const char *co
 
 void PJ_type_free (type_t type)
 {
-  val_t value;
-  char *value_name;
-  xbt_dict_cursor_t cursor = nullptr;
-  xbt_dict_foreach(type->values, cursor, value_name, value) {
-    PJ_value_free (value);
-  }
-  xbt_dict_free (&type->values);
+  for (auto const& elm : *type->values)
+    PJ_value_free(elm.second);
+  delete type->values;
   xbt_free (type->name);
   xbt_free (type->id);
   xbt_free (type->color);
@@ -25,7 +25,7 @@ val_t PJ_value_new (const char *name, const char *color, type_t father)
   snprintf (str_id, INSTR_DEFAULT_STR_SIZE, "%lld", instr_new_paje_id());
   ret->id = xbt_strdup (str_id);
 
-  xbt_dict_set (father->values, name, ret, nullptr);
+  (*father->values)[name] = ret;
   XBT_DEBUG("new value %s, child of %s", ret->name, ret->father->name);
   new DefineEntityValueEvent(ret);
   return ret;
@@ -51,11 +51,11 @@ val_t PJ_value_get (const char *name, type_t father)
 
   if (father->kind == TYPE_VARIABLE)
     THROWF(tracing_error, 0, "variables can't have different values (%s)", father->name);
-  val_t ret = (val_t)xbt_dict_get_or_null (father->values, name);
-  if (ret == nullptr) {
+  auto ret = father->values->find(name);
+  if (ret == father->values->end()) {
     THROWF(tracing_error, 2, "value with name (%s) not found in father type (%s)", name, father->name);
   }
-  return ret;
+  return ret->second;
 }
 
 void PJ_value_free (val_t value)
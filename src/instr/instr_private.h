@@ -12,6 +12,9 @@
 #include "instr/instr_interface.h"
 #include "src/internal_config.h"
 #include "simgrid_config.h"
+#include "src/xbt/flat_map.hpp"
+
+#include <string>
 
 SG_BEGIN_DECL()
 
@@ -58,6 +61,7 @@ typedef enum {
 //--------------------------------------------------
 class s_type;
 typedef s_type *type_t;
+class s_val;
 class s_type {
   public:
   char *id;
@@ -66,7 +70,7 @@ class s_type {
   e_entity_types kind;
   s_type *father;
   xbt_dict_t children;
-  xbt_dict_t values; //valid for all types except variable and container
+  simgrid::xbt::FlatMap<std::string, s_val*>* values; // valid for all types except variable and container
 };
 
 typedef s_type s_type_t;
@@ -103,7 +107,7 @@ typedef s_container *container_t;
 class s_container {
   public: 
   sg_netpoint_t netpoint;
-  char *name;     /* Unique name of this container */
+  const char* name; /* Unique name of this container (interned) */
   char *id;       /* Unique id of this container */
   type_t type;    /* Type of this container */
   int level;      /* Level in the hierarchy, root level is 0 */
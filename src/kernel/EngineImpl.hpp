@@ -21,6 +21,8 @@ public:
   EngineImpl();
   virtual ~EngineImpl();
   kernel::routing::NetZoneImpl* netRoot_ = nullptr;
+  /* In a branch created by Engine::fork(), our end of the pipe to the parent process */
+  int parentChannel_ = -1;
 
 protected:
   std::unordered_map<std::string, simgrid::kernel::routing::NetPoint*> netpoints_;
@@ -0,0 +1,71 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <atomic>
+
+#include "src/kernel/MemoryAccounting.hpp"
+#include "xbt/interned_string.hpp"
+#include "xbt/log.h"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_memory, simix, "Memory accounting per subsystem");
+
+namespace simgrid {
+namespace kernel {
+namespace memory {
+
+bool enabled = false;
+
+static const char* tag_names[] = {"platform", "routing", "lmm", "stacks", "traces", "mailboxes", "tracing", "names"};
+static_assert(sizeof(tag_names) / sizeof(tag_names[0]) == static_cast<size_t>(Tag::count), "Each tag needs a name");
+
+/* The stacks are created by the actors when they first run, possibly in parallel */
+static std::atomic<int64_t> current[static_cast<int>(Tag::count)];
+static std::atomic<int64_t> peak[static_cast<int>(Tag::count)];
+
+void account(Tag tag, int64_t delta)
+{
+  int64_t value = current[static_cast<int>(tag)].fetch_add(delta, std::memory_order_relaxed) + delta;
+  std::atomic<int64_t>& max = peak[static_cast<int>(tag)];
+  int64_t previous          = max.load(std::memory_order_relaxed);
+  while (value > previous && not max.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+  }
+}
+
+const char* name(Tag tag)
+{
+  return tag_names[static_cast<int>(tag)];
+}
+
+Usage usage(Tag tag)
+{
+  if (tag == Tag::names) {
+    size_t size = enabled ? xbt::InternedString::memory_footprint() : 0;
+    return {size, size};
+  }
+  /* What was allocated before the accounting got enabled may be freed afterward */
+  int64_t value = current[static_cast<int>(tag)].load(std::memory_order_relaxed);
+  return {static_cast<size_t>(std::max<int64_t>(value, 0)),
+          static_cast<size_t>(peak[static_cast<int>(tag)].load(std::memory_order_relaxed))};
+}
+
+void report()
+{
+  if (not enabled)
+    return;
+  XBT_INFO("Memory usage per subsystem (current / peak, in KiB):");
+  size_t total_current = 0;
+  size_t total_peak    = 0;
+  for (int tag = 0; tag < static_cast<int>(Tag::count); tag++) {
+    Usage use = usage(static_cast<Tag>(tag));
+    XBT_INFO("  %-10s %12.1f / %12.1f", tag_names[tag], use.current / 1024.0, use.peak / 1024.0);
+    total_current += use.current;
+    total_peak += use.peak;
+  }
+  XBT_INFO("  %-10s %12.1f / %12.1f (sum of the peaks)", "total", total_current / 1024.0, total_peak / 1024.0);
+}
+}
+}
+}
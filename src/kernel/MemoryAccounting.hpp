@@ -0,0 +1,58 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_KERNEL_MEMORYACCOUNTING_HPP
+#define SIMGRID_KERNEL_MEMORYACCOUNTING_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace kernel {
+/** @brief Accounting of the memory used by each subsystem of the simulator
+ *
+ * When --cfg=memory/accounting:yes is given, the main allocation sites of each subsystem report the size of the
+ * objects that they create and destroy, and the current and peak usage of each subsystem are reported at exit (and
+ * through simgrid::s4u::Engine::memoryUsage()). The sizes are those of the main data structures, not the exact amount
+ * of memory requested to the system. When the accounting is disabled, each probe costs a single test.
+ *
+ * The names of the hosts, links, mailboxes and tracing containers are shared by the pool of interned strings, which is
+ * never emptied: they are accounted under their own tag, read from the pool instead of reported by the objects.
+ */
+namespace memory {
+
+enum class Tag { platform = 0, routing, lmm, stacks, traces, mailboxes, tracing, names, count };
+
+XBT_PUBLIC_DATA(bool) enabled;
+
+XBT_PUBLIC(void) account(Tag tag, int64_t delta);
+
+inline void allocated(Tag tag, size_t size)
+{
+  if (enabled)
+    account(tag, static_cast<int64_t>(size));
+}
+inline void freed(Tag tag, size_t size)
+{
+  if (enabled)
+    account(tag, -static_cast<int64_t>(size));
+}
+
+struct Usage {
+  size_t current;
+  size_t peak;
+};
+XBT_PUBLIC(const char*) name(Tag tag);
+XBT_PUBLIC(Usage) usage(Tag tag);
+
+/** Logs the usage of each subsystem, if the accounting is enabled */
+XBT_PUBLIC(void) report();
+}
+}
+}
+
+#endif
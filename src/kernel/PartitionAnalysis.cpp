@@ -0,0 +1,133 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "simgrid/s4u/Engine.hpp"
+#include "simgrid/s4u/Host.hpp"
+#include "simgrid/s4u/Link.hpp"
+#include "simgrid/s4u/NetZone.hpp"
+#include "src/kernel/PartitionAnalysis.hpp"
+#include "src/kernel/routing/NetPoint.hpp"
+#include "src/kernel/routing/NetZoneImpl.hpp"
+#include "src/simix/smx_private.h"
+#include "xbt/log.h"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_partition, simix, "Analysis of the partitioning along top-level netzones");
+
+namespace simgrid {
+namespace kernel {
+namespace partition {
+
+bool enabled = false;
+
+static std::vector<s4u::NetZone*> partitions;
+static std::vector<double> lookahead; // Per partition, from the closest other one
+static std::vector<size_t> hosts_count;
+static std::unordered_map<s4u::Host*, int> partition_of; // -1 for the hosts of the root netzone itself
+
+/* Per source partition, the last slot being for the hosts out of any partition */
+static std::vector<unsigned long long> local_comms;
+static std::vector<unsigned long long> outgoing_comms;
+
+static int find_partition(s4u::Host* host)
+{
+  auto known = partition_of.find(host);
+  if (known != partition_of.end())
+    return known->second;
+
+  s4u::NetZone* root = s4u::Engine::instance()->netRoot();
+  s4u::NetZone* zone = host->pimpl_netpoint->netzone();
+  while (zone != root && zone->father() != root)
+    zone = zone->father();
+  int res = -1;
+  for (unsigned i = 0; i < partitions.size(); i++)
+    if (partitions[i] == zone)
+      res = i;
+  partition_of.insert({host, res});
+  return res;
+}
+
+static void count_comm(s4u::Host* src, s4u::Host* dst)
+{
+  int from = find_partition(src);
+  int to   = find_partition(dst);
+  size_t slot = from < 0 ? partitions.size() : from;
+  if (from >= 0 && from == to)
+    local_comms[slot]++;
+  else
+    outgoing_comms[slot]++;
+}
+
+void analyze_platform()
+{
+  routing::NetZoneImpl* root = static_cast<routing::NetZoneImpl*>(s4u::Engine::instance()->netRoot());
+  partitions = *root->children();
+  std::vector<std::vector<double>> matrix = root->getChildrenLookahead();
+
+  lookahead.assign(partitions.size(), std::numeric_limits<double>::infinity());
+  for (unsigned i = 0; i < partitions.size(); i++)
+    for (unsigned j = 0; j < partitions.size(); j++)
+      if (i != j)
+        lookahead[i] = std::min(lookahead[i], matrix[j][i]);
+
+  hosts_count.assign(partitions.size(), 0);
+  std::vector<s4u::Host*> hosts;
+  s4u::Engine::instance()->hostList(&hosts);
+  for (s4u::Host* host : hosts) {
+    int partition = find_partition(host);
+    if (partition >= 0)
+      hosts_count[partition]++;
+  }
+
+  local_comms.assign(partitions.size() + 1, 0);
+  outgoing_comms.assign(partitions.size() + 1, 0);
+  s4u::Link::onCommunicate.connect(
+      [](surf::NetworkAction*, s4u::Host* src, s4u::Host* dst) { count_comm(src, dst); });
+}
+
+void report()
+{
+  if (not enabled)
+    return;
+  if (partitions.size() < 2) {
+    XBT_INFO("Partition analysis: the root netzone has %zu sub-netzone(s), there is nothing to partition",
+             partitions.size());
+    return;
+  }
+
+  XBT_INFO("Partition analysis along the %zu top-level netzones:", partitions.size());
+  unsigned long long local    = 0;
+  unsigned long long crossing = 0;
+  double smallest             = std::numeric_limits<double>::infinity();
+  for (unsigned i = 0; i < partitions.size(); i++) {
+    XBT_INFO("  %s: %zu hosts, lookahead %g, %llu local comms, %llu comms to other partitions", partitions[i]->name(),
+             hosts_count[i], lookahead[i], local_comms[i], outgoing_comms[i]);
+    local += local_comms[i];
+    crossing += outgoing_comms[i];
+    smallest = std::min(smallest, lookahead[i]);
+  }
+  if (outgoing_comms.back() > 0)
+    XBT_INFO("  (outside of any partition): %llu comms", outgoing_comms.back());
+  crossing += outgoing_comms.back();
+
+  unsigned long long total = local + crossing;
+  XBT_INFO("Crossing comms: %llu of %llu (%.1f%%)", crossing, total, total ? 100.0 * crossing / total : 0.0);
+  if (std::isinf(smallest))
+    XBT_INFO("No route between the partitions: they could be simulated independently");
+  else if (smallest <= 0)
+    XBT_INFO("Smallest lookahead is 0: a conservative parallel simulation could not advance the partitions apart");
+  else
+    XBT_INFO("Smallest lookahead %g: a conservative parallel simulation would synchronize the partitions at least "
+             "%.0f times over these %g simulated seconds",
+             smallest, std::ceil(SIMIX_get_clock() / smallest), SIMIX_get_clock());
+}
+}
+}
+}
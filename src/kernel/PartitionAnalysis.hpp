@@ -0,0 +1,36 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_KERNEL_PARTITIONANALYSIS_HPP
+#define SIMGRID_KERNEL_PARTITIONANALYSIS_HPP
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace kernel {
+/** @brief How well a simulation would split along its top-level netzones
+ *
+ * When --cfg=partition/report:yes is given, each top-level netzone is considered as a partition that a conservative
+ * parallel simulation could run on its own. The lookahead of each partition (the smallest latency of the routes that
+ * reach it from another partition, see NetZoneImpl::getChildrenLookahead()) is computed once the platform is loaded,
+ * and every communication is counted as local to a partition or crossing partitions. At the end of the simulation, the
+ * report gives these counts and the amount of synchronization windows that the smallest lookahead would impose.
+ *
+ * This only analyzes the sequential run: the simulation itself is not partitioned.
+ */
+namespace partition {
+
+XBT_PUBLIC_DATA(bool) enabled;
+
+/** Computes the partitions and their lookahead, and starts counting the communications. Called once the platform is
+ * loaded, if enabled. */
+XBT_PUBLIC(void) analyze_platform();
+/** Logs the analysis (in the simix_partition category), if enabled */
+XBT_PUBLIC(void) report();
+}
+}
+}
+
+#endif
@@ -0,0 +1,174 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "src/kernel/Profiler.hpp"
+#include "src/simix/popping_private.h"
+#include "xbt/log.h"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_profiler, simix, "Self-profiler of the simulation kernel");
+
+namespace simgrid {
+namespace kernel {
+namespace profiler {
+
+bool enabled  = false;
+double period = 0;
+
+static const char* phase_names[] = {"other",   "actors",         "simcalls", "timers", "surf_solve",
+                                    "lmm_solve", "update_actions", "routing",  "tracing"};
+static_assert(sizeof(phase_names) / sizeof(phase_names[0]) == static_cast<size_t>(Phase::count),
+              "Each phase needs a name");
+
+static std::string output;
+static Phase current = Phase::none;
+static uint64_t last_date;
+static uint64_t cycles[static_cast<int>(Phase::count)];
+static unsigned long long entries[static_cast<int>(Phase::count)];
+
+static unsigned long long simcalls[NUM_SIMCALLS];
+static unsigned long long lmm_solves;
+static unsigned long long lmm_variables;
+static unsigned long long lmm_constraints;
+static unsigned lmm_max_variables;
+static unsigned lmm_max_constraints;
+static unsigned long long route_lookups;
+
+/* To convert the cycles into seconds */
+static uint64_t start_date;
+static std::chrono::steady_clock::time_point start_time;
+static std::chrono::steady_clock::time_point last_report;
+
+void set_output(std::string const& filename)
+{
+  output  = filename;
+  enabled = not output.empty();
+  std::fill(std::begin(cycles), std::end(cycles), 0);
+  std::fill(std::begin(entries), std::end(entries), 0);
+  std::fill(std::begin(simcalls), std::end(simcalls), 0);
+  lmm_solves = lmm_variables = lmm_constraints = route_lookups = 0;
+  lmm_max_variables = lmm_max_constraints = 0;
+  current     = Phase::none;
+  start_date  = now();
+  last_date   = start_date;
+  start_time  = std::chrono::steady_clock::now();
+  last_report = start_time;
+}
+
+Phase enter(Phase phase, uint64_t date)
+{
+  cycles[static_cast<int>(current)] += date - last_date;
+  last_date = date;
+  entries[static_cast<int>(phase)]++;
+  Phase previous = current;
+  current        = phase;
+  return previous;
+}
+
+void leave(Phase previous, uint64_t date)
+{
+  cycles[static_cast<int>(current)] += date - last_date;
+  last_date = date;
+  current   = previous;
+}
+
+Phase current_phase()
+{
+  return current;
+}
+
+void count_simcall(int call)
+{
+  simcalls[call]++;
+}
+
+void count_lmm_solve(unsigned variables, unsigned constraints)
+{
+  lmm_solves++;
+  lmm_variables += variables;
+  lmm_constraints += constraints;
+  lmm_max_variables   = std::max(lmm_max_variables, variables);
+  lmm_max_constraints = std::max(lmm_max_constraints, constraints);
+}
+
+void count_route_lookup()
+{
+  route_lookups++;
+}
+
+void tick()
+{
+  if (period <= 0)
+    return;
+  auto time = std::chrono::steady_clock::now();
+  if (std::chrono::duration<double>(time - last_report).count() >= period) {
+    last_report = time;
+    dump();
+  }
+}
+
+/* One row of the report: kind, name, count, cycles (or 0), seconds (or 0) */
+struct Row {
+  const char* kind;
+  const char* name;
+  unsigned long long count;
+  uint64_t cycles;
+};
+
+void dump()
+{
+  if (not enabled)
+    return;
+  /* Account the time spent so far in the current phase */
+  uint64_t date = now();
+  cycles[static_cast<int>(current)] += date - last_date;
+  last_date = date;
+
+  double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+  double cycles_per_second = elapsed > 0 ? (date - start_date) / elapsed : 0;
+
+  std::vector<Row> rows;
+  for (int phase = 0; phase < static_cast<int>(Phase::count); phase++)
+    rows.push_back({"phase", phase_names[phase], entries[phase], cycles[phase]});
+  for (int call = 1; call < NUM_SIMCALLS; call++)
+    if (simcalls[call] > 0)
+      rows.push_back({"simcall", SIMIX_simcall_name(static_cast<e_smx_simcall_t>(call)), simcalls[call], 0});
+  rows.push_back({"lmm", "solves", lmm_solves, 0});
+  rows.push_back({"lmm", "variables", lmm_variables, 0});
+  rows.push_back({"lmm", "constraints", lmm_constraints, 0});
+  rows.push_back({"lmm", "max_variables", lmm_max_variables, 0});
+  rows.push_back({"lmm", "max_constraints", lmm_max_constraints, 0});
+  rows.push_back({"routing", "lookups", route_lookups, 0});
+
+  FILE* file = fopen(output.c_str(), "w");
+  if (file == nullptr) {
+    XBT_WARN("Cannot write the kernel profile to '%s'", output.c_str());
+    return;
+  }
+  bool json = output.size() >= 5 && output.compare(output.size() - 5, 5, ".json") == 0;
+  if (json) {
+    fprintf(file, "{\n  \"elapsed\": %f,\n  \"cycles_per_second\": %.0f,\n  \"rows\": [\n", elapsed,
+            cycles_per_second);
+    for (size_t i = 0; i < rows.size(); i++)
+      fprintf(file, "    {\"kind\": \"%s\", \"name\": \"%s\", \"count\": %llu, \"cycles\": %llu, \"seconds\": %f}%s\n",
+              rows[i].kind, rows[i].name, rows[i].count, (unsigned long long)rows[i].cycles,
+              cycles_per_second > 0 ? rows[i].cycles / cycles_per_second : 0, i + 1 < rows.size() ? "," : "");
+    fprintf(file, "  ]\n}\n");
+  } else {
+    fprintf(file, "kind,name,count,cycles,seconds\n");
+    for (Row const& row : rows)
+      fprintf(file, "%s,%s,%llu,%llu,%f\n", row.kind, row.name, row.count, (unsigned long long)row.cycles,
+              cycles_per_second > 0 ? row.cycles / cycles_per_second : 0);
+  }
+  fclose(file);
+  XBT_VERB("Kernel profile written to '%s'", output.c_str());
+}
+}
+}
+}
@@ -0,0 +1,88 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_KERNEL_PROFILER_HPP
+#define SIMGRID_KERNEL_PROFILER_HPP
+
+#include <cstdint>
+#include <string>
+
+#include <xbt/base.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace simgrid {
+namespace kernel {
+/** @brief Self-profiler of the simulation kernel
+ *
+ * When --cfg=profiling/output is set, the main phases of the simulation loop are timed with the cycle counter of the
+ * processor, and a few kernel counters are maintained (simcalls per type, sizes of the LMM systems, route lookups).
+ * The report is written to that file when the simulation ends, and periodically if profiling/period is set.
+ *
+ * The time of a phase is exclusive: the time spent in a nested phase (e.g. the route lookups made while handling a
+ * simcall) is only accounted to the nested one. When the profiler is disabled, each probe costs a single test.
+ */
+namespace profiler {
+
+enum class Phase { none = 0, actors, simcalls, timers, surf, lmm, update_actions, routing, tracing, count };
+
+XBT_PUBLIC_DATA(bool) enabled;
+/** Wall-clock seconds between two reports, or 0 to write it at the end only (profiling/period) */
+XBT_PUBLIC_DATA(double) period;
+
+inline uint64_t now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/** Starts profiling into the given file, or stops profiling if the name is empty */
+XBT_PUBLIC(void) set_output(std::string const& filename);
+
+XBT_PUBLIC(Phase) enter(Phase phase, uint64_t date);
+XBT_PUBLIC(void) leave(Phase previous, uint64_t date);
+XBT_PUBLIC(Phase) current_phase();
+
+XBT_PUBLIC(void) count_simcall(int call);
+XBT_PUBLIC(void) count_lmm_solve(unsigned variables, unsigned constraints);
+XBT_PUBLIC(void) count_route_lookup();
+
+/** Writes the report if profiling/period elapsed since the last one. Called once per scheduling round. */
+XBT_PUBLIC(void) tick();
+/** Writes the report */
+XBT_PUBLIC(void) dump();
+
+/** Accounts the time spent in its scope to the given phase */
+class Scope {
+public:
+  explicit Scope(Phase phase)
+  {
+    if (enabled)
+      previous_ = enter(phase, now());
+  }
+  ~Scope()
+  {
+    if (previous_ != Phase::count)
+      leave(previous_, now());
+  }
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+private:
+  Phase previous_ = Phase::count; // Phase::count when the profiler was disabled at construction time
+};
+}
+}
+}
+
+#endif
@@ -0,0 +1,158 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "src/kernel/ProgressReporter.hpp"
+#include "src/simix/smx_private.h"
+#include "src/surf/maxmin_private.hpp"
+#include "src/surf/surf_interface.hpp"
+#include "xbt/log.h"
+#include "xbt/misc.h"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_progress, simix, "Periodic report of the simulation progress");
+
+namespace simgrid {
+namespace kernel {
+namespace progress {
+
+bool enabled = false;
+
+static double period = 0;
+static std::string output;
+static bool header_written = false;
+
+static bool started = false;
+static std::chrono::steady_clock::time_point start_time;
+static std::chrono::steady_clock::time_point last_time;
+static double last_clock;
+static unsigned long long events;
+static unsigned long long last_events;
+
+void set_period(double value)
+{
+  period  = value;
+  enabled = period > 0;
+  started = false;
+}
+
+void set_output(std::string const& filename)
+{
+  output         = filename;
+  header_written = false;
+}
+
+void count_events(size_t scheduled_actors)
+{
+  events += scheduled_actors;
+}
+
+/** Resident memory of the process in bytes, or its peak if the current value is not available */
+static size_t resident_memory()
+{
+  FILE* statm = fopen("/proc/self/statm", "r");
+  if (statm != nullptr) {
+    unsigned long size;
+    unsigned long resident;
+    int read = fscanf(statm, "%lu %lu", &size, &resident);
+    fclose(statm);
+    if (read == 2)
+      return resident * xbt_pagesize;
+  }
+#ifndef _WIN32
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+#ifdef __APPLE__
+    return usage.ru_maxrss; // in bytes
+#else
+    return usage.ru_maxrss * 1024UL; // in KiB
+#endif
+#endif
+  return 0;
+}
+
+static void start(std::chrono::steady_clock::time_point time)
+{
+  started     = true;
+  start_time  = time;
+  last_time   = time;
+  last_clock  = SIMIX_get_clock();
+  last_events = events;
+}
+
+void tick(size_t pending_timers)
+{
+  auto time = std::chrono::steady_clock::now();
+  if (not started)
+    start(time);
+  else if (std::chrono::duration<double>(time - last_time).count() >= period)
+    report(pending_timers);
+}
+
+void report(size_t pending_timers)
+{
+  auto time = std::chrono::steady_clock::now();
+  if (not started)
+    start(time);
+  double clock        = SIMIX_get_clock();
+  double wall         = std::chrono::duration<double>(time - start_time).count();
+  double elapsed      = std::chrono::duration<double>(time - last_time).count();
+  double ratio        = elapsed > 0 ? (clock - last_clock) / elapsed : 0;
+  double overall      = wall > 0 ? clock / wall : 0;
+  double events_speed = elapsed > 0 ? (events - last_events) / elapsed : 0;
+  last_time   = time;
+  last_clock  = clock;
+  last_events = events;
+
+  /* Some models share their LMM system (e.g. the ptask model) */
+  std::vector<lmm_system_t> systems;
+  size_t variables   = 0;
+  size_t constraints = 0;
+  if (all_existing_models != nullptr)
+    for (surf_model_t model : *all_existing_models) {
+      lmm_system_t sys = model->getMaxminSystem();
+      if (sys == nullptr || std::find(systems.begin(), systems.end(), sys) != systems.end())
+        continue;
+      systems.push_back(sys);
+      variables += xbt_swag_size(&sys->variable_set);
+      constraints += xbt_swag_size(&sys->active_constraint_set);
+    }
+
+  size_t runnable = simix_global->process_to_run.size();
+  size_t actors   = simix_global->process_list.size();
+  size_t resident = resident_memory();
+
+  if (output.empty()) {
+    XBT_INFO("Simulated %f s (x%.3g, overall x%.3g), %.0f events/s, %zu/%zu runnable actors, LMM: %zu variables, "
+             "%zu active constraints, %zu timers, %.1f MiB resident",
+             clock, ratio, overall, events_speed, runnable, actors, variables, constraints, pending_timers,
+             resident / 1048576.0);
+    return;
+  }
+
+  FILE* file = fopen(output.c_str(), header_written ? "a" : "w");
+  if (file == nullptr) {
+    XBT_WARN("Cannot write the progress report to '%s'", output.c_str());
+    return;
+  }
+  if (not header_written) {
+    fprintf(file, "wall_time,simulated_time,speed_ratio,overall_ratio,events_per_second,runnable_actors,actors,"
+                  "lmm_variables,lmm_constraints,timers,resident_bytes\n");
+    header_written = true;
+  }
+  fprintf(file, "%f,%f,%g,%g,%.0f,%zu,%zu,%zu,%zu,%zu,%zu\n", wall, clock, ratio, overall, events_speed, runnable,
+          actors, variables, constraints, pending_timers, resident);
+  fclose(file);
+}
+}
+}
+}
@@ -0,0 +1,44 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_KERNEL_PROGRESSREPORTER_HPP
+#define SIMGRID_KERNEL_PROGRESSREPORTER_HPP
+
+#include <cstddef>
+#include <string>
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace kernel {
+/** @brief Periodic report of the progress of long simulations
+ *
+ * When --cfg=progress/period is set, the main loop reports every that many wall-clock seconds the simulated date,
+ * the ratio of simulated time over wall-clock time, the amount of actors scheduled per second, the amount of runnable
+ * actors, the sizes of the LMM systems, the amount of pending timers and the resident memory of the process.
+ *
+ * The reports are logged in the simix_progress category, or appended to the CSV file given by progress/output. Between
+ * two reports, each scheduling round costs a test and a read of the steady clock.
+ */
+namespace progress {
+
+XBT_PUBLIC_DATA(bool) enabled;
+
+/** Reports every that many wall-clock seconds (progress/period), or never if 0 */
+XBT_PUBLIC(void) set_period(double period);
+/** Writes the reports to that CSV file (progress/output), or logs them if the name is empty */
+XBT_PUBLIC(void) set_output(std::string const& filename);
+
+XBT_PUBLIC(void) count_events(size_t scheduled_actors);
+
+/** Reports if progress/period elapsed since the last report. Called once per scheduling round. */
+XBT_PUBLIC(void) tick(size_t pending_timers);
+/** Reports unconditionally */
+XBT_PUBLIC(void) report(size_t pending_timers);
+}
+}
+}
+
+#endif
@@ -0,0 +1,120 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/kernel/activity/ActivitySetImpl.hpp"
+
+#include "src/simix/popping_private.h"
+#include "src/simix/smx_private.h"
+
+XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(simix_network);
+
+namespace simgrid {
+namespace kernel {
+namespace activity {
+
+ActivitySetImpl::~ActivitySetImpl()
+{
+  xbt_assert(waiter_ == nullptr, "Cannot destroy an activity set while an actor waits on it");
+  for (CommImpl* comm : pending_)
+    comm->set = nullptr;
+  for (CommImpl* comm : done_)
+    comm->set = nullptr;
+}
+
+void ActivitySetImpl::add(CommImpl* comm)
+{
+  xbt_assert(comm->set == nullptr, "Comm %p already belongs to an activity set", comm);
+  comm->set = this;
+  if (comm->state == SIMIX_WAITING || comm->state == SIMIX_RUNNING || comm->state == SIMIX_READY) {
+    comm->set_done = false;
+    comm->set_it   = pending_.insert(pending_.end(), comm);
+  } else { // Already over
+    comm->set_done = true;
+    comm->set_it   = done_.insert(done_.end(), comm);
+    /* Nothing else will wake the actor waiting on the set (if any) for that one */
+    if (waiter_ != nullptr) {
+      smx_simcall_t simcall = waiter_;
+      waiter_               = nullptr;
+      hand_over(comm, simcall);
+      SIMIX_comm_finish(comm);
+    }
+  }
+}
+
+void ActivitySetImpl::remove(CommImpl* comm)
+{
+  xbt_assert(comm->set == this, "Comm %p is not part of this activity set", comm);
+  (comm->set_done ? done_ : pending_).erase(comm->set_it);
+  comm->set = nullptr;
+}
+
+void ActivitySetImpl::notify(CommImpl* comm)
+{
+  if (not comm->set_done) {
+    done_.splice(done_.end(), pending_, comm->set_it);
+    comm->set_done = true;
+  }
+  if (waiter_ == nullptr)
+    return;
+
+  smx_simcall_t simcall = waiter_;
+  waiter_               = nullptr;
+  /* Our caller (CommImpl::post) answers the simcall through SIMIX_comm_finish, on that comm only */
+  hand_over(comm, simcall);
+}
+
+void ActivitySetImpl::hand_over(CommImpl* comm, smx_simcall_t simcall)
+{
+  XBT_DEBUG("Activity set %p: hand comm %p over to %s", this, comm, simcall->issuer->cname());
+  remove(comm);
+  if (simcall->timer) {
+    SIMIX_timer_remove(simcall->timer);
+    simcall->timer = nullptr;
+  }
+  simcall_activity_set_waitany__set__result(simcall, comm);
+  comm->simcalls.push_back(simcall);
+}
+
+void ActivitySetImpl::wait_any(smx_simcall_t simcall, double timeout)
+{
+  xbt_assert(waiter_ == nullptr, "Only one actor can wait on an activity set at a time");
+  simcall->timer = nullptr;
+
+  if (not done_.empty()) {
+    CommImpl* comm = done_.front();
+    hand_over(comm, simcall);
+    SIMIX_comm_finish(comm);
+    return;
+  }
+  if (pending_.empty() || timeout == 0.0) {
+    simcall_activity_set_waitany__set__result(simcall, nullptr);
+    SIMIX_simcall_answer(simcall);
+    return;
+  }
+
+  waiter_ = simcall;
+  if (timeout > 0.0)
+    simcall->timer = SIMIX_timer_set(SIMIX_get_clock() + timeout, [this, simcall]() {
+      waiter_        = nullptr;
+      simcall->timer = nullptr;
+      simcall_activity_set_waitany__set__result(simcall, nullptr);
+      SIMIX_simcall_answer(simcall);
+    });
+}
+
+/** Forgets about the simcall of an actor that gets killed while waiting on the set */
+void ActivitySetImpl::cancel_wait(smx_simcall_t simcall)
+{
+  if (waiter_ != simcall)
+    return;
+  waiter_ = nullptr;
+  if (simcall->timer) {
+    SIMIX_timer_remove(simcall->timer);
+    simcall->timer = nullptr;
+  }
+}
+}
+}
+}
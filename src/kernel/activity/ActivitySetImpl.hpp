@@ -0,0 +1,54 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMIX_ACTIVITYSETIMPL_HPP
+#define SIMIX_ACTIVITYSETIMPL_HPP
+
+#include <list>
+
+#include "simgrid/forward.h"
+#include "src/kernel/activity/CommImpl.hpp"
+
+namespace simgrid {
+namespace kernel {
+namespace activity {
+
+/** @brief Implementation of the simgrid::s4u::ActivitySet
+ *
+ *  The comms are registered once when added to the set, instead of once per waitany simcall. When a member
+ *  terminates, it moves to the list of terminated comms, where the waiting actor (if any) gets it. So adding,
+ *  removing and getting a terminated comm are all O(1), whatever the size of the set.
+ *
+ *  A comm belongs to at most one set. The set does not hold a reference on its members: the caller has to remove
+ *  them (or to destroy the set) before releasing them.
+ */
+class ActivitySetImpl {
+public:
+  ActivitySetImpl() = default;
+  ~ActivitySetImpl();
+  ActivitySetImpl(ActivitySetImpl const&) = delete;
+  ActivitySetImpl& operator=(ActivitySetImpl const&) = delete;
+
+  void add(CommImpl* comm);
+  void remove(CommImpl* comm);
+  /** Called when a member terminates */
+  void notify(CommImpl* comm);
+  /** Answers the simcall with the oldest terminated member (removed from the set), or blocks it until there is one */
+  void wait_any(smx_simcall_t simcall, double timeout);
+  void cancel_wait(smx_simcall_t simcall);
+  size_t size() const { return pending_.size() + done_.size(); }
+
+private:
+  void hand_over(CommImpl* comm, smx_simcall_t simcall);
+
+  std::list<CommImpl*> pending_;
+  std::list<CommImpl*> done_; // in termination order
+  smx_simcall_t waiter_ = nullptr;
+};
+}
+}
+}
+
+#endif
@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/kernel/activity/CommImpl.hpp"
+#include "src/kernel/activity/ActivitySetImpl.hpp"
 
 #include "simgrid/modelchecker.h"
 #include "src/mc/mc_replay.h"
@@ -37,6 +38,8 @@ simgrid::kernel::activity::CommImpl::~CommImpl()
 
   if (mbox)
     mbox->remove(this);
+  if (set)
+    set->remove(this);
 }
 
 void simgrid::kernel::activity::CommImpl::suspend()
@@ -121,6 +124,10 @@ void simgrid::kernel::activity::CommImpl::post()
   /* destroy the surf actions associated with the Simix communication */
   cleanupSurf();
 
+  /* if we belong to an activity set, tell it (it may give us to the actor waiting on the set) */
+  if (set)
+    set->notify(this);
+
   /* if there are simcalls associated with the synchro, then answer them */
   if (not simcalls.empty()) {
     SIMIX_comm_finish(this);
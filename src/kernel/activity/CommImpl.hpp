@@ -7,15 +7,33 @@
 #define SIMIX_SYNCHRO_COMM_HPP
 
 #include "src/kernel/activity/ActivityImpl.hpp"
+#include "src/xbt/pool.hpp"
 #include "surf/surf.h"
 
+#include <cstdint>
+#include <list>
+
 typedef enum { SIMIX_COMM_SEND, SIMIX_COMM_RECEIVE, SIMIX_COMM_READY, SIMIX_COMM_DONE } e_smx_comm_type_t;
 
 namespace simgrid {
 namespace kernel {
 namespace activity {
 
-XBT_PUBLIC_CLASS CommImpl : public ActivityImpl
+class ActivitySetImpl;
+class CommImpl;
+class CommQueue;
+
+/** @brief Position of a communication within the CommQueue of a mailbox (only meaningful while it is queued) */
+struct CommQueueHook {
+  CommQueue* queue = nullptr;
+  std::list<CommImpl*>::iterator fifo_it;  /* Position in the FIFO of all queued comms */
+  std::list<CommImpl*>* index  = nullptr; /* Bucket of our match key, or list of the comms without key */
+  std::list<CommImpl*>::iterator index_it; /* Position in that index list */
+  unsigned long long seq = 0;             /* Arrival order in the queue */
+  e_smx_comm_type_t type = SIMIX_COMM_SEND;
+};
+
+XBT_PUBLIC_CLASS CommImpl : public ActivityImpl, public simgrid::xbt::PoolAllocated<CommImpl>
 {
   ~CommImpl() override;
 
@@ -44,6 +62,16 @@ public:
                                       expectations of the other side, too. See  */
   void (*copy_data_fun)(smx_activity_t, void*, size_t) = nullptr;
 
+  /* Match key of the user data, if its match function provides one (see SIMIX_comm_set_match_key_function) */
+  bool has_match_key = false;
+  uint64_t match_key = 0;
+  CommQueueHook queue_hook;
+
+  /* Membership in an ActivitySetImpl, if any */
+  ActivitySetImpl* set = nullptr;
+  std::list<CommImpl*>::iterator set_it;
+  bool set_done = false; /* Whether we are in the list of the terminated members of the set */
+
   /* Surf action data */
   surf_action_t surf_comm   = nullptr; /* The Surf communication action encapsulated */
   surf_action_t src_timeout = nullptr; /* Surf's actions to instrument the timeouts */
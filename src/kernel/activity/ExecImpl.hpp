@@ -7,13 +7,14 @@
 #define SIMIX_SYNCHRO_EXEC_HPP
 
 #include "src/kernel/activity/ActivityImpl.hpp"
+#include "src/xbt/pool.hpp"
 #include "surf/surf.h"
 
 namespace simgrid {
 namespace kernel {
 namespace activity {
 
-XBT_PUBLIC_CLASS ExecImpl : public ActivityImpl
+XBT_PUBLIC_CLASS ExecImpl : public ActivityImpl, public simgrid::xbt::PoolAllocated<ExecImpl>
 {
   ~ExecImpl() override;
 
@@ -3,19 +3,32 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include <vector>
+
 #include "src/kernel/activity/MailboxImpl.hpp"
 
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_mailbox, simix, "Mailbox implementation");
 
-static xbt_dict_t mailboxes = xbt_dict_new_homogeneous([](void* data) {
-  delete static_cast<smx_mailbox_t>(data);
-});
+/* Memory used by a mailbox (its name belongs to the pool of interned strings), and by a comm while it's queued (a node
+ * in the FIFO, another in the index) */
+static constexpr size_t mailbox_footprint     = sizeof(simgrid::kernel::activity::MailboxImpl);
+static constexpr size_t queued_comm_footprint = 2 * 3 * sizeof(void*);
+
+/* The mailboxes, indexed by the id of their name: the ids are dense, and most of the interned names are mailbox names */
+static std::vector<smx_mailbox_t>* mailboxes = new std::vector<smx_mailbox_t>();
 
 void SIMIX_mailbox_exit()
 {
-  xbt_dict_free(&mailboxes);
+  for (smx_mailbox_t mbox : *mailboxes)
+    if (mbox != nullptr) {
+      simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::mailboxes, mailbox_footprint);
+      delete mbox;
+    }
+  delete mailboxes;
+  mailboxes = nullptr;
 }
 
 /******************************************************************************/
@@ -25,21 +38,62 @@ void SIMIX_mailbox_exit()
 namespace simgrid {
 namespace kernel {
 namespace activity {
+/** @brief Appends a communication activity to the queue
+ *
+ *  Its type and match key must not change while it is queued.
+ */
+void CommQueue::push_back(CommImpl* comm)
+{
+  xbt_assert(comm->queue_hook.queue == nullptr, "Comm %p is already queued", comm);
+  xbt_assert(comm->type == SIMIX_COMM_SEND || comm->type == SIMIX_COMM_RECEIVE, "Cannot queue comm %p of type %d",
+             comm, (int)comm->type);
+  CommQueueHook& hook = comm->queue_hook;
+  Index& index        = index_[comm->type == SIMIX_COMM_SEND ? 0 : 1];
+
+  hook.queue   = this;
+  hook.seq     = next_seq_++;
+  hook.type    = comm->type;
+  hook.fifo_it = fifo_.insert(fifo_.end(), comm);
+  hook.index   = comm->has_match_key ? &index.keyed[comm->match_key] : &index.wildcards;
+  hook.index_it = hook.index->insert(hook.index->end(), comm);
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::mailboxes, queued_comm_footprint);
+}
+
+/** @brief Removes a communication activity from the queue, in constant time */
+void CommQueue::erase(CommImpl* comm)
+{
+  CommQueueHook& hook = comm->queue_hook;
+  xbt_assert(hook.queue == this, "Comm %p is not part of this queue", comm);
+
+  fifo_.erase(hook.fifo_it);
+  hook.index->erase(hook.index_it);
+  if (hook.index->empty() && comm->has_match_key) // Don't keep the buckets of the keys that are not used anymore
+    index_[hook.type == SIMIX_COMM_SEND ? 0 : 1].keyed.erase(comm->match_key);
+  hook.queue = nullptr;
+  hook.index = nullptr;
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::mailboxes, queued_comm_footprint);
+}
+
 /** @brief Returns the mailbox of that name, or nullptr */
 MailboxImpl* MailboxImpl::byNameOrNull(const char* name)
 {
-  return static_cast<smx_mailbox_t>(xbt_dict_get_or_null(mailboxes, name));
+  /* A name that was never interned cannot be the one of a mailbox */
+  uint32_t id = xbt::InternedString::find(name).id();
+  return id < mailboxes->size() ? (*mailboxes)[id] : nullptr;
 }
 /** @brief Returns the mailbox of that name, newly created on need */
 MailboxImpl* MailboxImpl::byNameOrCreate(const char* name)
 {
   xbt_assert(name, "Mailboxes must have a name");
   /* two processes may have pushed the same mbox_create simcall at the same time */
-  smx_mailbox_t mbox = static_cast<smx_mailbox_t>(xbt_dict_get_or_null(mailboxes, name));
+  xbt::InternedString key = xbt::InternedString(name);
+  if (key.id() >= mailboxes->size())
+    mailboxes->resize(key.id() + 1, nullptr);
+  smx_mailbox_t& mbox = (*mailboxes)[key.id()];
   if (not mbox) {
-    mbox = new MailboxImpl(name);
+    mbox = new MailboxImpl(key);
+    simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::mailboxes, mailbox_footprint);
     XBT_DEBUG("Creating a mailbox at %p with name %s", mbox, name);
-    xbt_dict_set(mailboxes, mbox->name_, mbox, nullptr);
   }
   return mbox;
 }
@@ -67,12 +121,9 @@ void MailboxImpl::remove(smx_activity_t activity)
   simgrid::kernel::activity::CommImpl* comm = static_cast<simgrid::kernel::activity::CommImpl*>(activity);
 
   comm->mbox = nullptr;
-  for (auto it = this->comm_queue.begin(); it != this->comm_queue.end(); it++)
-    if (*it == comm) {
-      this->comm_queue.erase(it);
-      return;
-    }
-  xbt_die("Cannot remove the comm %p that is not part of the mailbox %s", comm, this->name_);
+  if (comm->queue_hook.queue != &this->comm_queue)
+    xbt_die("Cannot remove the comm %p that is not part of the mailbox %s", comm, this->name_.c_str());
+  this->comm_queue.erase(comm);
 }
 }
 }
@@ -6,39 +6,106 @@
 #ifndef SIMIX_MAILBOXIMPL_H
 #define SIMIX_MAILBOXIMPL_H
 
-#include <boost/circular_buffer.hpp>
+#include <list>
+#include <unordered_map>
 
 #include "simgrid/s4u/Mailbox.hpp"
+#include "xbt/interned_string.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 #include "src/simix/ActorImpl.hpp"
 
-#define MAX_MAILBOX_SIZE 10000000
 namespace simgrid {
 namespace kernel {
 namespace activity {
 
-/** @brief Implementation of the simgrid::s4u::Mailbox */
+/** @brief The communications pending on a mailbox, in arrival order
+ *
+ *  Besides the FIFO, the queued comms are indexed by type and by match key (when their match function provides one,
+ *  see SIMIX_comm_set_match_key_function). Two comms that both have a key can only match if their keys are equal, so
+ *  looking for a match of a keyed comm only has to consider the bucket of its key and the comms that have no key. Both
+ *  lists are walked in arrival order, so the first matching comm is the same as with a linear search of the FIFO.
+ */
+class CommQueue {
+public:
+  CommQueue()                 = default;
+  CommQueue(const CommQueue&) = delete;
+  CommQueue& operator=(const CommQueue&) = delete;
 
-class MailboxImpl {
-  explicit MailboxImpl(const char* name)
-      : piface_(this), name_(xbt_strdup(name)), comm_queue(MAX_MAILBOX_SIZE), done_comm_queue(MAX_MAILBOX_SIZE)
+  bool empty() const { return fifo_.empty(); }
+  size_t size() const { return fifo_.size(); }
+  CommImpl* front() const { return fifo_.front(); }
+  std::list<CommImpl*>::const_iterator begin() const { return fifo_.begin(); }
+  std::list<CommImpl*>::const_iterator end() const { return fifo_.end(); }
+
+  void push_back(CommImpl* comm);
+  void erase(CommImpl* comm);
+
+  /** @brief Returns the oldest comm of the given type that the predicate accepts, or nullptr
+   *
+   *  @param type the type of the comms to consider (SIMIX_COMM_SEND or SIMIX_COMM_RECEIVE)
+   *  @param key_of the comm that we look a match for, used to skip the comms that cannot match it
+   *  @param accept called on the candidates, in arrival order, until it returns true
+   */
+  template <class F> CommImpl* find(e_smx_comm_type_t type, const CommImpl* key_of, F accept) const
   {
+    if (not key_of->has_match_key) {
+      for (CommImpl* comm : fifo_)
+        if (comm->queue_hook.type == type && accept(comm))
+          return comm;
+      return nullptr;
+    }
+
+    const Index& index = index_[type == SIMIX_COMM_SEND ? 0 : 1];
+    auto bucket        = index.keyed.find(key_of->match_key);
+    auto wild          = index.wildcards.begin();
+    if (bucket == index.keyed.end()) {
+      for (; wild != index.wildcards.end(); ++wild)
+        if (accept(*wild))
+          return *wild;
+      return nullptr;
+    }
+    /* Merge both lists according to the arrival order */
+    auto keyed = bucket->second.begin();
+    while (keyed != bucket->second.end() || wild != index.wildcards.end()) {
+      CommImpl* comm;
+      if (wild == index.wildcards.end() ||
+          (keyed != bucket->second.end() && (*keyed)->queue_hook.seq < (*wild)->queue_hook.seq))
+        comm = *keyed++;
+      else
+        comm = *wild++;
+      if (accept(comm))
+        return comm;
+    }
+    return nullptr;
   }
 
-public:
-  ~MailboxImpl() { xbt_free(name_); }
+private:
+  struct Index {
+    std::unordered_map<uint64_t, std::list<CommImpl*>> keyed;
+    std::list<CommImpl*> wildcards;
+  };
+  std::list<CommImpl*> fifo_;
+  Index index_[2]; /* one for the sends, one for the receives */
+  unsigned long long next_seq_ = 0;
+};
+
+/** @brief Implementation of the simgrid::s4u::Mailbox */
 
+class MailboxImpl {
+  explicit MailboxImpl(xbt::InternedString name) : piface_(this), name_(name) {}
+
+public:
   static MailboxImpl* byNameOrNull(const char* name);
   static MailboxImpl* byNameOrCreate(const char* name);
   void setReceiver(s4u::ActorPtr actor);
   void push(activity::CommImpl* comm);
   void remove(smx_activity_t activity);
   simgrid::s4u::Mailbox piface_; // Our interface
-  char* name_;
+  const xbt::InternedString name_;
 
   boost::intrusive_ptr<simgrid::simix::ActorImpl> permanent_receiver; // process which the mailbox is attached to
-  boost::circular_buffer_space_optimized<smx_activity_t> comm_queue;
-  boost::circular_buffer_space_optimized<smx_activity_t> done_comm_queue; // messages already received in the permanent receive mode
+  CommQueue comm_queue;
+  CommQueue done_comm_queue; // messages already received in the permanent receive mode
 };
 }
 }
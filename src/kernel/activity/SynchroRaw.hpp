@@ -8,13 +8,14 @@
 
 #include "surf/surf.h"
 #include "src/kernel/activity/ActivityImpl.hpp"
+#include "src/xbt/pool.hpp"
 
 namespace simgrid {
 namespace kernel {
 namespace activity {
 
   /** Used to implement mutexes, semaphores and conditions */
-  XBT_PUBLIC_CLASS Raw : public ActivityImpl {
+  XBT_PUBLIC_CLASS Raw : public ActivityImpl, public simgrid::xbt::PoolAllocated<Raw> {
   public:
     ~Raw() override;
     void suspend() override;
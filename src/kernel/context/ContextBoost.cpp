@@ -14,6 +14,8 @@
 #include <xbt/log.h>
 #include <xbt/xbt_os_thread.h>
 
+#include "mc/mc.h"
+
 #include "src/simix/smx_private.h"
 #include "src/internal_config.h"
 #include "src/kernel/context/ContextBoost.hpp"
@@ -106,19 +108,19 @@ void BoostContextFactory::run_all()
 #if HAVE_THREAD_CONTEXTS
   if (BoostContext::parallel_) {
     BoostContext::threads_working_ = 0;
-    xbt_parmap_apply(BoostContext::parmap_,
+    xbt_parmap_apply_getter(BoostContext::parmap_,
       [](void* arg) {
         smx_actor_t process = static_cast<smx_actor_t>(arg);
         BoostContext* context  = static_cast<BoostContext*>(process->context);
         return context->resume();
       },
-      simix_global->process_to_run);
+      &simix_global->process_to_run, &simgrid::simix::process_to_run_at);
   } else
 #endif
   {
-    if (xbt_dynar_is_empty(simix_global->process_to_run))
+    if (simix_global->process_to_run.empty())
       return;
-    smx_actor_t first_process = xbt_dynar_get_as(simix_global->process_to_run, 0, smx_actor_t);
+    smx_actor_t first_process = simix_global->process_to_run.front();
     BoostContext::process_index_ = 1;
     /* execute the first process */
     static_cast<BoostContext*>(first_process->context)->resume();
@@ -142,18 +144,9 @@ BoostContext::BoostContext(std::function<void()> code,
 
   /* if the user provided a function for the process then use it, otherwise it is the context for maestro */
   if (has_code()) {
-    this->stack_ = SIMIX_context_stack_new();
-// We need to pass the bottom of the stack to make_fcontext, depending on the stack direction it may be the lower
-// or higher address:
-#if PTH_STACKGROWTH == -1
-    void* stack = static_cast<char*>(this->stack_) + smx_context_usable_stack_size - 1;
-#else
-    void* stack = this->stack_;
-#endif
-    this->fc_ = boost::context::make_fcontext(
-                      stack,
-                      smx_context_usable_stack_size,
-                      smx_ctx_boost_wrapper);
+    /* The stack is only allocated when the actor is first scheduled, except for the model-checker */
+    if (MC_is_active())
+      create_stack();
   } else {
 #if HAVE_BOOST_CONTEXTS == 1
     this->fc_ = new boost::context::fcontext_t();
@@ -163,11 +156,24 @@ BoostContext::BoostContext(std::function<void()> code,
   }
 }
 
+void BoostContext::create_stack()
+{
+  this->stack_ = SIMIX_context_stack_new();
+// We need to pass the bottom of the stack to make_fcontext, depending on the stack direction it may be the lower
+// or higher address:
+#if PTH_STACKGROWTH == -1
+  void* stack = static_cast<char*>(this->stack_) + smx_context_usable_stack_size - 1;
+#else
+  void* stack = this->stack_;
+#endif
+  this->fc_ = boost::context::make_fcontext(stack, smx_context_usable_stack_size, smx_ctx_boost_wrapper);
+}
+
 BoostContext::~BoostContext()
 {
 #if HAVE_BOOST_CONTEXTS == 1
   if (not this->stack_)
-    delete this->fc_;
+    delete this->fc_; // Either maestro's context, or nullptr if the actor never ran
 #endif
   if (this == maestro_context_)
     maestro_context_ = nullptr;
@@ -178,6 +184,7 @@ BoostContext::~BoostContext()
 
 void BoostContext::resume()
 {
+  start_lazily();
   SIMIX_context_set_current(this);
 #if HAVE_BOOST_CONTEXTS == 1
   boost::context::jump_fcontext(maestro_context_->fc_, this->fc_, (intptr_t) this);
@@ -193,11 +200,11 @@ void BoostSerialContext::suspend()
   unsigned long int i              = process_index_;
   process_index_++;
 
-  if (i < xbt_dynar_length(simix_global->process_to_run)) {
+  if (i < simix_global->process_to_run.size()) {
     /* execute the next process */
     XBT_DEBUG("Run next process");
-    next_context =
-        static_cast<BoostSerialContext*>(xbt_dynar_get_as(simix_global->process_to_run, i, smx_actor_t)->context);
+    next_context = static_cast<BoostSerialContext*>(simix_global->process_to_run[i]->context);
+    next_context->start_lazily();
   } else {
     /* all processes were run, return to maestro */
     XBT_DEBUG("No more process to run");
@@ -229,6 +236,7 @@ void BoostParallelContext::suspend()
   if (next_work != nullptr) {
     XBT_DEBUG("Run next process");
     next_context = static_cast<BoostParallelContext*>(next_work->context);
+    next_context->start_lazily();
   } else {
     XBT_DEBUG("No more processes to run");
     uintptr_t worker_id = (uintptr_t)xbt_os_thread_get_specific(worker_id_key_);
@@ -251,6 +259,7 @@ void BoostParallelContext::stop()
 
 void BoostParallelContext::resume()
 {
+  start_lazily();
   uintptr_t worker_id = __sync_fetch_and_add(&threads_working_, 1);
   xbt_os_thread_set_specific(worker_id_key_, (void*) worker_id);
 
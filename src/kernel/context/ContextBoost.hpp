@@ -47,7 +47,15 @@ public:
           smx_actor_t process);
   ~BoostContext() override;
   virtual void resume();
+  /** Allocates the stack, the first time that the context is scheduled */
+  void start_lazily()
+  {
+    if (stack_ == nullptr)
+      create_stack();
+  }
+
 private:
+  void create_stack();
   static void wrapper(int first, ...);
 };
 
@@ -42,7 +42,15 @@ public:
   void stop() override;
   void suspend() override;
   void resume();
+  /** Allocates the stack, the first time that the context is scheduled */
+  void start_lazily()
+  {
+    if (stack_ == nullptr)
+      create_stack();
+  }
+
 private:
+  void create_stack();
   void suspend_serial();
   void suspend_parallel();
   void resume_serial();
@@ -301,11 +309,9 @@ RawContext::RawContext(std::function<void()> code,
   : Context(std::move(code), cleanup, process)
 {
    if (has_code()) {
-     this->stack_ = SIMIX_context_stack_new();
-     this->stack_top_ = raw_makecontext(this->stack_,
-                         smx_context_usable_stack_size,
-                         RawContext::wrapper,
-                         this);
+     /* The stack is only allocated when the actor is first scheduled, except for the model-checker */
+     if (MC_is_active())
+       create_stack();
    } else {
      if(process != nullptr && raw_maestro_context == nullptr)
        raw_maestro_context = this;
@@ -316,6 +322,12 @@ RawContext::RawContext(std::function<void()> code,
    }
 }
 
+void RawContext::create_stack()
+{
+  this->stack_     = SIMIX_context_stack_new();
+  this->stack_top_ = raw_makecontext(this->stack_, smx_context_usable_stack_size, RawContext::wrapper, this);
+}
+
 RawContext::~RawContext()
 {
   SIMIX_context_stack_delete(this->stack_);
@@ -337,11 +349,10 @@ void RawContextFactory::run_all()
 
 void RawContextFactory::run_all_serial()
 {
-  if (xbt_dynar_is_empty(simix_global->process_to_run))
+  if (simix_global->process_to_run.empty())
     return;
 
-  smx_actor_t first_process =
-      xbt_dynar_get_as(simix_global->process_to_run, 0, smx_actor_t);
+  smx_actor_t first_process = simix_global->process_to_run.front();
   raw_process_index = 1;
   static_cast<RawContext*>(first_process->context)->resume_serial();
 }
@@ -353,13 +364,13 @@ void RawContextFactory::run_all_parallel()
   if (raw_parmap == nullptr)
     raw_parmap = xbt_parmap_new(
       SIMIX_context_get_nthreads(), SIMIX_context_get_parallel_mode());
-  xbt_parmap_apply(raw_parmap,
+  xbt_parmap_apply_getter(raw_parmap,
       [](void* arg) {
         smx_actor_t process = static_cast<smx_actor_t>(arg);
         RawContext* context = static_cast<RawContext*>(process->context);
         context->resume_parallel();
       },
-      simix_global->process_to_run);
+      &simix_global->process_to_run, &simgrid::simix::process_to_run_at);
 #else
   xbt_die("You asked for a parallel execution, but you don't have any threads.");
 #endif
@@ -379,10 +390,11 @@ void RawContext::suspend_serial()
   RawContext* next_context = nullptr;
   unsigned long int i      = raw_process_index;
   raw_process_index++;
-  if (i < xbt_dynar_length(simix_global->process_to_run)) {
+  if (i < simix_global->process_to_run.size()) {
     /* execute the next process */
     XBT_DEBUG("Run next process");
-    next_context = static_cast<RawContext*>(xbt_dynar_get_as(simix_global->process_to_run, i, smx_actor_t)->context);
+    next_context = static_cast<RawContext*>(simix_global->process_to_run[i]->context);
+    next_context->start_lazily();
   } else {
     /* all processes were run, return to maestro */
     XBT_DEBUG("No more process to run");
@@ -403,6 +415,7 @@ void RawContext::suspend_parallel()
     /* there is a next process to resume */
     XBT_DEBUG("Run next process");
     next_context = static_cast<RawContext*>(next_work->context);
+    next_context->start_lazily();
   } else {
     /* all processes were run, go to the barrier */
     XBT_DEBUG("No more processes to run");
@@ -428,6 +441,7 @@ void RawContext::resume()
 
 void RawContext::resume_serial()
 {
+  start_lazily();
   SIMIX_context_set_current(this);
   raw_swapcontext(&raw_maestro_context->stack_top_, this->stack_top_);
 }
@@ -437,6 +451,7 @@ void RawContext::resume_parallel()
 #if HAVE_THREAD_CONTEXTS
   uintptr_t worker_id = __sync_fetch_and_add(&raw_threads_working, 1);
   xbt_os_thread_set_specific(raw_worker_id_key, (void*) worker_id);
+  start_lazily();
   RawContext* worker_context     = static_cast<RawContext*>(SIMIX_context_self());
   raw_workers_context[worker_id] = worker_context;
   XBT_DEBUG("Saving worker stack %zu", worker_id);
@@ -450,7 +465,7 @@ void RawContext::resume_parallel()
 /** @brief Resumes all processes ready to run. */
 void RawContextFactory::run_all_adaptative()
 {
-  unsigned long nb_processes = xbt_dynar_length(simix_global->process_to_run);
+  unsigned long nb_processes = simix_global->process_to_run.size();
   if (SIMIX_context_is_parallel() &&
       static_cast<unsigned long>(SIMIX_context_get_parallel_threshold()) < nb_processes) {
     raw_context_parallel = true;
@@ -7,9 +7,15 @@
 #include <utility>
 #include <functional>
 
+#include "src/internal_config.h"           /* loads context system definitions */
+#if HAVE_FUTEX_H
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #include "xbt/function_types.h"
 #include "src/simix/smx_private.h"
-#include "src/internal_config.h"           /* loads context system definitions */
 #include "xbt/swag.h"
 #include "xbt/xbt_os_thread.h"
 #include "src/xbt_modinter.h"       /* prototype of os thread module's init/exit in XBT */
@@ -20,6 +26,10 @@ XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(simix_context);
 
 static xbt_os_sem_t smx_ctx_thread_sem = nullptr;
 
+/* Whether the batons rely on futexes, and how long a taker spins before parking */
+static bool smx_ctx_thread_futex = false;
+static int smx_ctx_thread_spin   = 0;
+
 namespace simgrid {
 namespace kernel {
 namespace context {
@@ -30,9 +40,70 @@ XBT_PRIVATE ContextFactory* thread_factory()
   return new ThreadContextFactory();
 }
 
+ThreadBaton::ThreadBaton()
+{
+  if (not smx_ctx_thread_futex)
+    sem_ = xbt_os_sem_init(0);
+}
+
+ThreadBaton::~ThreadBaton()
+{
+  if (sem_)
+    xbt_os_sem_destroy(sem_);
+}
+
+void ThreadBaton::post()
+{
+  if (sem_) {
+    xbt_os_sem_release(sem_);
+    return;
+  }
+#if HAVE_FUTEX_H
+  if (state_.exchange(1, std::memory_order_release) == -1)
+    syscall(SYS_futex, reinterpret_cast<int*>(&state_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#endif
+}
+
+void ThreadBaton::take()
+{
+  if (sem_) {
+    xbt_os_sem_acquire(sem_);
+    return;
+  }
+#if HAVE_FUTEX_H
+  static_assert(sizeof(std::atomic<int>) == sizeof(int), "futexes need a plain int");
+  /* Fast path: the other thread is likely to give the baton back very soon */
+  for (int i = 0; i < smx_ctx_thread_spin; i++) {
+    int expected = 1;
+    if (state_.load(std::memory_order_relaxed) == 1 &&
+        state_.compare_exchange_weak(expected, 0, std::memory_order_acquire))
+      return;
+  }
+  /* Slow path: announce that we are parked, and sleep until the baton is posted */
+  while (true) {
+    int state = state_.load(std::memory_order_acquire);
+    if (state == 1) {
+      if (state_.compare_exchange_weak(state, 0, std::memory_order_acquire))
+        return;
+      continue;
+    }
+    if (state == 0 && not state_.compare_exchange_weak(state, -1, std::memory_order_relaxed))
+      continue;
+    /* Returns immediately if the baton was posted in between */
+    syscall(SYS_futex, reinterpret_cast<int*>(&state_), FUTEX_WAIT_PRIVATE, -1, nullptr, nullptr, 0);
+  }
+#endif
+}
+
 ThreadContextFactory::ThreadContextFactory()
   : ContextFactory("ThreadContextFactory")
 {
+#if HAVE_FUTEX_H
+  smx_ctx_thread_futex = (SIMIX_context_get_parallel_mode() != XBT_PARMAP_POSIX);
+  /* Spinning is pointless when the other thread cannot run at the same time */
+  smx_ctx_thread_spin = (xbt_os_get_numcores() > 1) ? 1000 : 0;
+#endif
+  XBT_DEBUG("Thread contexts use %s to hand control over", smx_ctx_thread_futex ? "futex batons" : "semaphores");
   if (SIMIX_context_is_parallel()) {
     smx_ctx_thread_sem = xbt_os_sem_init(SIMIX_context_get_nthreads());
   } else {
@@ -59,22 +130,24 @@ void ThreadContextFactory::run_all()
 {
   if (smx_ctx_thread_sem == nullptr) {
     // Serial execution
-    smx_actor_t process;
-    unsigned int cursor;
-    xbt_dynar_foreach(simix_global->process_to_run, cursor, process) {
+    // Indexed loops: the actors that run may add others to the list
+    for (size_t i = 0; i < simix_global->process_to_run.size(); i++) {
+      smx_actor_t process = simix_global->process_to_run[i];
       XBT_DEBUG("Handling %p",process);
       ThreadContext* context = static_cast<ThreadContext*>(process->context);
-      xbt_os_sem_release(context->begin_);
-      xbt_os_sem_acquire(context->end_);
+      context->start_lazily();
+      context->begin_.post();
+      context->end_.take();
     }
   } else {
     // Parallel execution
-    unsigned int index;
-    smx_actor_t process;
-    xbt_dynar_foreach(simix_global->process_to_run, index, process)
-      xbt_os_sem_release(static_cast<ThreadContext*>(process->context)->begin_);
-    xbt_dynar_foreach(simix_global->process_to_run, index, process)
-       xbt_os_sem_acquire(static_cast<ThreadContext*>(process->context)->end_);
+    for (size_t i = 0; i < simix_global->process_to_run.size(); i++) {
+      ThreadContext* context = static_cast<ThreadContext*>(simix_global->process_to_run[i]->context);
+      context->start_lazily();
+      context->begin_.post();
+    }
+    for (size_t i = 0; i < simix_global->process_to_run.size(); i++)
+      static_cast<ThreadContext*>(simix_global->process_to_run[i]->context)->end_.take();
   }
 }
 
@@ -98,27 +171,15 @@ ThreadContext::ThreadContext(std::function<void()> code,
     void_pfn_smxprocess_t cleanup, smx_actor_t process, bool maestro)
   : AttachContext(std::move(code), cleanup, process)
 {
-  // We do not need the semaphores when maestro is in main,
+  // We do not need the batons when maestro is in main,
   // but creating them anyway simplifies things when maestro is externalized
-  this->begin_ = xbt_os_sem_init(0);
-  this->end_ = xbt_os_sem_init(0);
 
-  /* If the user provided a function for the process then use it */
+  /* If the user provided a function for the process then use it. The thread of an actor is only created when it is
+   * first scheduled, so that the actors that never run cost no thread. */
+  maestro_ = maestro;
   if (has_code()) {
-    if (smx_context_stack_size_was_set)
-      xbt_os_thread_setstacksize(smx_context_stack_size);
-    if (smx_context_guard_size_was_set)
-      xbt_os_thread_setguardsize(smx_context_guard_size);
-
-    /* create and start the process */
-    /* NOTE: The first argument to xbt_os_thread_create used to be the process *
-    * name, but now the name is stored at SIMIX level, so we pass a null  */
-    this->thread_ =
-      xbt_os_thread_create(nullptr,
-        maestro ? ThreadContext::maestro_wrapper : ThreadContext::wrapper,
-        this, this);
-    /* wait the starting of the newly created process */
-    xbt_os_sem_acquire(this->end_);
+    if (maestro)
+      create_thread();
   }
 
   /* Otherwise, we attach to the current thread */
@@ -127,14 +188,26 @@ ThreadContext::ThreadContext(std::function<void()> code,
   }
 }
 
+void ThreadContext::create_thread()
+{
+  if (smx_context_stack_size_was_set)
+    xbt_os_thread_setstacksize(smx_context_stack_size);
+  if (smx_context_guard_size_was_set)
+    xbt_os_thread_setguardsize(smx_context_guard_size);
+
+  /* create and start the process */
+  /* NOTE: The first argument to xbt_os_thread_create used to be the process *
+   * name, but now the name is stored at SIMIX level, so we pass a null  */
+  this->thread_ =
+      xbt_os_thread_create(nullptr, maestro_ ? ThreadContext::maestro_wrapper : ThreadContext::wrapper, this, this);
+  /* wait the starting of the newly created process */
+  this->end_.take();
+}
+
 ThreadContext::~ThreadContext()
 {
   if (this->thread_) /* If there is a thread (maestro don't have any), wait for its termination */
     xbt_os_thread_join(this->thread_, nullptr);
-
-  /* destroy the synchronization objects */
-  xbt_os_sem_destroy(this->begin_);
-  xbt_os_sem_destroy(this->end_);
 }
 
 void *ThreadContext::wrapper(void *param)
@@ -150,9 +223,9 @@ void *ThreadContext::wrapper(void *param)
   sigaltstack(&stack, nullptr);
 #endif
   /* Tell the maestro we are starting, and wait for its green light */
-  xbt_os_sem_release(context->end_);
+  context->end_.post();
 
-  xbt_os_sem_acquire(context->begin_);
+  context->begin_.take();
   if (smx_ctx_thread_sem)       /* parallel run */
     xbt_os_sem_acquire(smx_ctx_thread_sem);
 
@@ -175,21 +248,21 @@ void *ThreadContext::maestro_wrapper(void *param)
   sigaltstack(&stack, nullptr);
 #endif
   /* Tell the caller we are starting */
-  xbt_os_sem_release(context->end_);
+  context->end_.post();
 
   // Wait for the caller to give control back to us:
-  xbt_os_sem_acquire(context->begin_);
+  context->begin_.take();
   (*context)();
 
   // Tell main that we have finished:
-  xbt_os_sem_release(context->end_);
+  context->end_.post();
 
   return nullptr;
 }
 
 void ThreadContext::start()
 {
-  xbt_os_sem_acquire(this->begin_);
+  this->begin_.take();
   if (smx_ctx_thread_sem)       /* parallel run */
     xbt_os_sem_acquire(smx_ctx_thread_sem);
 }
@@ -201,7 +274,7 @@ void ThreadContext::stop()
     xbt_os_sem_release(smx_ctx_thread_sem);
 
   // Signal to the maestro that it has finished:
-  xbt_os_sem_release(this->end_);
+  this->end_.post();
 
   xbt_os_thread_exit(nullptr);
 }
@@ -210,8 +283,8 @@ void ThreadContext::suspend()
 {
   if (smx_ctx_thread_sem)
     xbt_os_sem_release(smx_ctx_thread_sem);
-  xbt_os_sem_release(this->end_);
-  xbt_os_sem_acquire(this->begin_);
+  this->end_.post();
+  this->begin_.take();
   if (smx_ctx_thread_sem)
     xbt_os_sem_acquire(smx_ctx_thread_sem);
 }
@@ -220,7 +293,7 @@ void ThreadContext::attach_start()
 {
   // We're breaking the layers here by depending on the upper layer:
   ThreadContext* maestro = (ThreadContext*) simix_global->maestro_process->context;
-  xbt_os_sem_release(maestro->begin_);
+  maestro->begin_.post();
   this->start();
 }
 
@@ -228,10 +301,10 @@ void ThreadContext::attach_stop()
 {
   if (smx_ctx_thread_sem)
     xbt_os_sem_release(smx_ctx_thread_sem);
-  xbt_os_sem_release(this->end_);
+  this->end_.post();
 
   ThreadContext* maestro = (ThreadContext*) simix_global->maestro_process->context;
-  xbt_os_sem_acquire(maestro->end_);
+  maestro->end_.take();
 
   xbt_os_thread_set_extra_data(nullptr);
 }
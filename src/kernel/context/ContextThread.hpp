@@ -9,8 +9,9 @@
 #ifndef SIMGRID_SIMIX_THREAD_CONTEXT_HPP
 #define SIMGRID_SIMIX_THREAD_CONTEXT_HPP
 
-#include <simgrid/simix.hpp>
+#include <atomic>
 
+#include <simgrid/simix.hpp>
 
 namespace simgrid {
 namespace kernel {
@@ -19,6 +20,25 @@ namespace context {
 class ThreadContext;
 class ThreadContextFactory;
 
+/** A binary handoff between two threads: one of them posts the baton, the other one takes it
+ *
+ *  When futexes are available, the taker spins for a short while before parking in the kernel, so
+ *  that handing control back and forth between maestro and a short-lived actor step does not need
+ *  any syscall. Otherwise (or when asked with contexts/synchro:posix), this is a plain semaphore.
+ */
+class ThreadBaton {
+public:
+  ThreadBaton();
+  ~ThreadBaton();
+  ThreadBaton(const ThreadBaton&) = delete;
+  ThreadBaton& operator=(const ThreadBaton&) = delete;
+  void post();
+  void take();
+private:
+  std::atomic<int> state_{0};  /* 0: empty, 1: posted, -1: empty with a parked taker */
+  xbt_os_sem_t sem_ = nullptr; /* fallback when futexes are not used */
+};
+
 class ThreadContext : public AttachContext {
 public:
   friend ThreadContextFactory;
@@ -30,13 +50,22 @@ public:
   void suspend() override;
   void attach_start() override;
   void attach_stop() override;
+  /** Creates the thread, the first time that the context is scheduled */
+  void start_lazily()
+  {
+    if (thread_ == nullptr && has_code())
+      create_thread();
+  }
+
 private:
+  void create_thread();
+  bool maestro_ = false;
   /** A portable thread */
   xbt_os_thread_t thread_ = nullptr;
-  /** Semaphore used to schedule/yield the process */
-  xbt_os_sem_t begin_ = nullptr;
-  /** Semaphore used to schedule/unschedule */
-  xbt_os_sem_t end_ = nullptr;
+  /** Baton used to schedule/yield the process */
+  ThreadBaton begin_;
+  /** Baton used to schedule/unschedule */
+  ThreadBaton end_;
 
   static void* wrapper(void *param);
   static void* maestro_wrapper(void *param);
@@ -82,6 +82,15 @@ public:
   UContext(std::function<void()>  code,
     void_pfn_smxprocess_t cleanup_func, smx_actor_t process);
   ~UContext() override;
+  /** Allocates the stack, the first time that the context is scheduled */
+  void start_lazily()
+  {
+    if (stack_ == nullptr)
+      create_stack();
+  }
+
+private:
+  void create_stack();
 };
 
 class SerialUContext : public UContext {
@@ -172,22 +181,22 @@ void UContextFactory::run_all()
         sysv_parmap = xbt_parmap_new(
           SIMIX_context_get_nthreads(), SIMIX_context_get_parallel_mode());
 
-      xbt_parmap_apply(sysv_parmap,
+      xbt_parmap_apply_getter(sysv_parmap,
         [](void* arg) {
           smx_actor_t process = (smx_actor_t) arg;
           ParallelUContext* context = static_cast<ParallelUContext*>(process->context);
           context->resume();
         },
-        simix_global->process_to_run);
+        &simix_global->process_to_run, &simgrid::simix::process_to_run_at);
 #else
       xbt_die("You asked for a parallel execution, but you don't have any threads.");
 #endif
   } else {
     // Serial:
-    if (xbt_dynar_is_empty(simix_global->process_to_run))
+    if (simix_global->process_to_run.empty())
       return;
 
-    smx_actor_t first_process = xbt_dynar_get_as(simix_global->process_to_run, 0, smx_actor_t);
+    smx_actor_t first_process = simix_global->process_to_run.front();
     sysv_process_index = 1;
     SerialUContext* context = static_cast<SerialUContext*>(first_process->context);
     context->resume();
@@ -209,22 +218,27 @@ UContext::UContext(std::function<void()> code,
 {
   /* if the user provided a function for the process then use it, otherwise it is the context for maestro */
   if (has_code()) {
-    this->stack_ = (char*) SIMIX_context_stack_new();
-    getcontext(&this->uc_);
-    this->uc_.uc_link = nullptr;
-    this->uc_.uc_stack.ss_sp   = sg_makecontext_stack_addr(this->stack_);
-    this->uc_.uc_stack.ss_size = sg_makecontext_stack_size(smx_context_usable_stack_size);
-    simgrid_makecontext(&this->uc_, smx_ctx_sysv_wrapper, this);
+    /* The stack is only allocated when the actor is first scheduled, except for the model-checker */
+    if (MC_is_active())
+      create_stack();
   } else {
     if (process != nullptr && sysv_maestro_context == nullptr)
       sysv_maestro_context = this;
   }
+}
+
+void UContext::create_stack()
+{
+  this->stack_ = (char*) SIMIX_context_stack_new();
+  getcontext(&this->uc_);
+  this->uc_.uc_link = nullptr;
+  this->uc_.uc_stack.ss_sp   = sg_makecontext_stack_addr(this->stack_);
+  this->uc_.uc_stack.ss_size = sg_makecontext_stack_size(smx_context_usable_stack_size);
+  simgrid_makecontext(&this->uc_, smx_ctx_sysv_wrapper, this);
 
 #if SIMGRID_HAVE_MC
-  if (MC_is_active() && has_code()) {
-    MC_register_stack_area(this->stack_, process,
-                      &(this->uc_), smx_context_usable_stack_size);
-  }
+  if (MC_is_active())
+    MC_register_stack_area(this->stack_, this->process(), &(this->uc_), smx_context_usable_stack_size);
 #endif
 }
 
@@ -270,11 +284,11 @@ void SerialUContext::suspend()
   SerialUContext* next_context = nullptr;
   unsigned long int i = sysv_process_index++;
 
-  if (i < xbt_dynar_length(simix_global->process_to_run)) {
+  if (i < simix_global->process_to_run.size()) {
     /* execute the next process */
     XBT_DEBUG("Run next process");
-    next_context = (SerialUContext*) xbt_dynar_get_as(
-        simix_global->process_to_run,i, smx_actor_t)->context;
+    next_context = (SerialUContext*) simix_global->process_to_run[i]->context;
+    next_context->start_lazily();
   } else {
     /* all processes were run, return to maestro */
     XBT_DEBUG("No more process to run");
@@ -288,6 +302,7 @@ void SerialUContext::suspend()
 
 void SerialUContext::resume()
 {
+  start_lazily();
   SIMIX_context_set_current(this);
   swapcontext(&((SerialUContext*)sysv_maestro_context)->uc_, &this->uc_);
 }
@@ -302,6 +317,7 @@ void ParallelUContext::stop()
 void ParallelUContext::resume()
 {
 #if HAVE_THREAD_CONTEXTS
+  start_lazily();
   // What is my containing body?
   uintptr_t worker_id = __sync_fetch_and_add(&sysv_threads_working, 1);
   // Store the number of my containing body in os-thread-specific area :
@@ -354,6 +370,7 @@ void ParallelUContext::suspend()
     // There is a next soul to embody (ie, a next process to resume)
     XBT_DEBUG("Run next process");
     next_context = (ParallelUContext*) next_work->context;
+    next_context->start_lazily();
   } else {
     // All processes were run, go to the barrier
     XBT_DEBUG("No more processes to run");
@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/kernel/routing/DijkstraZone.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/surf/network_interface.hpp"
 
@@ -13,25 +14,12 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_route_dijkstra, surf, "Routing part of surf
 
 /* Free functions */
 
-static void route_cache_elem_free(void* e)
-{
-  route_cache_element_t elm = (route_cache_element_t)e;
-  if (elm) {
-    xbt_free(elm->pred_arr);
-    xbt_free(elm);
-  }
-}
-
-static void graph_node_map_elem_free(void* e)
-{
-  graph_node_map_element_t elm = (graph_node_map_element_t)e;
-  xbt_free(elm);
-}
-
 static void graph_edge_data_free(void* e) // FIXME: useless code duplication
 {
   sg_platf_route_cbarg_t e_route = (sg_platf_route_cbarg_t)e;
   if (e_route) {
+    simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::routing,
+                                   simgrid::kernel::routing::RoutedZone::routeFootprint(e_route));
     delete e_route->link_list;
     xbt_free(e_route);
   }
@@ -50,8 +38,6 @@ void DijkstraZone::seal()
   /* Create the topology graph */
   if (not routeGraph_)
     routeGraph_ = xbt_graph_new_graph(1, nullptr);
-  if (not graphNodeMap_)
-    graphNodeMap_ = xbt_dict_new_homogeneous(&graph_node_map_elem_free);
 
   /* Add the loopback if needed */
   if (surf_network_model->loopback_ && hierarchy_ == RoutingMode::base) {
@@ -71,6 +57,7 @@ void DijkstraZone::seal()
         sg_platf_route_cbarg_t e_route = xbt_new0(s_sg_platf_route_cbarg_t, 1);
         e_route->link_list             = new std::vector<surf::LinkImpl*>();
         e_route->link_list->push_back(surf_network_model->loopback_);
+        memory::allocated(memory::Tag::routing, routeFootprint(e_route));
         xbt_graph_new_edge(routeGraph_, node, node, e_route);
       }
     }
@@ -92,16 +79,15 @@ xbt_node_t DijkstraZone::routeGraphNewNode(int id, int graph_id)
   data->graph_id = graph_id;
 
   xbt_node_t node                = xbt_graph_new_node(routeGraph_, data);
-  graph_node_map_element_t elm   = xbt_new0(struct graph_node_map_element, 1);
-  elm->node = node;
-  xbt_dict_set_ext(graphNodeMap_, (char*)(&id), sizeof(int), (xbt_dictelm_t)elm, nullptr);
+  graphNodeMap_.emplace(id, node);
 
   return node;
 }
 
-graph_node_map_element_t DijkstraZone::nodeMapSearch(int id)
+xbt_node_t DijkstraZone::nodeMapSearch(int id)
 {
-  return (graph_node_map_element_t)xbt_dict_get_or_null_ext(graphNodeMap_, (char*)(&id), sizeof(int));
+  auto elm = graphNodeMap_.find(id);
+  return elm == graphNodeMap_.end() ? nullptr : elm->second;
 }
 
 /* Parsing */
@@ -109,17 +95,8 @@ graph_node_map_element_t DijkstraZone::nodeMapSearch(int id)
 void DijkstraZone::newRoute(int src_id, int dst_id, sg_platf_route_cbarg_t e_route)
 {
   XBT_DEBUG("Load Route from \"%d\" to \"%d\"", src_id, dst_id);
-  xbt_node_t src = nullptr;
-  xbt_node_t dst = nullptr;
-
-  graph_node_map_element_t src_elm = nodeMapSearch(src_id);
-  graph_node_map_element_t dst_elm = nodeMapSearch(dst_id);
-
-  if (src_elm)
-    src = src_elm->node;
-
-  if (dst_elm)
-    dst = dst_elm->node;
+  xbt_node_t src = nodeMapSearch(src_id);
+  xbt_node_t dst = nodeMapSearch(dst_id);
 
   /* add nodes if they don't exist in the graph */
   if (src_id == dst_id && src == nullptr && dst == nullptr) {
@@ -144,16 +121,16 @@ void DijkstraZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cb
   int src_id = src->id();
   int dst_id = dst->id();
 
-  int* pred_arr     = nullptr;
-  int size          = 0;
+  const int* pred_arr = nullptr;
+  std::vector<int> new_pred_arr;
   xbt_dynar_t nodes = xbt_graph_get_nodes(routeGraph_);
 
   /* Use the graph_node id mapping set to quickly find the nodes */
-  graph_node_map_element_t src_elm = nodeMapSearch(src_id);
-  graph_node_map_element_t dst_elm = nodeMapSearch(dst_id);
+  xbt_node_t src_elm = nodeMapSearch(src_id);
+  xbt_node_t dst_elm = nodeMapSearch(dst_id);
 
-  int src_node_id = ((graph_node_data_t)xbt_graph_node_get_data(src_elm->node))->graph_id;
-  int dst_node_id = ((graph_node_data_t)xbt_graph_node_get_data(dst_elm->node))->graph_id;
+  int src_node_id = ((graph_node_data_t)xbt_graph_node_get_data(src_elm))->graph_id;
+  int dst_node_id = ((graph_node_data_t)xbt_graph_node_get_data(dst_elm))->graph_id;
 
   /* if the src and dst are the same */
   if (src_node_id == dst_node_id) {
@@ -174,18 +151,19 @@ void DijkstraZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cb
     }
   }
 
-  route_cache_element_t elm = nullptr;
-  if (routeCache_) { /* cache mode  */
-    elm = (route_cache_element_t)xbt_dict_get_or_null_ext(routeCache_, (char*)(&src_id), sizeof(int));
+  if (cached_) { /* cache mode  */
+    /* The arrays do not move when the cache grows (e.g. during the recursive lookups below) */
+    auto elm = routeCache_.find(src_id);
+    if (elm != routeCache_.end())
+      pred_arr = elm->second.data();
   }
 
-  if (elm) { /* cached mode and cache hit */
-    pred_arr = elm->pred_arr;
-  } else { /* not cached mode, or cache miss */
+  if (pred_arr == nullptr) { /* not cached mode, or cache miss */
 
     int nr_nodes      = xbt_dynar_length(nodes);
     double* cost_arr  = xbt_new0(double, nr_nodes); /* link cost from src to other hosts */
-    pred_arr          = xbt_new0(int, nr_nodes);    /* predecessors in path from src */
+    new_pred_arr.resize(nr_nodes);                  /* predecessors in path from src */
+    pred_arr          = new_pred_arr.data();
     xbt_heap_t pqueue = xbt_heap_new(nr_nodes, xbt_free_f);
 
     /* initialize */
@@ -196,7 +174,7 @@ void DijkstraZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cb
         cost_arr[i] = DBL_MAX;
       }
 
-      pred_arr[i] = 0;
+      new_pred_arr[i] = 0;
 
       /* initialize priority queue */
       int* nodeid = xbt_new0(int, 1);
@@ -219,7 +197,7 @@ void DijkstraZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cb
         int cost_v_u                       = tmp_e_route->link_list->size(); /* count of links, old model assume 1 */
 
         if (cost_v_u + cost_arr[*v_id] < cost_arr[u_id]) {
-          pred_arr[u_id] = *v_id;
+          new_pred_arr[u_id] = *v_id;
           cost_arr[u_id] = cost_v_u + cost_arr[*v_id];
           int* nodeid    = xbt_new0(int, 1);
           *nodeid        = u_id;
@@ -278,7 +256,6 @@ void DijkstraZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cb
       if (lat)
         *lat += static_cast<surf::LinkImpl*>(link)->latency();
     }
-    size++;
   }
 
   if (hierarchy_ == RoutingMode::recursive) {
@@ -286,31 +263,25 @@ void DijkstraZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cb
     route->gw_dst = first_gw;
   }
 
-  if (routeCache_ && elm == nullptr) {
+  if (cached_ && not new_pred_arr.empty()) {
     /* add to predecessor list of the current src-host to cache */
-    elm           = xbt_new0(struct route_cache_element, 1);
-    elm->pred_arr = pred_arr;
-    elm->size     = size;
-    xbt_dict_set_ext(routeCache_, (char*)(&src_id), sizeof(int), (xbt_dictelm_t)elm, nullptr);
+    size_t bytes = new_pred_arr.size() * sizeof(int);
+    if (routeCache_.emplace(src_id, std::move(new_pred_arr)).second)
+      memory::allocated(memory::Tag::routing, bytes);
   }
-
-  if (not routeCache_)
-    xbt_free(pred_arr);
 }
 
 DijkstraZone::~DijkstraZone()
 {
   xbt_graph_free_graph(routeGraph_, &xbt_free_f, &graph_edge_data_free, &xbt_free_f);
-  xbt_dict_free(&graphNodeMap_);
-  xbt_dict_free(&routeCache_);
+  for (auto const& elm : routeCache_)
+    memory::freed(memory::Tag::routing, elm.second.size() * sizeof(int));
 }
 
 /* Creation routing model functions */
 
-DijkstraZone::DijkstraZone(NetZone* father, const char* name, bool cached) : RoutedZone(father, name)
+DijkstraZone::DijkstraZone(NetZone* father, const char* name, bool cached) : RoutedZone(father, name), cached_(cached)
 {
-  if (cached)
-    routeCache_ = xbt_dict_new_homogeneous(&route_cache_elem_free);
 }
 
 void DijkstraZone::addRoute(sg_platf_route_cbarg_t route)
@@ -325,8 +296,6 @@ void DijkstraZone::addRoute(sg_platf_route_cbarg_t route)
   /* Create the topology graph */
   if (not routeGraph_)
     routeGraph_ = xbt_graph_new_graph(1, nullptr);
-  if (not graphNodeMap_)
-    graphNodeMap_ = xbt_dict_new_homogeneous(&graph_node_map_elem_free);
 
   /* we don't check whether the route already exist, because the algorithm may find another path through some other
    * nodes */
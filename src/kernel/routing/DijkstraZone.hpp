@@ -7,6 +7,9 @@
 #define SURF_ROUTING_DIJKSTRA_HPP_
 
 #include "src/kernel/routing/RoutedZone.hpp"
+#include "src/xbt/flat_map.hpp"
+
+#include <vector>
 
 typedef struct graph_node_data {
   int id;
@@ -14,17 +17,6 @@ typedef struct graph_node_data {
 } s_graph_node_data_t;
 typedef s_graph_node_data_t* graph_node_data_t;
 
-typedef struct graph_node_map_element {
-  xbt_node_t node;
-} s_graph_node_map_element_t;
-typedef s_graph_node_map_element_t* graph_node_map_element_t;
-
-typedef struct route_cache_element {
-  int* pred_arr;
-  int size;
-} s_route_cache_element_t;
-typedef s_route_cache_element_t* route_cache_element_t;
-
 namespace simgrid {
 namespace kernel {
 namespace routing {
@@ -48,7 +40,7 @@ public:
 
   ~DijkstraZone() override;
   xbt_node_t routeGraphNewNode(int id, int graph_id);
-  graph_node_map_element_t nodeMapSearch(int id);
+  xbt_node_t nodeMapSearch(int id);
   void newRoute(int src_id, int dst_id, sg_platf_route_cbarg_t e_route);
   /* For each vertex (node) already in the graph,
    * make sure it also has a loopback link; this loopback
@@ -64,9 +56,10 @@ public:
   void getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cbarg_t route, double* lat) override;
   void addRoute(sg_platf_route_cbarg_t route) override;
 
-  xbt_graph_t routeGraph_  = nullptr; /* xbt_graph */
-  xbt_dict_t graphNodeMap_ = nullptr; /* map */
-  xbt_dict_t routeCache_   = nullptr; /* use in cache mode */
+  xbt_graph_t routeGraph_ = nullptr;                   /* xbt_graph */
+  simgrid::xbt::FlatMap<int, xbt_node_t> graphNodeMap_; /* netpoint id -> graph node */
+  bool cached_;
+  simgrid::xbt::FlatMap<int, std::vector<int>> routeCache_; /* src id -> predecessors, in cache mode */
 };
 }
 }
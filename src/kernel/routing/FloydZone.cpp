@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/kernel/routing/FloydZone.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/surf/network_interface.hpp"
 #include "xbt/log.h"
@@ -17,6 +18,12 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_route_floyd, surf, "Routing part of surf");
 #define TO_FLOYD_PRED(i, j) (predecessorTable_)[(i) + (j)*table_size]
 #define TO_FLOYD_LINK(i, j) (linkTable_)[(i) + (j)*table_size]
 
+/* Memory used by the cost, predecessor and link tables */
+static size_t tables_footprint(size_t table_size)
+{
+  return table_size * table_size * (sizeof(double) + sizeof(int) + sizeof(sg_platf_route_cbarg_t));
+}
+
 namespace simgrid {
 namespace kernel {
 namespace routing {
@@ -35,12 +42,32 @@ FloydZone::~FloydZone()
   int table_size = vertices_.size();
   /* Delete link_table */
   for (int i = 0; i < table_size; i++)
-    for (int j = 0; j < table_size; j++)
+    for (int j = 0; j < table_size; j++) {
+      if (TO_FLOYD_LINK(i, j))
+        memory::freed(memory::Tag::routing, routeFootprint(TO_FLOYD_LINK(i, j)));
       routing_route_free(TO_FLOYD_LINK(i, j));
+    }
   xbt_free(linkTable_);
 
   xbt_free(predecessorTable_);
   xbt_free(costTable_);
+  memory::freed(memory::Tag::routing, tables_footprint(table_size));
+}
+
+void FloydZone::newTables(size_t table_size)
+{
+  costTable_        = xbt_new0(double, table_size* table_size);                  /* link cost from host to host */
+  predecessorTable_ = xbt_new0(int, table_size* table_size);                     /* predecessor host numbers */
+  linkTable_        = xbt_new0(sg_platf_route_cbarg_t, table_size * table_size); /* actual link between src and dst */
+  memory::allocated(memory::Tag::routing, tables_footprint(table_size));
+
+  /* Initialize costs and predecessors */
+  for (unsigned int i = 0; i < table_size; i++)
+    for (unsigned int j = 0; j < table_size; j++) {
+      TO_FLOYD_COST(i, j) = DBL_MAX;
+      TO_FLOYD_PRED(i, j) = -1;
+      TO_FLOYD_LINK(i, j) = nullptr;
+    }
 }
 
 void FloydZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cbarg_t route, double* lat)
@@ -91,20 +118,8 @@ void FloydZone::addRoute(sg_platf_route_cbarg_t route)
 
   addRouteCheckParams(route);
 
-  if (not linkTable_) {
-    /* Create Cost, Predecessor and Link tables */
-    costTable_        = xbt_new0(double, table_size* table_size);                  /* link cost from host to host */
-    predecessorTable_ = xbt_new0(int, table_size* table_size);                     /* predecessor host numbers */
-    linkTable_        = xbt_new0(sg_platf_route_cbarg_t, table_size * table_size); /* actual link between src and dst */
-
-    /* Initialize costs and predecessors */
-    for (int i = 0; i < table_size; i++)
-      for (int j = 0; j < table_size; j++) {
-        TO_FLOYD_COST(i, j) = DBL_MAX;
-        TO_FLOYD_PRED(i, j) = -1;
-        TO_FLOYD_LINK(i, j) = nullptr;
-      }
-  }
+  if (not linkTable_)
+    newTables(table_size);
 
   /* Check that the route does not already exist */
   if (route->gw_dst) // netzone route (to adapt the error message, if any)
@@ -158,20 +173,8 @@ void FloydZone::seal()
   /* set the size of table routing */
   size_t table_size = vertices_.size();
 
-  if (not linkTable_) {
-    /* Create Cost, Predecessor and Link tables */
-    costTable_        = xbt_new0(double, table_size* table_size);                  /* link cost from host to host */
-    predecessorTable_ = xbt_new0(int, table_size* table_size);                     /* predecessor host numbers */
-    linkTable_        = xbt_new0(sg_platf_route_cbarg_t, table_size * table_size); /* actual link between src and dst */
-
-    /* Initialize costs and predecessors */
-    for (unsigned int i = 0; i < table_size; i++)
-      for (unsigned int j = 0; j < table_size; j++) {
-        TO_FLOYD_COST(i, j) = DBL_MAX;
-        TO_FLOYD_PRED(i, j) = -1;
-        TO_FLOYD_LINK(i, j) = nullptr;
-      }
-  }
+  if (not linkTable_)
+    newTables(table_size);
 
   /* Add the loopback if needed */
   if (surf_network_model->loopback_ && hierarchy_ == RoutingMode::base) {
@@ -183,6 +186,7 @@ void FloydZone::seal()
         e_route->gw_dst    = nullptr;
         e_route->link_list = new std::vector<surf::LinkImpl*>();
         e_route->link_list->push_back(surf_network_model->loopback_);
+        memory::allocated(memory::Tag::routing, routeFootprint(e_route));
         TO_FLOYD_LINK(i, i) = e_route;
         TO_FLOYD_PRED(i, i) = i;
         TO_FLOYD_COST(i, i) = 1;
@@ -31,6 +31,8 @@ public:
   void seal() override;
 
 private:
+  void newTables(size_t table_size);
+
   /* vars to compute the Floyd algorithm. */
   int* predecessorTable_;
   double* costTable_;
@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/kernel/routing/FullZone.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/surf/network_interface.hpp"
 
@@ -24,7 +25,7 @@ void FullZone::seal()
 
   /* Create table if needed */
   if (not routingTable_)
-    routingTable_ = xbt_new0(sg_platf_route_cbarg_t, table_size * table_size);
+    newTable(table_size);
 
   /* Add the loopback if needed */
   if (surf_network_model->loopback_ && hierarchy_ == RoutingMode::base) {
@@ -36,6 +37,7 @@ void FullZone::seal()
         e_route->gw_dst    = nullptr;
         e_route->link_list = new std::vector<surf::LinkImpl*>();
         e_route->link_list->push_back(surf_network_model->loopback_);
+        memory::allocated(memory::Tag::routing, routeFootprint(e_route));
         TO_ROUTE_FULL(i, i) = e_route;
       }
     }
@@ -50,14 +52,22 @@ FullZone::~FullZone()
     for (int i = 0; i < table_size; i++)
       for (int j = 0; j < table_size; j++) {
         if (TO_ROUTE_FULL(i, j)) {
+          memory::freed(memory::Tag::routing, routeFootprint(TO_ROUTE_FULL(i, j)));
           delete TO_ROUTE_FULL(i, j)->link_list;
           xbt_free(TO_ROUTE_FULL(i, j));
         }
       }
     xbt_free(routingTable_);
+    memory::freed(memory::Tag::routing, table_size * table_size * sizeof(sg_platf_route_cbarg_t));
   }
 }
 
+void FullZone::newTable(size_t table_size)
+{
+  routingTable_ = xbt_new0(sg_platf_route_cbarg_t, table_size * table_size);
+  memory::allocated(memory::Tag::routing, table_size * table_size * sizeof(sg_platf_route_cbarg_t));
+}
+
 void FullZone::getLocalRoute(NetPoint* src, NetPoint* dst, sg_platf_route_cbarg_t res, double* lat)
 {
   XBT_DEBUG("full getLocalRoute from %s[%d] to %s[%d]", src->cname(), src->id(), dst->cname(), dst->id());
@@ -85,7 +95,7 @@ void FullZone::addRoute(sg_platf_route_cbarg_t route)
   size_t table_size = vertices_.size();
 
   if (not routingTable_)
-    routingTable_ = xbt_new0(sg_platf_route_cbarg_t, table_size * table_size);
+    newTable(table_size);
 
   /* Check that the route does not already exist */
   if (route->gw_dst) // inter-zone route (to adapt the error message, if any)
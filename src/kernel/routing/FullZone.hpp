@@ -29,6 +29,9 @@ public:
   void addRoute(sg_platf_route_cbarg_t route) override;
 
   sg_platf_route_cbarg_t* routingTable_ = nullptr;
+
+private:
+  void newTable(size_t table_size);
 };
 }
 }
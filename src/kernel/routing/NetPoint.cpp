@@ -7,6 +7,7 @@
 
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/s4u/Host.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_route, surf, "Routing part of surf");
 
@@ -23,6 +24,12 @@ NetPoint::NetPoint(std::string name, NetPoint::Type componentType, NetZoneImpl*
     id_ = netzone_p->addComponent(this);
   simgrid::s4u::Engine::instance()->netpointRegister(this);
   simgrid::kernel::routing::NetPoint::onCreation(this);
+  memory::allocated(memory::Tag::platform, sizeof(NetPoint) + name_.size() + 1);
+}
+
+NetPoint::~NetPoint()
+{
+  memory::freed(memory::Tag::platform, sizeof(NetPoint) + name_.size() + 1);
 }
 }
 }
@@ -30,7 +30,7 @@ public:
   enum class Type { Host, Router, NetZone };
 
   NetPoint(std::string name, NetPoint::Type componentType, NetZoneImpl* netzone_p);
-  ~NetPoint() = default;
+  ~NetPoint();
 
   // Our rank in the vertices_ array of the netzone that contains us.
   unsigned int id() { return id_; }
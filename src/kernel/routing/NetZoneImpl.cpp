@@ -6,12 +6,16 @@
 #include "src/kernel/routing/NetZoneImpl.hpp"
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/s4u/Host.hpp"
+#include "src/kernel/Profiler.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/surf/cpu_interface.hpp"
 #include "src/surf/network_interface.hpp"
 
+#include "xbt/ex.hpp"
 #include "xbt/log.h"
 
+#include <limits>
+
 XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(surf_route);
 
 namespace simgrid {
@@ -306,9 +310,45 @@ bool NetZoneImpl::getBypassRoute(routing::NetPoint* src, routing::NetPoint* dst,
   return false;
 }
 
+std::vector<std::vector<double>> NetZoneImpl::getChildrenLookahead()
+{
+  std::vector<NetZone*>* zones = children();
+  std::vector<std::vector<double>> res(zones->size(), std::vector<double>(zones->size(), 0.0));
+  std::vector<surf::LinkImpl*> links;
+
+  for (unsigned i = 0; i < zones->size(); i++) {
+    NetPoint* src = static_cast<NetZoneImpl*>(zones->at(i))->netpoint_;
+    for (unsigned j = 0; j < zones->size(); j++) {
+      if (i == j)
+        continue;
+      s_sg_platf_route_cbarg_t route;
+      memset(&route, 0, sizeof(route));
+      route.link_list = &links;
+      links.clear();
+      /* Full leaves the route empty when there is none, Floyd and Dijkstra throw: no message ever comes that way */
+      try {
+        getLocalRoute(src, static_cast<NetZoneImpl*>(zones->at(j))->netpoint_, &route, &res[i][j]);
+        if (route.gw_src == nullptr && links.empty())
+          res[i][j] = std::numeric_limits<double>::infinity();
+      } catch (xbt_ex& e) {
+        if (e.category != arg_error)
+          throw;
+        res[i][j] = std::numeric_limits<double>::infinity();
+      }
+      XBT_DEBUG("Lookahead from '%s' to '%s': %g", zones->at(i)->name(), zones->at(j)->name(), res[i][j]);
+    }
+  }
+  return res;
+}
+
 void NetZoneImpl::getGlobalRoute(routing::NetPoint* src, routing::NetPoint* dst,
                                  /* OUT */ std::vector<surf::LinkImpl*>* links, double* latency)
 {
+  /* Only count the outermost call, not the recursive ones */
+  if (kernel::profiler::enabled && kernel::profiler::current_phase() != kernel::profiler::Phase::routing)
+    kernel::profiler::count_route_lookup();
+  kernel::profiler::Scope scope(kernel::profiler::Phase::routing);
+
   s_sg_platf_route_cbarg_t route;
   memset(&route, 0, sizeof(route));
 
@@ -7,6 +7,7 @@
 #define SIMGRID_ROUTING_NETZONEIMPL_HPP
 
 #include <map>
+#include <vector>
 
 #include "xbt/graph.h"
 
@@ -89,6 +90,16 @@ public:
   static void getGlobalRoute(routing::NetPoint * src, routing::NetPoint * dst,
                              /* OUT */ std::vector<surf::LinkImpl*> * links, double* latency);
 
+  /** @brief Lookahead between the sub-netzones of this netzone
+   *
+   * Entry [i][j] is the latency of the route from the i-th child to the j-th child, not counting the links within
+   * these children: no message sent from a host of the first one can reach a host of the second one sooner. This
+   * is the lookahead that a conservative parallel simulation partitioned along these children could use. It does
+   * not take the bypass routes into account. The diagonal is left to 0, and the entries of the children that have no
+   * route between them are +inf, whatever the routing of this netzone.
+   */
+  std::vector<std::vector<double>> getChildrenLookahead();
+
   virtual void getGraph(xbt_graph_t graph, xbt_dict_t nodes, xbt_dict_t edges) = 0;
   enum class RoutingMode {
     unset = 0, /**< Undefined type                                   */
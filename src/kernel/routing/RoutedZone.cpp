@@ -9,6 +9,7 @@
 #include "xbt/log.h"
 #include "xbt/sysdep.h"
 
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/kernel/routing/RoutedZone.hpp"
 #include "src/surf/network_interface.hpp"
@@ -151,10 +152,17 @@ sg_platf_route_cbarg_t RoutedZone::newExtendedRoute(RoutingMode hierarchy, sg_pl
       result->link_list->insert(result->link_list->begin(), link);
   }
   result->link_list->shrink_to_fit();
+  memory::allocated(memory::Tag::routing, routeFootprint(result));
 
   return result;
 }
 
+size_t RoutedZone::routeFootprint(sg_platf_route_cbarg_t route)
+{
+  return sizeof(s_sg_platf_route_cbarg_t) + sizeof(*route->link_list) +
+         route->link_list->capacity() * sizeof(surf::LinkImpl*);
+}
+
 void RoutedZone::getRouteCheckParams(NetPoint* src, NetPoint* dst)
 {
   xbt_assert(src, "Cannot find a route from nullptr to %s", dst->cname());
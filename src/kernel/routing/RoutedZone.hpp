@@ -55,6 +55,8 @@ public:
   void getGraph(xbt_graph_t graph, xbt_dict_t nodes, xbt_dict_t edges) override;
   virtual sg_platf_route_cbarg_t newExtendedRoute(RoutingMode hierarchy, sg_platf_route_cbarg_t routearg,
                                                   bool change_order);
+  /** Memory used by a route stored in a routing table, as accounted in the routing subsystem */
+  static size_t routeFootprint(sg_platf_route_cbarg_t route);
 
 protected:
   void getRouteCheckParams(NetPoint* src, NetPoint* dst);
@@ -36,14 +36,10 @@ void wait_for_requests()
   xbt_assert(mc_model_checker == nullptr);
 #endif
 
-  smx_actor_t process;
-  smx_simcall_t req;
-  unsigned int iter;
-
-  while (not xbt_dynar_is_empty(simix_global->process_to_run)) {
+  while (not simix_global->process_to_run.empty()) {
     SIMIX_process_runall();
-    xbt_dynar_foreach(simix_global->process_that_ran, iter, process) {
-      req = &process->simcall;
+    for (smx_actor_t process : simix_global->process_that_ran) {
+      smx_simcall_t req = &process->simcall;
       if (req->call != SIMCALL_NONE && not simgrid::mc::request_is_visible(req))
         SIMIX_simcall_handle(req, 0);
     }
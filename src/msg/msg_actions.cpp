@@ -25,30 +25,18 @@ void MSG_action_exit()
 /** \ingroup msg_trace_driven
  * \brief A trace loader
  *
- *  If path!=nullptr, load a trace file containing actions, and execute them.
+ *  If path!=nullptr, load a trace file containing actions (in the text or binary format), and execute them.
  *  Else, assume that each process gets the path in its deployment file
  */
 msg_error_t MSG_action_trace_run(char *path)
 {
-  if (path) {
-    simgrid::xbt::action_fs = new std::ifstream(path, std::ifstream::in);
-  }
+  if (path)
+    simgrid::xbt::replay_open(path);
 
   msg_error_t res = MSG_main();
 
-  if (not simgrid::xbt::action_queues.empty()) {
-    XBT_WARN("Not all actions got consumed. If the simulation ended successfully (without deadlock),"
-             " you may want to add new processes to your deployment file.");
-
-    for (auto actions_of : simgrid::xbt::action_queues) {
-      XBT_WARN("Still %zu actions for %s", actions_of.second->size(), actions_of.first.c_str());
-    }
-  }
-
-  if (path) {
-    delete simgrid::xbt::action_fs;
-    simgrid::xbt::action_fs = nullptr;
-  }
+  if (path)
+    simgrid::xbt::replay_close();
 
   return res;
 }
@@ -0,0 +1,117 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <vector>
+
+#include "mc/mc.h"
+#include "src/kernel/activity/ActivitySetImpl.hpp"
+#include "src/mc/mc_replay.h"
+#include "src/simix/popping_private.h"
+#include "src/simix/smx_private.h"
+#include "xbt/ex.hpp"
+#include "xbt/log.h"
+
+#include "simgrid/s4u/ActivitySet.hpp"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(s4u_activityset, s4u_activity, "S4U sets of activities");
+
+namespace simgrid {
+namespace s4u {
+
+ActivitySet::ActivitySet()
+{
+  /* The model-checker must see a regular waitany, so we don't register anything in the kernel in that case */
+  if (not MC_is_active() && not MC_record_replay_is_active())
+    pimpl_ = simgrid::simix::kernelImmediate([] { return new simgrid::kernel::activity::ActivitySetImpl(); });
+}
+
+ActivitySet::~ActivitySet()
+{
+  if (pimpl_) {
+    smx_activity_set_t set = pimpl_;
+    simgrid::simix::kernelImmediate([set] { delete set; });
+  }
+}
+
+void ActivitySet::add(CommPtr comm)
+{
+  xbt_assert(not comm->detached_, "Cannot add a detached communication to an activity set");
+  if (comm->state_ == inited)
+    comm->start();
+  xbt_assert(comm->state_ == started, "Cannot add a terminated communication to an activity set");
+
+  kernel::activity::ActivityImpl* impl = comm->pimpl_;
+  xbt_assert(index_.find(impl) == index_.end(), "This communication is already in the set");
+  index_.insert({impl, comms_.insert(comms_.end(), comm)});
+  if (pimpl_) {
+    smx_activity_set_t set = pimpl_;
+    simgrid::simix::kernelImmediate(
+        [set, impl] { set->add(static_cast<simgrid::kernel::activity::CommImpl*>(impl)); });
+  }
+}
+
+void ActivitySet::remove(CommPtr comm)
+{
+  auto it = index_.find(comm->pimpl_);
+  xbt_assert(it != index_.end(), "This communication is not in the set");
+  comms_.erase(it->second);
+  index_.erase(it);
+  if (pimpl_) {
+    smx_activity_set_t set                 = pimpl_;
+    kernel::activity::ActivityImpl* impl = comm->pimpl_;
+    simgrid::simix::kernelImmediate(
+        [set, impl] { set->remove(static_cast<simgrid::kernel::activity::CommImpl*>(impl)); });
+  }
+}
+
+/** Forgets about a member that the kernel already removed from its set */
+CommPtr ActivitySet::take(kernel::activity::ActivityImpl* impl)
+{
+  auto it = index_.find(impl);
+  xbt_assert(it != index_.end(), "The kernel returned a communication that is not in the set");
+  CommPtr comm = *it->second;
+  comms_.erase(it->second);
+  index_.erase(it);
+  return comm;
+}
+
+CommPtr ActivitySet::wait_any_for(double timeout)
+{
+  if (comms_.empty())
+    return nullptr;
+
+  if (pimpl_ == nullptr) {
+    std::vector<CommPtr> comms(comms_.begin(), comms_.end());
+    std::vector<CommPtr>::iterator res;
+    try {
+      res = Comm::wait_any_for(comms.begin(), comms.end(), timeout);
+    } catch (xbt_ex& e) {
+      if (e.value >= 0 && static_cast<size_t>(e.value) < comms.size())
+        take(comms[e.value]->pimpl_)->state_ = errored;
+      throw;
+    }
+    if (res == comms.end())
+      return nullptr;
+    return take((*res)->pimpl_);
+  }
+
+  smx_activity_t res;
+  try {
+    res = simcall_activity_set_waitany(pimpl_, timeout);
+  } catch (xbt_ex&) {
+    /* The kernel removed the failed communication from the set before raising the exception */
+    smx_activity_t failed = simcall_activity_set_waitany__get__result(&SIMIX_process_self()->simcall);
+    if (failed)
+      take(failed)->state_ = errored;
+    throw;
+  }
+  if (res == nullptr)
+    return nullptr;
+  CommPtr comm  = take(res);
+  comm->state_ = finished;
+  return comm;
+}
+}
+} // namespace simgrid::s4u
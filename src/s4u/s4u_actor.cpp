@@ -11,9 +11,13 @@
 #include "simgrid/s4u/Mailbox.hpp"
 
 #include "src/kernel/context/Context.hpp"
+#include "xbt/config.hpp"
 
 XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_actor, "S4U actors");
 
+static simgrid::config::Flag<unsigned long long> random_seed("random/seed", "Seed of the random streams of the actors",
+                                                             0);
+
 namespace simgrid {
 namespace s4u {
 
@@ -236,6 +240,12 @@ aid_t ppid()
   return SIMIX_process_self()->ppid;
 }
 
+simgrid::xbt::RandomStream randomStream(uint32_t index)
+{
+  uint64_t stream = (static_cast<uint64_t>(SIMIX_process_self()->pid) << 32) | index;
+  return simgrid::xbt::RandomStream(random_seed.get(), stream);
+}
+
 std::string name()
 {
   return SIMIX_process_self()->name;
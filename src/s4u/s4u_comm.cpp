@@ -3,8 +3,13 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include <cmath>
+
 #include "xbt/log.h"
+#include "mc/mc.h"
+#include "src/mc/mc_replay.h"
 #include "src/msg/msg_private.h"
+#include "src/simix/smx_network_private.h"
 
 #include "simgrid/s4u/Comm.hpp"
 #include "simgrid/s4u/Mailbox.hpp"
@@ -99,6 +104,39 @@ void Comm::start() {
   }
   state_ = started;
 }
+void Comm::start_batch(std::vector<Comm*> const& comms)
+{
+  /* The model-checker must see each communication as a separate transition */
+  if (comms.size() < 2 || MC_is_active() || MC_record_replay_is_active()) {
+    for (Comm* comm : comms)
+      comm->start();
+    return;
+  }
+
+  for (Comm* comm : comms) {
+    xbt_assert(comm->srcBuff_ != nullptr || comm->dstBuff_ != nullptr,
+               "Cannot start a communication before specifying whether we are the sender or the receiver");
+    xbt_assert(comm->mailbox_, "No rendez-vous point defined for this communication");
+    xbt_assert(std::isfinite(comm->remains_), "task_size is not finite!");
+    xbt_assert(std::isfinite(comm->rate_), "rate is not finite!");
+  }
+
+  XBT_DEBUG("Start %zu communications in one simcall", comms.size());
+  simgrid::simix::kernelImmediate([&comms] {
+    for (Comm* comm : comms) {
+      if (comm->srcBuff_ != nullptr) // Sender side
+        comm->pimpl_ = SIMIX_comm_isend(comm->sender_, comm->mailbox_->getImpl(), comm->remains_, comm->rate_,
+                                        comm->srcBuff_, comm->srcBuffSize_, comm->matchFunction_, comm->cleanFunction_,
+                                        comm->copyDataFunction_, comm->userData_, comm->detached_);
+      else // Receiver side
+        comm->pimpl_ = SIMIX_comm_irecv(comm->receiver_, comm->mailbox_->getImpl(), comm->dstBuff_, &comm->dstBuffSize_,
+                                        comm->matchFunction_, comm->copyDataFunction_, comm->userData_, comm->rate_);
+    }
+  });
+  for (Comm* comm : comms)
+    comm->state_ = started;
+}
+
 void Comm::wait() {
   xbt_assert(state_ == started || state_ == inited);
 
@@ -119,6 +157,7 @@ void Comm::wait() {
   state_ = finished;
   if (pimpl_)
     pimpl_->unref();
+  pimpl_ = nullptr;
 }
 
 void Comm::wait(double timeout) {
@@ -128,6 +167,7 @@ void Comm::wait(double timeout) {
     simcall_comm_wait(pimpl_, timeout);
     state_ = finished;
     pimpl_->unref();
+    pimpl_ = nullptr;
     return;
   }
 
@@ -145,6 +185,7 @@ void Comm::wait(double timeout) {
   state_ = finished;
   if (pimpl_)
     pimpl_->unref();
+  pimpl_ = nullptr;
 }
 
 void Comm::send_detached(MailboxPtr dest, void* data, int simulatedSize)
@@ -194,6 +235,7 @@ bool Comm::test() {
   if(simcall_comm_test(pimpl_)){
     state_ = finished;
     pimpl_->unref();
+    pimpl_ = nullptr;
     return true;
   }
   return false;
@@ -14,12 +14,27 @@
 #include "simgrid/s4u/Storage.hpp"
 #include "simgrid/simix.h"
 #include "src/kernel/EngineImpl.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/kernel/routing/NetZoneImpl.hpp"
+#include "src/simix/smx_private.h"
 #include "src/surf/network_interface.hpp"
+#include "src/xbt/flat_map.hpp"
 #include "surf/surf.h" // routing_platf. FIXME:KILLME. SOON
+#include "xbt/interned_string.hpp"
+
+#ifndef _WIN32
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 
 XBT_LOG_NEW_CATEGORY(s4u,"Log channels of the S4U (Simgrid for you) interface");
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(s4u_engine, s4u, "Logging specific to S4U (engine)");
 
 namespace simgrid {
 namespace s4u {
@@ -60,6 +75,16 @@ double Engine::getClock()
   return SIMIX_get_clock();
 }
 
+std::vector<MemoryUsage> Engine::memoryUsage()
+{
+  std::vector<MemoryUsage> res;
+  for (int tag = 0; tag < static_cast<int>(kernel::memory::Tag::count); tag++) {
+    kernel::memory::Usage use = kernel::memory::usage(static_cast<kernel::memory::Tag>(tag));
+    res.push_back({kernel::memory::name(static_cast<kernel::memory::Tag>(tag)), use.current, use.peak});
+  }
+  return res;
+}
+
 void Engine::loadPlatform(const char *platf)
 {
   SIMIX_create_environment(platf);
@@ -77,8 +102,28 @@ void Engine::loadDeployment(const char *deploy)
 {
   SIMIX_launch_application(deploy);
 }
+void Engine::deploy(std::vector<ActorDeployment> actors)
+{
+  simgrid::simix::kernelImmediate([&actors] {
+    /* Consecutive actors often run the same function: only look it up when it changes */
+    const char* function                      = nullptr;
+    simgrid::simix::ActorCodeFactory* factory = nullptr;
+    for (ActorDeployment& actor : actors) {
+      xbt_assert(actor.host, "Cannot deploy an actor on a null host");
+      xbt_assert(not actor.args.empty(), "The first argument of the actor must be its name");
+      if (function == nullptr || strcmp(function, actor.function) != 0) {
+        function = actor.function;
+        factory  = &SIMIX_get_actor_code_factory(function);
+        xbt_assert(*factory, "Function '%s' unknown", function);
+      }
+      std::string name = actor.args[0];
+      simgrid::simix::deploy_actor(actor.host, std::move(name), (*factory)(std::move(actor.args)), 0, -1, false,
+                                   nullptr);
+    }
+  });
+}
 // FIXME: The following duplicates the content of s4u::Host
-extern std::map<std::string, simgrid::s4u::Host*> host_list;
+extern simgrid::xbt::FlatMap<simgrid::xbt::InternedString, simgrid::s4u::Host*> host_list;
 /** @brief Returns the amount of hosts in the platform */
 size_t Engine::hostCount()
 {
@@ -87,8 +132,12 @@ size_t Engine::hostCount()
 /** @brief Fills the passed list with all hosts found in the platform */
 void Engine::hostList(std::vector<Host*>* list)
 {
-  for (auto kv : host_list)
+  /* In the alphabetical order, as it used to be */
+  size_t first = list->size();
+  for (auto const& kv : host_list)
     list->push_back(kv.second);
+  std::sort(list->begin() + first, list->end(),
+            [](Host* a, Host* b) { return strcmp(a->cname(), b->cname()) < 0; });
 }
 
 void Engine::run() {
@@ -99,6 +148,116 @@ void Engine::run() {
   }
 }
 
+void Engine::runUntil(double date)
+{
+  xbt_assert(not MC_is_active(), "Cannot stop the simulation at a given date under the model-checker");
+  xbt_assert(date >= SIMIX_get_clock(), "Cannot run until %f: we are already at %f", date, SIMIX_get_clock());
+  SIMIX_timer_set(date, [] { simix_global->stop_requested = true; });
+  SIMIX_run();
+}
+
+int Engine::fork(int count, std::vector<std::string>* results, int parallelism)
+{
+#ifdef _WIN32
+  xbt_die("Engine::fork() is not available on Windows");
+#else
+  xbt_assert(not MC_is_active(), "Cannot fork the simulation under the model-checker");
+  xbt_assert(simix_global->context_factory->name() != "ThreadContextFactory" && not SIMIX_context_is_parallel(),
+             "Cannot fork the simulation with thread or parallel contexts: only the calling thread survives a fork");
+  xbt_assert(SIMIX_is_maestro(), "Only the main function can fork the simulation");
+  xbt_assert(count > 0, "Cannot fork the simulation in %d branches", count);
+  if (parallelism <= 0 || parallelism > count)
+    parallelism = count;
+
+  /* Don't let the children flush what the parent buffered */
+  fflush(stdout);
+  fflush(stderr);
+
+  /* The running branches, with the read end of their pipe. poll() ignores the slots whose fd is negative. */
+  std::vector<pollfd> fds(parallelism, pollfd{-1, POLLIN, 0});
+  std::vector<int> branch_of(parallelism, -1);
+  std::vector<pid_t> pid_of(parallelism, -1);
+  std::vector<std::string> received(count);
+  int next_branch = 0;
+  int running     = 0;
+  char buffer[4096];
+
+  while (next_branch < count || running > 0) {
+    /* Start as many branches as allowed */
+    for (int slot = 0; slot < parallelism && next_branch < count; slot++) {
+      if (fds[slot].fd >= 0)
+        continue;
+      int branch = next_branch++;
+      int pipefd[2];
+      if (pipe(pipefd) != 0)
+        xbt_die("Cannot create a pipe for branch %d: %s", branch, strerror(errno));
+      pid_t pid = ::fork();
+      if (pid < 0)
+        xbt_die("Cannot fork branch %d: %s", branch, strerror(errno));
+      if (pid == 0) {
+        for (pollfd const& other : fds)
+          if (other.fd >= 0)
+            close(other.fd);
+        close(pipefd[0]);
+        pimpl->parentChannel_ = pipefd[1];
+        return branch;
+      }
+      close(pipefd[1]);
+      fds[slot]       = {pipefd[0], POLLIN, 0};
+      branch_of[slot] = branch;
+      pid_of[slot]    = pid;
+      running++;
+    }
+
+    /* Read all the pipes at once, so that no branch blocks on a full pipe while we wait for another one */
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno != EINTR)
+        xbt_die("Cannot poll the branches: %s", strerror(errno));
+      continue;
+    }
+    for (int slot = 0; slot < parallelism; slot++) {
+      if (fds[slot].fd < 0 || fds[slot].revents == 0)
+        continue;
+      ssize_t got = read(fds[slot].fd, buffer, sizeof buffer);
+      if (got > 0) {
+        received[branch_of[slot]].append(buffer, got);
+      } else if (got == 0 || errno != EINTR) {
+        /* The branch closed its end of the pipe, which it does when exiting */
+        close(fds[slot].fd);
+        fds[slot].fd = -1;
+        running--;
+        int status;
+        while (waitpid(pid_of[slot], &status, 0) < 0 && errno == EINTR)
+          continue;
+        if (not WIFEXITED(status) || WEXITSTATUS(status) != 0)
+          XBT_WARN("Branch %d (pid %d) did not terminate normally", branch_of[slot], (int)pid_of[slot]);
+      }
+    }
+  }
+
+  if (results)
+    *results = std::move(received);
+  return -1;
+#endif
+}
+
+void Engine::sendToParent(const std::string& data)
+{
+#ifndef _WIN32
+  xbt_assert(pimpl->parentChannel_ >= 0, "Only the branches created by Engine::fork() have a parent to send data to");
+  size_t sent = 0;
+  while (sent < data.size()) {
+    ssize_t res = write(pimpl->parentChannel_, data.data() + sent, data.size() - sent);
+    if (res < 0) {
+      if (errno != EINTR)
+        xbt_die("Cannot send data to the parent process: %s", strerror(errno));
+      continue;
+    }
+    sent += res;
+  }
+#endif
+}
+
 s4u::NetZone* Engine::netRoot()
 {
   return pimpl->netRoot_;
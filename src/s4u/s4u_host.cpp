@@ -13,12 +13,15 @@
 #include "simgrid/s4u/Host.hpp"
 #include "simgrid/s4u/Storage.hpp"
 #include "simgrid/simix.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/msg/msg_private.h"
 #include "src/simix/ActorImpl.hpp"
 #include "src/simix/smx_private.h"
 #include "src/surf/HostImpl.hpp"
 #include "src/surf/cpu_interface.hpp"
+#include "src/xbt/flat_map.hpp"
+#include "xbt/interned_string.hpp"
 #include "xbt/log.h"
 
 XBT_LOG_EXTERNAL_CATEGORY(surf_route);
@@ -33,7 +36,7 @@ template class Extendable<simgrid::s4u::Host>;
 
 namespace s4u {
 
-std::map<std::string, simgrid::s4u::Host*> host_list; // FIXME: move it to Engine
+simgrid::xbt::FlatMap<simgrid::xbt::InternedString, simgrid::s4u::Host*> host_list; // FIXME: move it to Engine
 
 simgrid::xbt::signal<void(Host&)> Host::onCreation;
 simgrid::xbt::signal<void(Host&)> Host::onDestruction;
@@ -44,13 +47,17 @@ Host::Host(const char* name)
   : name_(name)
 {
   xbt_assert(Host::by_name_or_null(name) == nullptr, "Refusing to create a second host named '%s'.", name);
-  host_list[name_] = this;
+  host_list.emplace(simgrid::xbt::InternedString(name), this);
   new simgrid::surf::HostImpl(this);
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::platform,
+                                     sizeof(Host) + sizeof(simgrid::surf::HostImpl) + name_.size() + 1);
 }
 
 Host::~Host()
 {
   xbt_assert(currentlyDestroying_, "Please call h->destroy() instead of manually deleting it.");
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::platform,
+                                 sizeof(Host) + sizeof(simgrid::surf::HostImpl) + name_.size() + 1);
 
   delete pimpl_;
   if (pimpl_netpoint != nullptr) // not removed yet by a children class
@@ -72,24 +79,30 @@ void Host::destroy()
   if (not currentlyDestroying_) {
     currentlyDestroying_ = true;
     onDestruction(*this);
-    host_list.erase(name_);
+    host_list.erase(simgrid::xbt::InternedString::find(name_.c_str()));
     delete this;
   }
 }
 
 Host* Host::by_name(std::string name)
 {
-  return host_list.at(name); // Will raise a std::out_of_range if the host does not exist
+  Host* host = by_name_or_null(name.c_str());
+  if (host == nullptr)
+    throw std::out_of_range("No host named " + name);
+  return host;
 }
 Host* Host::by_name_or_null(const char* name)
 {
-  return by_name_or_null(std::string(name));
+  /* A name that was never interned cannot be the one of a host */
+  simgrid::xbt::InternedString key = simgrid::xbt::InternedString::find(name);
+  if (not key)
+    return nullptr;
+  auto host = host_list.find(key);
+  return host == host_list.end() ? nullptr : host->second;
 }
 Host* Host::by_name_or_null(std::string name)
 {
-  if (host_list.find(name) == host_list.end())
-    return nullptr;
-  return host_list.at(name);
+  return by_name_or_null(name.c_str());
 }
 
 Host *Host::current(){
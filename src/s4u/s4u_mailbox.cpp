@@ -17,7 +17,7 @@ namespace simgrid {
 namespace s4u {
 
 const char *Mailbox::name() {
-  return pimpl_->name_;
+  return pimpl_->name_.c_str();
 }
 
 MailboxPtr Mailbox::byName(const char*name)
@@ -3,6 +3,7 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include <algorithm>
 #include <vector>
 
 #include "simgrid/host.h"
@@ -14,13 +15,15 @@
 #include "src/simix/smx_host_private.h"
 #include "src/surf/HostImpl.hpp"
 #include "src/surf/cpu_interface.hpp"
+#include "src/xbt/flat_map.hpp"
+#include "xbt/interned_string.hpp"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(sg_host, sd, "Logging specific to sg_hosts");
 
 // FIXME: The following duplicates the content of s4u::Host
 namespace simgrid {
 namespace s4u {
-extern std::map<std::string, simgrid::s4u::Host*> host_list;
+extern simgrid::xbt::FlatMap<simgrid::xbt::InternedString, simgrid::s4u::Host*> host_list;
 }
 }
 
@@ -28,21 +31,22 @@ extern "C" {
 
 void sg_host_exit()
 {
-  /* copy all names to not modify the map while iterating over it.
+  /* copy all hosts to not modify the map while iterating over it.
    *
    * Plus, the hosts are destroyed in the lexicographic order to ensure
    * that the output is reproducible: we don't want to kill them in the
    * pointer order as it could be platform-dependent, which would break
    * the tests.
    */
-  std::vector<std::string> names = std::vector<std::string>();
-  for (auto kv : simgrid::s4u::host_list)
-    names.push_back(kv.second->name());
+  std::vector<simgrid::s4u::Host*> hosts;
+  for (auto const& kv : simgrid::s4u::host_list)
+    hosts.push_back(kv.second);
 
-  std::sort(names.begin(), names.end());
+  std::sort(hosts.begin(), hosts.end(),
+            [](simgrid::s4u::Host* a, simgrid::s4u::Host* b) { return strcmp(a->cname(), b->cname()) < 0; });
 
-  for (auto name : names)
-    simgrid::s4u::host_list.at(name)->destroy();
+  for (auto host : hosts)
+    host->destroy();
 
   // host_list.clear(); This would be sufficient if the dict would contain smart_ptr. It's now useless
 }
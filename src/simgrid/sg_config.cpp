@@ -21,6 +21,10 @@
 #include "simgrid_config.h" /* what was compiled in? */
 #include "mc/mc.h"
 #include "simgrid/instr.h"
+#include "src/kernel/MemoryAccounting.hpp"
+#include "src/kernel/PartitionAnalysis.hpp"
+#include "src/kernel/Profiler.hpp"
+#include "src/kernel/ProgressReporter.hpp"
 #include "src/mc/mc_replay.h"
 #include "src/surf/surf_interface.hpp"
 
@@ -46,6 +50,7 @@ static void sg_config_cmd_line(int *argc, char **argv)
   int shall_exit = 0;
   int i;
   int j;
+  simgrid::config::BulkUpdate bulk_update; // All --cfg are set before notifying the watchers
 
   for (j = i = 1; i < *argc; i++) {
     if (not strncmp(argv[i], "--cfg=", strlen("--cfg="))) {
@@ -369,6 +374,33 @@ void sg_config_init(int *argc, char **argv)
                                               }
                                             });
 
+  /* Kernel self-profiler */
+  simgrid::config::declareFlag<std::string>(
+      "profiling/output", "File where to write the profile of the simulation kernel (JSON if its name ends with "
+                          ".json, CSV otherwise). No profiling if empty.",
+      "", [](std::string const& filename) { simgrid::kernel::profiler::set_output(filename); });
+  simgrid::config::bindFlag(simgrid::kernel::profiler::period, {"profiling/period"},
+                            "Period (in wall-clock seconds) at which the kernel profile is rewritten, or 0 to write "
+                            "it only at the end of the simulation");
+
+  /* Progress reports */
+  simgrid::config::declareFlag<double>(
+      "progress/period", "Period (in wall-clock seconds) at which the progress of the simulation is reported, or 0 to "
+                         "never report it",
+      0.0, [](double period) { simgrid::kernel::progress::set_period(period); });
+  simgrid::config::declareFlag<std::string>(
+      "progress/output", "CSV file where to write the progress reports. They are logged if empty.", "",
+      [](std::string const& filename) { simgrid::kernel::progress::set_output(filename); });
+
+  /* Analysis of the partitioning along the top-level netzones */
+  simgrid::config::bindFlag(simgrid::kernel::partition::enabled, "partition/report",
+                            "Whether to report how the simulation would split along its top-level netzones: their "
+                            "lookahead and the communications that cross them");
+
+  /* Memory accounting */
+  simgrid::config::bindFlag(simgrid::kernel::memory::enabled, "memory/accounting",
+                            "Whether to account the memory used by each subsystem, and report it at exit");
+
   xbt_cfg_register_boolean("cpu/maxmin-selective-update", "no", nullptr, "Update the constraint set propagating "
                                                                          "recursively to others constraints (off by "
                                                                          "default when optim is set to lazy)");
@@ -21,6 +21,7 @@
 #include "mc/mc.h"
 
 #include "smx_private.h"
+#include "src/kernel/activity/ActivitySetImpl.hpp"
 #include "src/kernel/activity/SleepImpl.hpp"
 #include "src/kernel/activity/SynchroIo.hpp"
 #include "src/kernel/activity/SynchroRaw.hpp"
@@ -87,8 +88,10 @@ void SIMIX_process_cleanup(smx_actor_t process)
   SIMIX_process_on_exit_runall(process);
 
   /* Unregister from the kill timer if any */
-  if (process->kill_timer != nullptr)
+  if (process->kill_timer != nullptr) {
     SIMIX_timer_remove(process->kill_timer);
+    process->kill_timer = nullptr;
+  }
 
   xbt_os_mutex_acquire(simix_global->mutex);
 
@@ -286,7 +289,7 @@ smx_actor_t SIMIX_process_create(const char* name, std::function<void()> code, v
   /* Now insert it in the global process list and in the process to run list */
   simix_global->process_list[process->pid] = process;
   XBT_DEBUG("Inserting %s(%s) in the to_run list", process->cname(), host->cname());
-  xbt_dynar_push_as(simix_global->process_to_run, smx_actor_t, process);
+  simix_global->process_to_run.push_back(process);
 
   /* Tracing the process creation */
   TRACE_msg_process_create(process->cname(), process->pid, process->host);
@@ -349,7 +352,7 @@ smx_actor_t SIMIX_process_attach(const char* name, void* data, const char* hostn
   /* Now insert it in the global process list and in the process to run list */
   simix_global->process_list[process->pid] = process;
   XBT_DEBUG("Inserting %s(%s) in the to_run list", process->cname(), host->cname());
-  xbt_dynar_push_as(simix_global->process_to_run, smx_actor_t, process);
+  simix_global->process_to_run.push_back(process);
 
   /* Tracing the process creation */
   TRACE_msg_process_create(process->cname(), process->pid, process->host);
@@ -393,10 +396,8 @@ void SIMIX_process_runall()
 {
   SIMIX_context_runall();
 
-  xbt_dynar_t tmp = simix_global->process_that_ran;
-  simix_global->process_that_ran = simix_global->process_to_run;
-  simix_global->process_to_run = tmp;
-  xbt_dynar_reset(simix_global->process_to_run);
+  simix_global->process_to_run.swap(simix_global->process_that_ran);
+  simix_global->process_to_run.clear();
 }
 
 void simcall_HANDLER_process_kill(smx_simcall_t simcall, smx_actor_t process) {
@@ -463,9 +464,12 @@ void SIMIX_process_kill(smx_actor_t process, smx_actor_t issuer) {
 
     process->waiting_synchro = nullptr;
   }
-  if (not xbt_dynar_member(simix_global->process_to_run, &(process)) && process != issuer) {
+  if (process->simcall.call == SIMCALL_ACTIVITY_SET_WAITANY)
+    simcall_activity_set_waitany__get__set(&process->simcall)->cancel_wait(&process->simcall);
+  if (process != issuer &&
+      boost::range::find(simix_global->process_to_run, process) == simix_global->process_to_run.end()) {
     XBT_DEBUG("Inserting %s in the to_run list", process->name.c_str());
-    xbt_dynar_push_as(simix_global->process_to_run, smx_actor_t, process);
+    simix_global->process_to_run.push_back(process);
   }
 }
 
@@ -502,9 +506,10 @@ void SIMIX_process_throw(smx_actor_t process, xbt_errcat_t cat, int value, const
         dynamic_cast<simgrid::kernel::activity::SleepImpl*>(process->waiting_synchro);
     if (sleep != nullptr) {
       SIMIX_process_sleep_destroy(process->waiting_synchro);
-      if (not xbt_dynar_member(simix_global->process_to_run, &(process)) && process != SIMIX_process_self()) {
+      if (process != SIMIX_process_self() &&
+          boost::range::find(simix_global->process_to_run, process) == simix_global->process_to_run.end()) {
         XBT_DEBUG("Inserting %s in the to_run list", process->name.c_str());
-        xbt_dynar_push_as(simix_global->process_to_run, smx_actor_t, process);
+        simix_global->process_to_run.push_back(process);
       }
     }
 
@@ -852,10 +857,16 @@ void SIMIX_process_set_context(smx_actor_t p,smx_context_t c) {
 
 /**
  * \brief Returns the list of processes to run.
+ *
+ * This is a copy of simix_global->process_to_run, that remains valid until the next call. Do not free it.
  */
 xbt_dynar_t SIMIX_process_get_runnable()
 {
-  return simix_global->process_to_run;
+  static xbt_dynar_t runnable = xbt_dynar_new(sizeof(smx_actor_t), nullptr);
+  xbt_dynar_reset(runnable);
+  for (smx_actor_t process : simix_global->process_to_run)
+    xbt_dynar_push_as(runnable, smx_actor_t, process);
+  return runnable;
 }
 
 /**
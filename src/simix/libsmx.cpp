@@ -482,6 +482,18 @@ int simcall_comm_testany(smx_activity_t* comms, size_t count)
   return simcall_BODY_comm_testany(comms, count);
 }
 
+/**
+ * \ingroup simix_comm_management
+ * \brief Waits until a member of the set terminates, and removes it from the set
+ *
+ * \return the terminated comm, or nullptr if the timeout elapsed (or if the set is empty)
+ */
+smx_activity_t simcall_activity_set_waitany(smx_activity_set_t set, double timeout)
+{
+  xbt_assert(std::isfinite(timeout), "timeout is not finite!");
+  return simcall_BODY_activity_set_waitany(set, timeout);
+}
+
 /**
  * \ingroup simix_comm_management
  */
@@ -3,7 +3,9 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include "mc/mc.h"
 #include "smx_private.h"
+#include "src/mc/mc_replay.h"
 #include "xbt/xbt_os_thread.h"
 #if SIMGRID_HAVE_MC
 #include "src/mc/mc_private.h"
@@ -27,12 +29,39 @@ void SIMIX_simcall_answer(smx_simcall_t simcall)
 /*    This check should be useless and slows everyone. Reactivate if you see something
  *    weird in process scheduling.
  */
-    /*    if(not xbt_dynar_member(simix_global->process_to_run, &(simcall->issuer))) */
-    xbt_dynar_push_as(simix_global->process_to_run, smx_actor_t, simcall->issuer);
+    /*    if (std::find(simix_global->process_to_run.begin(), simix_global->process_to_run.end(), simcall->issuer) ==
+     *        simix_global->process_to_run.end()) */
+    simix_global->process_to_run.push_back(simcall->issuer);
 /*    else DIE_IMPOSSIBLE; */
   }
 }
 
+/** Whether the [[inline]] simcalls may run their handler directly in the issuer
+ *
+ * The model-checker must see every simcall as a transition, so they always go through maestro in that case.
+ */
+int SIMIX_simcall_can_inline()
+{
+  return not MC_is_active() && not MC_record_replay_is_active();
+}
+
+namespace simgrid {
+namespace simix {
+
+InlineSimcallGuard::InlineSimcallGuard() : locked_(SIMIX_context_is_parallel())
+{
+  if (locked_)
+    xbt_os_mutex_acquire(simix_global->mutex);
+}
+
+InlineSimcallGuard::~InlineSimcallGuard()
+{
+  if (locked_)
+    xbt_os_mutex_release(simix_global->mutex);
+}
+}
+}
+
 void SIMIX_simcall_exit(smx_activity_t synchro)
 {
   synchro->post();
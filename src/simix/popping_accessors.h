@@ -636,6 +636,25 @@ static inline void simcall_comm_testany__set__result(smx_simcall_t simcall, int
     simgrid::simix::marshal<int>(simcall->result, result);
 }
 
+static inline smx_activity_set_t simcall_activity_set_waitany__get__set(smx_simcall_t simcall) {
+  return simgrid::simix::unmarshal<smx_activity_set_t>(simcall->args[0]);
+}
+static inline void simcall_activity_set_waitany__set__set(smx_simcall_t simcall, smx_activity_set_t arg) {
+    simgrid::simix::marshal<smx_activity_set_t>(simcall->args[0], arg);
+}
+static inline double simcall_activity_set_waitany__get__timeout(smx_simcall_t simcall) {
+  return simgrid::simix::unmarshal<double>(simcall->args[1]);
+}
+static inline void simcall_activity_set_waitany__set__timeout(smx_simcall_t simcall, double arg) {
+    simgrid::simix::marshal<double>(simcall->args[1], arg);
+}
+static inline smx_activity_t simcall_activity_set_waitany__get__result(smx_simcall_t simcall){
+    return simgrid::simix::unmarshal<smx_activity_t>(simcall->result);
+}
+static inline void simcall_activity_set_waitany__set__result(smx_simcall_t simcall, smx_activity_t result){
+    simgrid::simix::marshal<smx_activity_t>(simcall->result, result);
+}
+
 static inline smx_mutex_t simcall_mutex_init__get__result(smx_simcall_t simcall){
     return simgrid::simix::unmarshal<smx_mutex_t>(simcall->result);
 }
@@ -1045,6 +1064,7 @@ XBT_PRIVATE void simcall_HANDLER_comm_waitany(smx_simcall_t simcall, xbt_dynar_t
 XBT_PRIVATE void simcall_HANDLER_comm_wait(smx_simcall_t simcall, smx_activity_t comm, double timeout);
 XBT_PRIVATE void simcall_HANDLER_comm_test(smx_simcall_t simcall, smx_activity_t comm);
 XBT_PRIVATE void simcall_HANDLER_comm_testany(smx_simcall_t simcall, smx_activity_t* comms, size_t count);
+XBT_PRIVATE void simcall_HANDLER_activity_set_waitany(smx_simcall_t simcall, smx_activity_set_t set, double timeout);
 XBT_PRIVATE smx_mutex_t simcall_HANDLER_mutex_init(smx_simcall_t simcall);
 XBT_PRIVATE void simcall_HANDLER_mutex_lock(smx_simcall_t simcall, smx_mutex_t mutex);
 XBT_PRIVATE int simcall_HANDLER_mutex_trylock(smx_simcall_t simcall, smx_mutex_t mutex);
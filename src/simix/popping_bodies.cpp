@@ -35,6 +35,14 @@ inline static R simcall(e_smx_simcall_t call, T const&... t)
   }
   return simgrid::simix::unmarshal<R>(self->simcall.result);
 }
+
+/* Run the handler of an [[inline]] simcall directly in the issuer, without any context switch */
+template<class R, class F>
+inline static R simcall_inline(F code)
+{
+  simgrid::simix::InlineSimcallGuard guard;
+  return code();
+}
   
 inline static void simcall_BODY_process_kill(smx_actor_t process) {
     /* Go to that function to follow the code flow through the simcall barrier */
@@ -75,6 +83,8 @@ inline static void simcall_BODY_process_set_host(smx_actor_t process, sg_host_t
 inline static int simcall_BODY_process_is_suspended(smx_actor_t process) {
     /* Go to that function to follow the code flow through the simcall barrier */
     if (0) SIMIX_process_is_suspended(process);
+    if (SIMIX_simcall_can_inline())
+      return simcall_inline<int>([&]() { return SIMIX_process_is_suspended(process); });
     return simcall<int, smx_actor_t>(SIMCALL_PROCESS_IS_SUSPENDED, process);
   }
   
@@ -198,6 +208,12 @@ inline static int simcall_BODY_comm_testany(smx_activity_t* comms, size_t count)
     return simcall<int, smx_activity_t*, size_t>(SIMCALL_COMM_TESTANY, comms, count);
   }
   
+inline static smx_activity_t simcall_BODY_activity_set_waitany(smx_activity_set_t set, double timeout) {
+    /* Go to that function to follow the code flow through the simcall barrier */
+    if (0) simcall_HANDLER_activity_set_waitany(&SIMIX_process_self()->simcall, set, timeout);
+    return simcall<smx_activity_t, smx_activity_set_t, double>(SIMCALL_ACTIVITY_SET_WAITANY, set, timeout);
+  }
+  
 inline static smx_mutex_t simcall_BODY_mutex_init() {
     /* Go to that function to follow the code flow through the simcall barrier */
     if (0) simcall_HANDLER_mutex_init(&SIMIX_process_self()->simcall);
@@ -267,6 +283,8 @@ inline static void simcall_BODY_sem_release(smx_sem_t sem) {
 inline static int simcall_BODY_sem_would_block(smx_sem_t sem) {
     /* Go to that function to follow the code flow through the simcall barrier */
     if (0) simcall_HANDLER_sem_would_block(&SIMIX_process_self()->simcall, sem);
+    if (SIMIX_simcall_can_inline())
+      return simcall_inline<int>([&]() { return simcall_HANDLER_sem_would_block(&SIMIX_process_self()->simcall, sem); });
     return simcall<int, smx_sem_t>(SIMCALL_SEM_WOULD_BLOCK, sem);
   }
   
@@ -285,6 +303,8 @@ inline static void simcall_BODY_sem_acquire_timeout(smx_sem_t sem, double timeou
 inline static int simcall_BODY_sem_get_capacity(smx_sem_t sem) {
     /* Go to that function to follow the code flow through the simcall barrier */
     if (0) simcall_HANDLER_sem_get_capacity(&SIMIX_process_self()->simcall, sem);
+    if (SIMIX_simcall_can_inline())
+      return simcall_inline<int>([&]() { return simcall_HANDLER_sem_get_capacity(&SIMIX_process_self()->simcall, sem); });
     return simcall<int, smx_sem_t>(SIMCALL_SEM_GET_CAPACITY, sem);
   }
   
@@ -321,12 +341,16 @@ inline static int simcall_BODY_file_unlink(smx_file_t fd, sg_host_t host) {
 inline static sg_size_t simcall_BODY_file_get_size(smx_file_t fd) {
     /* Go to that function to follow the code flow through the simcall barrier */
     if (0) simcall_HANDLER_file_get_size(&SIMIX_process_self()->simcall, fd);
+    if (SIMIX_simcall_can_inline())
+      return simcall_inline<sg_size_t>([&]() { return simcall_HANDLER_file_get_size(&SIMIX_process_self()->simcall, fd); });
     return simcall<sg_size_t, smx_file_t>(SIMCALL_FILE_GET_SIZE, fd);
   }
   
 inline static sg_size_t simcall_BODY_file_tell(smx_file_t fd) {
     /* Go to that function to follow the code flow through the simcall barrier */
     if (0) simcall_HANDLER_file_tell(&SIMIX_process_self()->simcall, fd);
+    if (SIMIX_simcall_can_inline())
+      return simcall_inline<sg_size_t>([&]() { return simcall_HANDLER_file_tell(&SIMIX_process_self()->simcall, fd); });
     return simcall<sg_size_t, smx_file_t>(SIMCALL_FILE_TELL, fd);
   }
   
@@ -52,6 +52,7 @@ const char* simcall_names[] = {
     "SIMCALL_COMM_WAIT",
     "SIMCALL_COMM_TEST",
     "SIMCALL_COMM_TESTANY",
+    "SIMCALL_ACTIVITY_SET_WAITANY",
     "SIMCALL_MUTEX_INIT",
     "SIMCALL_MUTEX_LOCK",
     "SIMCALL_MUTEX_TRYLOCK",
@@ -219,6 +220,10 @@ case SIMCALL_COMM_TESTANY:
       simcall_HANDLER_comm_testany(simcall, simgrid::simix::unmarshal<smx_activity_t*>(simcall->args[0]), simgrid::simix::unmarshal<size_t>(simcall->args[1]));
       break;
 
+case SIMCALL_ACTIVITY_SET_WAITANY:
+      simcall_HANDLER_activity_set_waitany(simcall, simgrid::simix::unmarshal<smx_activity_set_t>(simcall->args[0]), simgrid::simix::unmarshal<double>(simcall->args[1]));
+      break;
+
 case SIMCALL_MUTEX_INIT:
       simgrid::simix::marshal<smx_mutex_t>(simcall->result, simcall_HANDLER_mutex_init(simcall));
       SIMIX_simcall_answer(simcall);
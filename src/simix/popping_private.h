@@ -66,6 +66,7 @@ XBT_PRIVATE void SIMIX_simcall_exit(smx_activity_t synchro);
 XBT_PRIVATE const char *SIMIX_simcall_name(e_smx_simcall_t kind);
 XBT_PRIVATE void SIMIX_run_kernel(std::function<void()> const* code);
 XBT_PRIVATE void SIMIX_run_blocking(std::function<void()> const* code);
+XBT_PRIVATE int SIMIX_simcall_can_inline();
 
 SG_END_DECL()
 
@@ -74,6 +75,18 @@ SG_END_DECL()
 namespace simgrid {
 namespace simix {
 
+/** Serializes the kernel code that runs directly in the actors when they run in parallel (see [[inline]] simcalls) */
+class XBT_PRIVATE InlineSimcallGuard {
+public:
+  InlineSimcallGuard();
+  ~InlineSimcallGuard();
+  InlineSimcallGuard(InlineSimcallGuard const&) = delete;
+  InlineSimcallGuard& operator=(InlineSimcallGuard const&) = delete;
+
+private:
+  bool locked_;
+};
+
 template<class T>
 class type {
   constexpr bool operator==(type) const    { return true; }
@@ -25,12 +25,13 @@ class Simcall(object):
     simcalls_BODY = None
     simcalls_PRE = None
 
-    def __init__(self, name, handler, res, args, call_kind):
+    def __init__(self, name, handler, res, args, call_kind, inline):
         self.name = name
         self.res = res
         self.args = args
         self.need_handler = handler
         self.call_kind = call_kind
+        self.inline = inline
 
     def check(self):
         # libsmx.c  simcall_BODY_
@@ -135,11 +136,14 @@ class Simcall(object):
         res.append(
             '    /* Go to that function to follow the code flow through the simcall barrier */')
         if self.need_handler:
-            res.append('    if (0) simcall_HANDLER_%s(%s);' % (self.name,
-                                                               ', '.join(["&SIMIX_process_self()->simcall"] + [arg.name for arg in self.args])))
+            call = 'simcall_HANDLER_%s(%s)' % (self.name,
+                                               ', '.join(["&SIMIX_process_self()->simcall"] + [arg.name for arg in self.args]))
         else:
-            res.append('    if (0) SIMIX_%s(%s);' % (self.name,
-                                                     ', '.join(arg.name for arg in self.args)))
+            call = 'SIMIX_%s(%s)' % (self.name, ', '.join(arg.name for arg in self.args))
+        res.append('    if (0) %s;' % call)
+        if self.inline:
+            res.append('    if (SIMIX_simcall_can_inline())')
+            res.append('      return simcall_inline<%s>([&]() { return %s; });' % (self.res.rettype(), call))
         res.append('    return simcall<%s%s>(SIMCALL_%s%s);' % (
             self.res.rettype(),
             "".join([ ", " + arg.rettype() for i, arg in enumerate(self.args) ]),
@@ -187,16 +191,20 @@ def parse(fn):
         else:
             ans = "Func"
         handler = True
+        inline = False
         if attrs:
             attrs = attrs[2:-2]
-            for attr in re.split(",", attrs):
+            for attr in (a.strip() for a in re.split(",", attrs)):
                 if attr == "block":
                     ans = "Blck"
                 elif attr == "nohandler":
                     handler = False
+                elif attr == "inline":
+                    inline = True
                 else:
                     assert False, "Unknown attribute %s in: %s" % (attr, line)
-        sim = Simcall(name, handler, Arg('result', ret), sargs, ans)
+        assert not (inline and ans == "Blck"), "Blocking simcalls cannot be inlined: %s" % line
+        sim = Simcall(name, handler, Arg('result', ret), sargs, ans, inline)
         if resdi is None:
             simcalls.append(sim)
         else:
@@ -363,6 +371,14 @@ inline static R simcall(e_smx_simcall_t call, T const&... t)
   }
   return simgrid::simix::unmarshal<R>(self->simcall.result);
 }
+
+/* Run the handler of an [[inline]] simcall directly in the issuer, without any context switch */
+template<class R, class F>
+inline static R simcall_inline(F code)
+{
+  simgrid::simix::InlineSimcallGuard guard;
+  return code();
+}
 ''')
     handle(fd, Simcall.body, simcalls, simcalls_dict)
     fd.write("/** @endcond */\n");
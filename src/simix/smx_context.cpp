@@ -21,6 +21,7 @@
 #include "xbt/swag.h"
 #include "xbt/xbt_os_thread.h"
 #include "smx_private.h"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "simgrid/sg_config.h"
 #include "src/internal_config.h"
 #include "simgrid/modelchecker.h"
@@ -163,6 +164,14 @@ void SIMIX_context_mod_exit()
   simix_global->context_factory = nullptr;
 }
 
+/* Memory used by a stack, including its guard pages */
+static size_t stack_footprint()
+{
+  if (smx_context_guard_size > 0 && not MC_is_active())
+    return smx_context_stack_size + smx_context_guard_size;
+  return smx_context_stack_size;
+}
+
 void *SIMIX_context_stack_new()
 {
   void *stack;
@@ -216,6 +225,7 @@ void *SIMIX_context_stack_new()
   memcpy((char *)stack + smx_context_usable_stack_size, &valgrind_stack_id, sizeof valgrind_stack_id);
 #endif
 
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::stacks, stack_footprint());
   return stack;
 }
 
@@ -223,6 +233,7 @@ void SIMIX_context_stack_delete(void *stack)
 {
   if (not stack)
     return;
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::stacks, stack_footprint());
 
 #if HAVE_VALGRIND_H
   unsigned int valgrind_stack_id;
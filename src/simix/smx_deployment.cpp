@@ -159,5 +159,58 @@ void registerFunction(const char* name, ActorCodeFactory factory)
   simix_global->registered_functions[name] = std::move(factory);
 }
 
+/** Starts an actor of the deployment (or sets a timer to start it later), and records it in the boot processes of its
+ *  host, so that it gets restarted when the host is turned back on.
+ *
+ *  The context of the actor (and thus its stack) is only created when it first runs. */
+void deploy_actor(sg_host_t host, std::string name, ActorCode code, double start_time, double kill_time,
+                  bool auto_restart, xbt_dict_t properties)
+{
+  ProcessArg* arg = new ProcessArg();
+  arg->name       = name;
+  arg->code       = code;
+  arg->data       = nullptr;
+  arg->host       = host;
+  arg->kill_time  = kill_time;
+  arg->properties = properties;
+
+  host->extension<simgrid::simix::Host>()->boot_processes.push_back(arg);
+
+  if (start_time > SIMIX_get_clock()) {
+
+    arg = new ProcessArg();
+    arg->name = std::move(name);
+    arg->code = std::move(code);
+    arg->data = nullptr;
+    arg->host = host;
+    arg->kill_time = kill_time;
+    arg->properties = properties;
+
+    XBT_DEBUG("Process %s@%s will be started at time %f", arg->name.c_str(), arg->host->cname(), start_time);
+    SIMIX_timer_set(start_time, [arg, auto_restart]() {
+      smx_actor_t actor = simix_global->create_process_function(arg->name.c_str(), std::move(arg->code), arg->data,
+                                                                arg->host, arg->properties, nullptr);
+      if (arg->kill_time >= 0)
+        simcall_process_set_kill_time(actor, arg->kill_time);
+      if (auto_restart)
+        SIMIX_process_auto_restart_set(actor, auto_restart);
+      delete arg;
+    });
+  } else {                      // start_time <= SIMIX_get_clock()
+    XBT_DEBUG("Starting Process %s(%s) right now", name.c_str(), host->cname());
+
+    smx_actor_t actor =
+        simix_global->create_process_function(name.c_str(), std::move(code), nullptr, host, properties, nullptr);
+
+    /* The actor creation will fail if the host is currently dead, but that's fine */
+    if (actor != nullptr) {
+      if (kill_time >= 0)
+        simcall_process_set_kill_time(actor, kill_time);
+      if (auto_restart)
+        SIMIX_process_auto_restart_set(actor, auto_restart);
+    }
+  }
+}
+
 }
 }
@@ -15,9 +15,15 @@
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/s4u/Host.hpp"
 
+#include "src/kernel/MemoryAccounting.hpp"
+#include "src/kernel/PartitionAnalysis.hpp"
+#include "src/kernel/Profiler.hpp"
+#include "src/kernel/ProgressReporter.hpp"
 #include "src/surf/surf_interface.hpp"
 #include "src/surf/xml/platf.hpp"
 #include "smx_private.h"
+#include "smx_timer_private.h"
+#include "src/xbt/pool.hpp"
 #include "xbt/ex.h"             /* ex_backtrace_display */
 
 #include "mc/mc.h"
@@ -50,16 +56,7 @@ XBT_LOG_NEW_CATEGORY(simix, "All SIMIX categories");
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_kernel, simix, "Logging specific to SIMIX (kernel)");
 
 std::unique_ptr<simgrid::simix::Global> simix_global;
-static xbt_heap_t simix_timers = nullptr;
-
-/** @brief Timer datatype */
-typedef struct s_smx_timer {
-  double date = 0.0;
-  simgrid::xbt::Task<void()> callback;
-
-  s_smx_timer()=default;
-  s_smx_timer(double date, simgrid::xbt::Task<void()> callback) : date(date), callback(std::move(callback)) {}
-} s_smx_timer_t;
+static simgrid::simix::TimerQueue* simix_timers = nullptr;
 
 void (*SMPI_switch_data_segment)(int) = nullptr;
 
@@ -154,7 +151,7 @@ static void install_segvhandler()
 /********************************* SIMIX **************************************/
 double SIMIX_timer_next()
 {
-  return xbt_heap_size(simix_timers) > 0 ? xbt_heap_maxkey(simix_timers) : -1.0;
+  return simix_timers->next_date();
 }
 
 static void kill_process(smx_actor_t process)
@@ -204,8 +201,6 @@ void SIMIX_global_init(int *argc, char **argv)
     simix_global = std::unique_ptr<simgrid::simix::Global>(new simgrid::simix::Global());
 
     simgrid::simix::ActorImpl proc;
-    simix_global->process_to_run = xbt_dynar_new(sizeof(smx_actor_t), nullptr);
-    simix_global->process_that_ran = xbt_dynar_new(sizeof(smx_actor_t), nullptr);
     simix_global->process_to_destroy = xbt_swag_new(xbt_swag_offset(proc, destroy_hookup));
     simix_global->maestro_process = nullptr;
     simix_global->create_process_function = &SIMIX_process_create;
@@ -229,6 +224,10 @@ void SIMIX_global_init(int *argc, char **argv)
     /* register a function to be called by SURF after the environment creation */
     sg_platf_init();
     simgrid::s4u::onPlatformCreated.connect(SIMIX_post_create_environment);
+    simgrid::s4u::onPlatformCreated.connect([]() {
+      if (simgrid::kernel::partition::enabled)
+        simgrid::kernel::partition::analyze_platform();
+    });
     simgrid::s4u::Host::onCreation.connect([](simgrid::s4u::Host& host) {
       if (host.extension<simgrid::simix::Host>() == nullptr) // another callback to the same signal may have created it
         host.extension_set<simgrid::simix::Host>(new simgrid::simix::Host());
@@ -241,9 +240,7 @@ void SIMIX_global_init(int *argc, char **argv)
   }
 
   if (not simix_timers)
-    simix_timers = xbt_heap_new(8, [](void* p) {
-      delete static_cast<smx_timer_t>(p);
-    });
+    simix_timers = new simgrid::simix::TimerQueue();
 
   if (xbt_cfg_get_boolean("clean-atexit"))
     atexit(SIMIX_clean);
@@ -265,7 +262,7 @@ void SIMIX_clean()
     return; // to avoid double cleaning by java and C
 
 #if HAVE_SMPI
-  if (SIMIX_process_count()>0){
+  if (smpi_enabled() && SIMIX_process_count() > 0) {
     if(smpi_process()->initialized()){
       xbt_die("Process exited without calling MPI_Finalize - Killing simulation");
     }else{
@@ -277,7 +274,9 @@ void SIMIX_clean()
 
   smx_cleaned = 1;
   XBT_DEBUG("SIMIX_clean called. Simulation's over.");
-  if (not xbt_dynar_is_empty(simix_global->process_to_run) && SIMIX_get_clock() <= 0.0) {
+  simgrid::kernel::profiler::dump();
+  simgrid::kernel::memory::report();
+  if (not simix_global->process_to_run.empty() && SIMIX_get_clock() <= 0.0) {
     XBT_CRITICAL("   ");
     XBT_CRITICAL("The time is still 0, and you still have processes ready to run.");
     XBT_CRITICAL("It seems that you forgot to run the simulation that you setup.");
@@ -289,11 +288,9 @@ void SIMIX_clean()
   /* Exit the SIMIX network module */
   SIMIX_mailbox_exit();
 
-  xbt_heap_free(simix_timers);
+  delete simix_timers;
   simix_timers = nullptr;
   /* Free the remaining data structures */
-  xbt_dynar_free(&simix_global->process_to_run);
-  xbt_dynar_free(&simix_global->process_that_ran);
   xbt_swag_free(simix_global->process_to_destroy);
   simix_global->process_list.clear();
   simix_global->process_to_destroy = nullptr;
@@ -315,6 +312,7 @@ void SIMIX_clean()
 
   surf_exit();
 
+  simgrid::xbt::Pool::report();
   simix_global = nullptr;
 }
 
@@ -334,9 +332,9 @@ double SIMIX_get_clock()
   }
 }
 
-static int process_syscall_color(void *p)
+static int process_syscall_color(smx_actor_t process)
 {
-  switch ((*(smx_actor_t *)p)->simcall.call) {
+  switch (process->simcall.call) {
   case SIMCALL_NONE:
   case SIMCALL_PROCESS_KILL:
     return 2;
@@ -347,6 +345,26 @@ static int process_syscall_color(void *p)
   }
 }
 
+/* Same permutation as xbt_dynar_three_way_partition(), on which the order of the simcalls depends */
+static void three_way_partition(std::vector<smx_actor_t>& processes)
+{
+  size_t p = -1;
+  size_t q = processes.size();
+  for (size_t i = 0; i < q;) {
+    int color = process_syscall_color(processes[i]);
+    if (color == 1) {
+      ++i;
+    } else if (color == 0) {
+      ++p;
+      std::swap(processes[p], processes[i]);
+      ++i;
+    } else { /* color == 2 */
+      --q;
+      std::swap(processes[q], processes[i]);
+    }
+  }
+}
+
 /** Wake up all processes waiting for a Surf action to finish */
 static void SIMIX_wake_processes()
 {
@@ -372,12 +390,13 @@ static void SIMIX_wake_processes()
 /** Handle any pending timer */
 static bool SIMIX_execute_timers()
 {
+  simgrid::kernel::profiler::Scope scope(simgrid::kernel::profiler::Phase::timers);
   bool result = false;
-  while (xbt_heap_size(simix_timers) > 0 && SIMIX_get_clock() >= SIMIX_timer_next()) {
+  while (simix_timers->size() > 0 && SIMIX_get_clock() >= SIMIX_timer_next()) {
     result = true;
      //FIXME: make the timers being real callbacks
      // (i.e. provide dispatchers that read and expand the args)
-     smx_timer_t timer = (smx_timer_t) xbt_heap_pop(simix_timers);
+     smx_timer_t timer = simix_timers->pop();
      try {
        timer->callback();
      }
@@ -429,18 +448,24 @@ void SIMIX_run()
   double time = 0;
 
   do {
-    XBT_DEBUG("New Schedule Round; size(queue)=%lu", xbt_dynar_length(simix_global->process_to_run));
+    XBT_DEBUG("New Schedule Round; size(queue)=%zu", simix_global->process_to_run.size());
 
     SIMIX_execute_tasks();
 
-    while (not xbt_dynar_is_empty(simix_global->process_to_run)) {
-      XBT_DEBUG("New Sub-Schedule Round; size(queue)=%lu", xbt_dynar_length(simix_global->process_to_run));
+    while (not simix_global->process_to_run.empty()) {
+      XBT_DEBUG("New Sub-Schedule Round; size(queue)=%zu", simix_global->process_to_run.size());
+
+      if (simgrid::kernel::progress::enabled)
+        simgrid::kernel::progress::count_events(simix_global->process_to_run.size());
 
       /* Run all processes that are ready to run, possibly in parallel */
-      SIMIX_process_runall();
+      {
+        simgrid::kernel::profiler::Scope scope(simgrid::kernel::profiler::Phase::actors);
+        SIMIX_process_runall();
+      }
 
       /* Move all killer processes to the end of the list, because killing a process that have an ongoing simcall is a bad idea */
-      xbt_dynar_three_way_partition(simix_global->process_that_ran, process_syscall_color);
+      three_way_partition(simix_global->process_that_ran);
 
       /* answer sequentially and in a fixed arbitrary order all the simcalls that were issued during that sub-round */
 
@@ -497,11 +522,14 @@ void SIMIX_run()
        *   That would thus be a pure waste of time.
        */
 
-      unsigned int iter;
-      smx_actor_t process;
-      xbt_dynar_foreach(simix_global->process_that_ran, iter, process) {
-        if (process->simcall.call != SIMCALL_NONE) {
-          SIMIX_simcall_handle(&process->simcall, 0);
+      {
+        simgrid::kernel::profiler::Scope scope(simgrid::kernel::profiler::Phase::simcalls);
+        for (smx_actor_t process : simix_global->process_that_ran) {
+          if (process->simcall.call != SIMCALL_NONE) {
+            if (simgrid::kernel::profiler::enabled)
+              simgrid::kernel::profiler::count_simcall(process->simcall.call);
+            SIMIX_simcall_handle(&process->simcall, 0);
+          }
         }
       }
 
@@ -548,13 +576,24 @@ void SIMIX_run()
     /* Clean processes to destroy */
     SIMIX_process_empty_trash();
 
-    XBT_DEBUG("### time %f, #processes %zu, #to_run %lu", time, simix_global->process_list.size(),
-              xbt_dynar_length(simix_global->process_to_run));
+    if (simgrid::kernel::profiler::enabled)
+      simgrid::kernel::profiler::tick();
+    if (simgrid::kernel::progress::enabled)
+      simgrid::kernel::progress::tick(simix_timers->size());
+
+    /* Hand the control back to Engine::runUntil(). The next call to SIMIX_run() resumes from here. */
+    if (simix_global->stop_requested) {
+      simix_global->stop_requested = false;
+      return;
+    }
+
+    XBT_DEBUG("### time %f, #processes %zu, #to_run %zu", time, simix_global->process_list.size(),
+              simix_global->process_to_run.size());
 
-    if (xbt_dynar_is_empty(simix_global->process_to_run) && not simix_global->process_list.empty())
+    if (simix_global->process_to_run.empty() && not simix_global->process_list.empty())
       simgrid::simix::onDeadlock();
 
-  } while (time > -1.0 || not xbt_dynar_is_empty(simix_global->process_to_run));
+  } while (time > -1.0 || not simix_global->process_to_run.empty());
 
   if (simix_global->process_list.size() != 0) {
 
@@ -564,6 +603,9 @@ void SIMIX_run()
     SIMIX_display_process_status();
     xbt_abort();
   }
+  if (simgrid::kernel::progress::enabled)
+    simgrid::kernel::progress::report(simix_timers->size());
+  simgrid::kernel::partition::report();
   simgrid::s4u::onSimulationEnd();
 }
 
@@ -579,20 +621,20 @@ void SIMIX_run()
 smx_timer_t SIMIX_timer_set(double date, void (*callback)(void*), void *arg)
 {
   smx_timer_t timer = new s_smx_timer_t(date, [=](){ callback(arg); });
-  xbt_heap_push(simix_timers, timer, date);
+  simix_timers->push(timer);
   return timer;
 }
 
 smx_timer_t SIMIX_timer_set(double date, simgrid::xbt::Task<void()> callback)
 {
   smx_timer_t timer = new s_smx_timer_t(date, std::move(callback));
-  xbt_heap_push(simix_timers, timer, date);
+  simix_timers->push(timer);
   return timer;
 }
 
-/** @brief cancels a timer that was added earlier */
+/** @brief cancels a timer that was added earlier (the timer is freed) */
 void SIMIX_timer_remove(smx_timer_t timer) {
-  xbt_heap_rm_elm(simix_timers, timer, timer->date);
+  simix_timers->remove(timer);
 }
 
 /** @brief Returns the date at which the timer will trigger (or 0 if nullptr timer) */
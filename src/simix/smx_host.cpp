@@ -128,8 +128,7 @@ void SIMIX_host_add_auto_restart_process(
   arg->properties = properties;
   arg->auto_restart = auto_restart;
 
-  if (host->isOff() && not xbt_dict_get_or_null(watched_hosts_lib, host->cname())) {
-    xbt_dict_set(watched_hosts_lib, host->cname(), host, nullptr);
+  if (host->isOff() && watched_hosts_lib.emplace(simgrid::xbt::InternedString(host->cname()), host).second) {
     XBT_DEBUG("Push host %s to watched_hosts_lib because state == SURF_RESOURCE_OFF", host->cname());
   }
   host->extension<simgrid::simix::Host>()->auto_restart_processes.push_back(arg);
@@ -4,9 +4,11 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include <algorithm>
+#include <unordered_map>
 
 #include <boost/range/algorithm.hpp>
 
+#include "src/kernel/activity/ActivitySetImpl.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
 #include <xbt/ex.hpp>
 
@@ -28,9 +30,36 @@ static void SIMIX_waitany_remove_simcall_from_actions(smx_simcall_t simcall);
 static void SIMIX_comm_copy_data(smx_activity_t comm);
 static void SIMIX_comm_start(smx_activity_t synchro);
 static simgrid::kernel::activity::CommImpl*
-_find_matching_comm(boost::circular_buffer_space_optimized<smx_activity_t>* deque, e_smx_comm_type_t type,
-                    int (*match_fun)(void*, void*, smx_activity_t), void* user_data, smx_activity_t my_synchro,
-                    bool remove_matching);
+_find_matching_comm(simgrid::kernel::activity::CommQueue* queue, e_smx_comm_type_t type,
+                    int (*match_fun)(void*, void*, smx_activity_t), void* user_data,
+                    simgrid::kernel::activity::CommImpl* my_synchro, bool remove_matching);
+
+typedef int (*smx_match_fun_t)(void*, void*, smx_activity_t);
+static std::unordered_map<smx_match_fun_t, bool (*)(void*, uint64_t*)> match_key_functions;
+
+/** @brief Declares how to compute the match key of the user data of the comms filtered by a given match function
+ *
+ *  The key function returns false when the data has no key (typically because it accepts several partners). The keys
+ *  of all the match functions live in the same space: when two comms both have a key, they can only match each other
+ *  if their keys are equal. The mailboxes rely on this to only test the comms that have the same key or no key at all.
+ */
+void SIMIX_comm_set_match_key_function(int (*match_fun)(void*, void*, smx_activity_t),
+                                       bool (*key_fun)(void* data, uint64_t* key))
+{
+  xbt_assert(match_fun, "Cannot set the match key of comms without match function");
+  match_key_functions[match_fun] = key_fun;
+}
+
+static void SIMIX_comm_set_match_key(simgrid::kernel::activity::CommImpl* comm,
+                                     int (*match_fun)(void*, void*, smx_activity_t), void* data)
+{
+  comm->has_match_key = false;
+  if (match_fun == nullptr)
+    return;
+  auto key_fun = match_key_functions.find(match_fun);
+  if (key_fun != match_key_functions.end())
+    comm->has_match_key = key_fun->second(data, &comm->match_key);
+}
 
 /**
  *  \brief Checks if there is a communication activity queued in a deque matching our needs
@@ -38,39 +67,34 @@ _find_matching_comm(boost::circular_buffer_space_optimized<smx_activity_t>* dequ
  *  \return The communication activity if found, nullptr otherwise
  */
 static simgrid::kernel::activity::CommImpl*
-_find_matching_comm(boost::circular_buffer_space_optimized<smx_activity_t>* deque, e_smx_comm_type_t type,
-                    int (*match_fun)(void*, void*, smx_activity_t), void* this_user_data, smx_activity_t my_synchro,
-                    bool remove_matching)
+_find_matching_comm(simgrid::kernel::activity::CommQueue* queue, e_smx_comm_type_t type,
+                    int (*match_fun)(void*, void*, smx_activity_t), void* this_user_data,
+                    simgrid::kernel::activity::CommImpl* my_synchro, bool remove_matching)
 {
-  void* other_user_data = nullptr;
-
-  for(auto it = deque->begin(); it != deque->end(); it++){
-    smx_activity_t synchro = *it;
-    simgrid::kernel::activity::CommImpl* comm = static_cast<simgrid::kernel::activity::CommImpl*>(synchro);
+  simgrid::kernel::activity::CommImpl* comm =
+      queue->find(type, my_synchro, [match_fun, this_user_data, my_synchro](simgrid::kernel::activity::CommImpl* comm) {
+        void* other_user_data = comm->type == SIMIX_COMM_SEND ? comm->src_data : comm->dst_data;
+        if ((match_fun == nullptr || match_fun(this_user_data, other_user_data, comm)) &&
+            (not comm->match_fun || comm->match_fun(other_user_data, this_user_data, my_synchro)))
+          return true;
+        XBT_DEBUG("Sorry, communication synchro %p does not match our needs (the filtering didn't match)", comm);
+        return false;
+      });
+
+  if (comm == nullptr) {
+    XBT_DEBUG("No matching communication synchro found");
+    return nullptr;
+  }
 
-    if (comm->type == SIMIX_COMM_SEND) {
-      other_user_data = comm->src_data;
-    } else if (comm->type == SIMIX_COMM_RECEIVE) {
-      other_user_data = comm->dst_data;
-    }
-    if (comm->type == type && (match_fun == nullptr || match_fun(this_user_data, other_user_data, synchro)) &&
-        (not comm->match_fun || comm->match_fun(other_user_data, this_user_data, my_synchro))) {
-      XBT_DEBUG("Found a matching communication synchro %p", comm);
-      if (remove_matching)
-        deque->erase(it);
-      comm->ref();
+  XBT_DEBUG("Found a matching communication synchro %p", comm);
+  if (remove_matching)
+    queue->erase(comm);
+  comm->ref();
 #if SIMGRID_HAVE_MC
-      comm->mbox_cpy = comm->mbox;
+  comm->mbox_cpy = comm->mbox;
 #endif
-      comm->mbox = nullptr;
-      return comm;
-    }
-    XBT_DEBUG("Sorry, communication synchro %p does not match our needs:"
-              " its type is %d but we are looking for a comm of type %d (or maybe the filtering didn't match)",
-              comm, (int)comm->type, (int)type);
-  }
-  XBT_DEBUG("No matching communication synchro found");
-  return nullptr;
+  comm->mbox = nullptr;
+  return comm;
 }
 
 /******************************************************************************/
@@ -95,11 +119,22 @@ XBT_PRIVATE smx_activity_t simcall_HANDLER_comm_isend(smx_simcall_t simcall, smx
                                   void (*clean_fun)(void *), // used to free the synchro in case of problem after a detached send
                                   void (*copy_data_fun)(smx_activity_t, void*, size_t),// used to copy data if not default one
                           void *data, int detached)
+{
+  return SIMIX_comm_isend(src_proc, mbox, task_size, rate, src_buff, src_buff_size, match_fun, clean_fun, copy_data_fun,
+                          data, detached);
+}
+
+smx_activity_t SIMIX_comm_isend(smx_actor_t src_proc, smx_mailbox_t mbox, double task_size, double rate,
+                                void* src_buff, size_t src_buff_size, int (*match_fun)(void*, void*, smx_activity_t),
+                                void (*clean_fun)(void*), // used to free the synchro in case of problem after a detached send
+                                void (*copy_data_fun)(smx_activity_t, void*, size_t), // used to copy data if not default one
+                                void* data, int detached)
 {
   XBT_DEBUG("send from %p", mbox);
 
   /* Prepare a synchro describing us, so that it gets passed to the user-provided filter of other side */
   simgrid::kernel::activity::CommImpl* this_comm = new simgrid::kernel::activity::CommImpl(SIMIX_COMM_SEND);
+  SIMIX_comm_set_match_key(this_comm, match_fun, data);
 
   /* Look for communication synchro matching our needs. We also provide a description of
    * ourself so that the other side also gets a chance of choosing if it wants to match with us.
@@ -186,6 +221,7 @@ smx_activity_t SIMIX_comm_irecv(smx_actor_t dst_proc, smx_mailbox_t mbox, void *
     void *data, double rate)
 {
   simgrid::kernel::activity::CommImpl* this_synchro = new simgrid::kernel::activity::CommImpl(SIMIX_COMM_RECEIVE);
+  SIMIX_comm_set_match_key(this_synchro, match_fun, data);
   XBT_DEBUG("recv from %p %p. this_synchro=%p", mbox, &mbox->comm_queue, this_synchro);
 
   simgrid::kernel::activity::CommImpl* other_comm;
@@ -280,7 +316,8 @@ smx_activity_t SIMIX_comm_iprobe(smx_actor_t dst_proc, smx_mailbox_t mbox, int t
   } else{
     this_comm = new simgrid::kernel::activity::CommImpl(SIMIX_COMM_RECEIVE);
     smx_type = SIMIX_COMM_SEND;
-  } 
+  }
+  SIMIX_comm_set_match_key(this_comm, match_fun, data);
   smx_activity_t other_synchro=nullptr;
   if (mbox->permanent_receiver != nullptr && not mbox->done_comm_queue.empty()) {
     XBT_DEBUG("first check in the permanent recv mailbox, to see if we already got something");
@@ -442,6 +479,11 @@ void simcall_HANDLER_comm_waitany(smx_simcall_t simcall, xbt_dynar_t synchros, d
   }
 }
 
+void simcall_HANDLER_activity_set_waitany(smx_simcall_t simcall, smx_activity_set_t set, double timeout)
+{
+  set->wait_any(simcall, timeout);
+}
+
 void SIMIX_waitany_remove_simcall_from_actions(smx_simcall_t simcall)
 {
   smx_activity_t synchro;
@@ -10,11 +10,17 @@
 #include "src/kernel/activity/MailboxImpl.hpp"
 #include "src/simix/ActorImpl.hpp"
 
+XBT_PRIVATE smx_activity_t SIMIX_comm_isend(smx_actor_t src_proc, smx_mailbox_t mbox, double task_size, double rate,
+                              void* src_buff, size_t src_buff_size,
+                              int (*match_fun)(void*, void*, smx_activity_t), void (*clean_fun)(void*),
+                              void (*copy_data_fun)(smx_activity_t, void*, size_t), void* data, int detached);
 XBT_PRIVATE smx_activity_t SIMIX_comm_irecv(smx_actor_t dst_proc, smx_mailbox_t mbox,
                               void *dst_buff, size_t *dst_buff_size,
                               int (*match_fun)(void *, void *, smx_activity_t),
                               void (*copy_data_fun)(smx_activity_t, void*, size_t),
                               void *data, double rate);
+XBT_PRIVATE void SIMIX_comm_set_match_key_function(int (*match_fun)(void*, void*, smx_activity_t),
+                                                   bool (*key_fun)(void* data, uint64_t* key));
 XBT_PRIVATE smx_activity_t SIMIX_comm_iprobe(smx_actor_t dst_proc, smx_mailbox_t mbox, int type, int src,
                               int tag, int (*match_fun)(void *, void *, smx_activity_t), void *data);
 
@@ -10,6 +10,7 @@
 #include "src/kernel/context/Context.hpp"
 
 #include <map>
+#include <vector>
 
 /********************************** Simix Global ******************************/
 
@@ -19,8 +20,9 @@ namespace simix {
 class Global {
 public:
   smx_context_factory_t context_factory = nullptr;
-  xbt_dynar_t process_to_run = nullptr;
-  xbt_dynar_t process_that_ran = nullptr;
+  /* Swapped at each scheduling round, so that their capacity is reused instead of reallocated */
+  std::vector<smx_actor_t> process_to_run;
+  std::vector<smx_actor_t> process_that_ran;
   std::map<aid_t, smx_actor_t> process_list;
 #if SIMGRID_HAVE_MC
   /* MCer cannot read the std::map above in the remote process, so we copy the info it needs in a dynar.
@@ -51,8 +53,20 @@ public:
   std::vector<simgrid::xbt::Task<void()>> tasksTemp;
 
   std::vector<simgrid::simix::ActorImpl*> daemons;
+
+  /* Set by the timer of s4u::Engine::runUntil(), to stop SIMIX_run() */
+  bool stop_requested = false;
 };
 
+/* Element accessor of process_to_run for the parmaps. The vector may grow (and move) while the actors run. */
+inline void* process_to_run_at(void* processes, unsigned long i)
+{
+  std::vector<smx_actor_t>* vector = static_cast<std::vector<smx_actor_t>*>(processes);
+  return i < vector->size() ? (*vector)[i] : nullptr;
+}
+
+XBT_PRIVATE void deploy_actor(sg_host_t host, std::string name, ActorCode code, double start_time, double kill_time,
+                              bool auto_restart, xbt_dict_t properties);
 }
 }
 
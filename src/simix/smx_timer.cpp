@@ -0,0 +1,213 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <algorithm>
+
+#include <xbt/log.h>
+
+#include "src/simix/smx_timer_private.h"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(simix_timer, simix, "Logging specific to SIMIX (timers)");
+
+namespace simgrid {
+namespace simix {
+
+constexpr int TimerQueue::near;
+constexpr int TimerQueue::far;
+
+TimerQueue::TimerQueue(double tick_length) : ticks_per_second_(1.0 / tick_length)
+{
+  xbt_assert(tick_length > 0, "The ticks of the timer wheel must have a positive length");
+}
+
+TimerQueue::~TimerQueue()
+{
+  for (auto& level : wheel_)
+    for (smx_timer_t timer : level)
+      while (timer) {
+        smx_timer_t next = timer->next_in_slot;
+        delete timer;
+        timer = next;
+      }
+  for (smx_timer_t timer : near_)
+    delete timer;
+  for (smx_timer_t timer : far_)
+    delete timer;
+}
+
+uint64_t TimerQueue::tick_of(double date) const
+{
+  double tick = date * ticks_per_second_;
+  if (not(tick > 0)) // also catches NaN
+    return 0;
+  if (tick >= 9.2e18) // far beyond any wheel span, but still ordered by date in the far heap
+    return UINT64_MAX;
+  return static_cast<uint64_t>(tick);
+}
+
+void TimerQueue::heap_push(Heap& heap, smx_timer_t timer)
+{
+  heap.push_back(timer);
+  std::push_heap(heap.begin(), heap.end(), HeapOrder());
+}
+
+smx_timer_t TimerQueue::heap_pop(Heap& heap)
+{
+  std::pop_heap(heap.begin(), heap.end(), HeapOrder());
+  smx_timer_t timer = heap.back();
+  heap.pop_back();
+  return timer;
+}
+
+/** Links the timer in the slot of the given wheel level that contains its tick */
+void TimerQueue::link(smx_timer_t timer, int level)
+{
+  smx_timer_t& head     = wheel_[level][(timer->tick >> (slot_bits * level)) & (slots - 1)];
+  timer->level        = level;
+  timer->prev_in_slot = nullptr;
+  timer->next_in_slot = head;
+  if (head)
+    head->prev_in_slot = timer;
+  head = timer;
+}
+
+void TimerQueue::unlink(smx_timer_t timer)
+{
+  if (timer->prev_in_slot)
+    timer->prev_in_slot->next_in_slot = timer->next_in_slot;
+  else
+    wheel_[timer->level][(timer->tick >> (slot_bits * timer->level)) & (slots - 1)] = timer->next_in_slot;
+  if (timer->next_in_slot)
+    timer->next_in_slot->prev_in_slot = timer->prev_in_slot;
+  timer->prev_in_slot = nullptr;
+  timer->next_in_slot = nullptr;
+}
+
+/** Puts the timer in the near heap, in the wheel or in the far heap, according to its tick */
+void TimerQueue::place(smx_timer_t timer)
+{
+  if (timer->tick <= now_) {
+    timer->level = near;
+    heap_push(near_, timer);
+    return;
+  }
+  /* Lowest level whose slots of the current block can hold both now_ and the timer */
+  for (int level = 0; level < levels; level++) {
+    int block_shift = slot_bits * (level + 1);
+    if ((timer->tick >> block_shift) == (now_ >> block_shift)) {
+      link(timer, level);
+      return;
+    }
+  }
+  timer->level = far;
+  heap_push(far_, timer);
+}
+
+void TimerQueue::push(smx_timer_t timer)
+{
+  timer->tick      = tick_of(timer->date);
+  timer->seq       = next_seq_++;
+  timer->cancelled = false;
+  place(timer);
+  size_++;
+}
+
+void TimerQueue::remove(smx_timer_t timer)
+{
+  xbt_assert(not timer->cancelled, "Timer %p removed twice", timer);
+  size_--;
+  if (timer->level >= 0) {
+    unlink(timer);
+    delete timer;
+    return;
+  }
+  timer->cancelled = true;
+  if (timer->level == far && ++far_cancelled_ > 1024 && far_cancelled_ > far_.size() / 2)
+    purge_far();
+}
+
+/** Deletes the cancelled timers of the far heap, that may otherwise stay there for a long time */
+void TimerQueue::purge_far()
+{
+  auto end = std::partition(far_.begin(), far_.end(), [](smx_timer_t timer) { return not timer->cancelled; });
+  std::for_each(end, far_.end(), [](smx_timer_t timer) { delete timer; });
+  far_.erase(end, far_.end());
+  std::make_heap(far_.begin(), far_.end(), HeapOrder());
+  far_cancelled_ = 0;
+}
+
+/** Moves the wheel to its next non-empty slot, and spreads the timers of that slot on the lower levels */
+void TimerQueue::advance()
+{
+  for (int level = 0; level < levels; level++) {
+    int shift       = slot_bits * level;
+    int block_shift = shift + slot_bits;
+    for (uint64_t pos = ((now_ >> shift) & (slots - 1)) + 1; pos < slots; pos++) {
+      smx_timer_t timer = wheel_[level][pos];
+      if (timer == nullptr)
+        continue;
+      /* All the slots before that one are empty, at all levels */
+      now_ = ((now_ >> block_shift) << block_shift) | (pos << shift);
+      wheel_[level][pos] = nullptr;
+      XBT_DEBUG("Jump to tick %llu, cascading slot %d of level %d", (unsigned long long)now_, (int)pos, level);
+      while (timer) {
+        smx_timer_t next    = timer->next_in_slot;
+        timer->prev_in_slot = nullptr;
+        timer->next_in_slot = nullptr;
+        place(timer);
+        timer = next;
+      }
+      return;
+    }
+  }
+
+  /* The wheel is empty: jump to the block of the first far timer */
+  while (not far_.empty() && far_.front()->cancelled) {
+    delete heap_pop(far_);
+    far_cancelled_--;
+  }
+  xbt_assert(not far_.empty(), "Cannot advance an empty timer wheel");
+  now_ = far_.front()->tick;
+  XBT_DEBUG("Jump to tick %llu, getting the far timers", (unsigned long long)now_);
+  int top_shift = slot_bits * levels;
+  while (not far_.empty() && (far_.front()->tick >> top_shift) == (now_ >> top_shift)) {
+    smx_timer_t timer = heap_pop(far_);
+    if (timer->cancelled) {
+      far_cancelled_--;
+      delete timer;
+    } else {
+      place(timer);
+    }
+  }
+}
+
+/** Ensures that the top of the near heap is the next timer. Returns false if there is no timer at all */
+bool TimerQueue::fill_near()
+{
+  while (true) {
+    while (not near_.empty() && near_.front()->cancelled)
+      delete heap_pop(near_);
+    if (not near_.empty())
+      return true;
+    if (size_ == 0)
+      return false;
+    advance();
+  }
+}
+
+double TimerQueue::next_date()
+{
+  return fill_near() ? near_.front()->date : -1.0;
+}
+
+smx_timer_t TimerQueue::pop()
+{
+  if (not fill_near())
+    xbt_die("Cannot pop a timer out of an empty queue");
+  size_--;
+  return heap_pop(near_);
+}
+}
+}
@@ -0,0 +1,101 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMIX_TIMER_PRIVATE_H
+#define SIMIX_TIMER_PRIVATE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <xbt/base.h>
+#include <xbt/functional.hpp>
+
+#include "simgrid/simix.h"
+
+/** @brief Timer datatype */
+typedef struct s_smx_timer {
+  double date = 0.0;
+  simgrid::xbt::Task<void()> callback;
+
+  s_smx_timer()=default;
+  s_smx_timer(double date, simgrid::xbt::Task<void()> callback) : date(date), callback(std::move(callback)) {}
+
+  /* Position in the TimerQueue */
+  uint64_t tick           = 0;       /* date, in wheel ticks */
+  unsigned long long seq  = 0;       /* insertion order, to break the ties between timers of the same date */
+  int level               = 0;       /* wheel level, or TimerQueue::near / TimerQueue::far when in a heap */
+  bool cancelled          = false;   /* removed while in a heap, deleted when it reaches the top */
+  s_smx_timer* prev_in_slot = nullptr;
+  s_smx_timer* next_in_slot = nullptr;
+} s_smx_timer_t;
+
+namespace simgrid {
+namespace simix {
+
+/** @brief The pending SIMIX timers, in a hierarchical timing wheel over the simulated time
+ *
+ *  Simulated time is cut in ticks of fixed length. Each level of the wheel has `slots` slots, and a slot of level l
+ *  spans `slots^l` ticks. A timer is linked into the slot of the lowest level that contains both its tick and the
+ *  current tick of the wheel, so inserting and cancelling it are O(1). The timers that do not fit in the wheel (too
+ *  far in the future) wait in a heap, and so do the timers of the current tick (the "near" heap), so that they fire
+ *  exactly in date order. When the near heap is empty, the wheel jumps to its next non-empty slot and spreads its
+ *  timers on the lower levels, down to the near heap.
+ *
+ *  The timers removed while in a heap are only marked, and deleted when they reach the top.
+ */
+class XBT_PRIVATE TimerQueue {
+public:
+  static constexpr int near = -1;
+  static constexpr int far  = -2;
+
+  explicit TimerQueue(double tick_length = 1.0 / 1024);
+  ~TimerQueue();
+  TimerQueue(const TimerQueue&) = delete;
+  TimerQueue& operator=(const TimerQueue&) = delete;
+
+  void push(smx_timer_t timer);
+  void remove(smx_timer_t timer);
+  /** Returns the date of the next timer, or -1 if there is none */
+  double next_date();
+  /** Removes the next timer from the queue (which must not be empty), and returns it */
+  smx_timer_t pop();
+  size_t size() const { return size_; }
+
+private:
+  static constexpr int slot_bits = 6;
+  static constexpr int slots     = 1 << slot_bits;
+  static constexpr int levels    = 4;
+
+  struct HeapOrder {
+    bool operator()(smx_timer_t a, smx_timer_t b) const
+    {
+      return a->date > b->date || (a->date == b->date && a->seq > b->seq);
+    }
+  };
+  typedef std::vector<smx_timer_t> Heap;
+
+  uint64_t tick_of(double date) const;
+  void place(smx_timer_t timer);
+  void link(smx_timer_t timer, int level);
+  void unlink(smx_timer_t timer);
+  void advance();
+  bool fill_near();
+  void heap_push(Heap& heap, smx_timer_t timer);
+  smx_timer_t heap_pop(Heap& heap);
+  void purge_far();
+
+  double ticks_per_second_;
+  uint64_t now_ = 0; /* Current tick of the wheel: all the timers of the wheel are strictly after it */
+  smx_timer_t wheel_[levels][slots] = {};
+  Heap near_;
+  Heap far_;
+  size_t far_cancelled_         = 0;
+  size_t size_                  = 0;
+  unsigned long long next_seq_ = 0;
+};
+}
+}
+
+#endif
@@ -10,6 +10,7 @@
 #include "src/mc/mc_replay.h"
 #include "src/smpi/smpi_process.hpp"
 #include "src/smpi/smpi_comm.hpp"
+#include "xbt/config.hpp"
 
 #ifndef WIN32
 #include <sys/mman.h>
@@ -32,6 +33,13 @@ shared_malloc_type smpi_cfg_shared_malloc = shmalloc_global;
 double smpi_total_benched_time = 0;
 smpi_privatisation_region_t smpi_privatisation_regions;
 
+/* Read around each MPI call */
+#if HAVE_PAPI
+static simgrid::config::Handle<std::string> smpi_papi_events("smpi/papi-events");
+#endif
+static simgrid::config::Handle<std::string> smpi_comp_adjustment_file("smpi/comp-adjustment-file");
+static simgrid::config::Handle<bool> smpi_simulate_computation("smpi/simulate-computation");
+
 void smpi_bench_destroy()
 {
   xbt_dict_free(&samples);
@@ -95,7 +103,7 @@ void smpi_bench_begin()
     return;
 
 #if HAVE_PAPI
-  if (xbt_cfg_get_string("smpi/papi-events")[0] != '\0') {
+  if (not smpi_papi_events.get().empty()) {
     int event_set = smpi_process()->papi_event_set();
     // PAPI_start sets everything to 0! See man(3) PAPI_start
     if (PAPI_LOW_LEVEL_INITED == PAPI_is_initialized()) {
@@ -124,7 +132,7 @@ void smpi_bench_end()
    * An MPI function has been called and now is the right time to update
    * our PAPI counters for this process.
    */
-  if (xbt_cfg_get_string("smpi/papi-events")[0] != '\0') {
+  if (not smpi_papi_events.get().empty()) {
     papi_counter_t& counter_data        = smpi_process()->papi_counters();
     int event_set                       = smpi_process()->papi_event_set();
     std::vector<long long> event_values = std::vector<long long>(counter_data.size());
@@ -149,7 +157,7 @@ void smpi_bench_end()
     xbt_die("Aborting.");
   }
 
-  if (xbt_cfg_get_string("smpi/comp-adjustment-file")[0] != '\0') { // Maybe we need to artificially speed up or slow
+  if (not smpi_comp_adjustment_file.get().empty()) { // Maybe we need to artificially speed up or slow
     // down our computation based on our statistical analysis.
 
     smpi_trace_call_location_t* loc                            = smpi_process()->call_location();
@@ -161,12 +169,12 @@ void smpi_bench_end()
   }
 
   // Simulate the benchmarked computation unless disabled via command-line argument
-  if (xbt_cfg_get_boolean("smpi/simulate-computation")) {
+  if (smpi_simulate_computation) {
     smpi_execute(xbt_os_timer_elapsed(timer)/speedup);
   }
 
 #if HAVE_PAPI
-  if (xbt_cfg_get_string("smpi/papi-events")[0] != '\0' && TRACE_smpi_is_enabled()) {
+  if (not smpi_papi_events.get().empty() && TRACE_smpi_is_enabled()) {
     char container_name[INSTR_DEFAULT_STR_SIZE];
     smpi_container(smpi_process()->index(), container_name, INSTR_DEFAULT_STR_SIZE);
     container_t container        = PJ_container_get(container_name);
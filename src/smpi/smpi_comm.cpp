@@ -480,25 +480,22 @@ MPI_Comm Comm::f2c(int id) {
   } else if(id==0){
     return MPI_COMM_WORLD;
   } else if(F2C::f2c_lookup() != nullptr && id >= 0) {
-      char key[KEY_SIZE];
-      MPI_Comm tmp =  static_cast<MPI_Comm>(xbt_dict_get_or_null(F2C::f2c_lookup(),get_key_id(key, id)));
-      return tmp != nullptr ? tmp : MPI_COMM_NULL ;
+      auto tmp = F2C::f2c_lookup()->find(get_key_id(id));
+      return tmp != F2C::f2c_lookup()->end() ? static_cast<MPI_Comm>(tmp->second) : MPI_COMM_NULL ;
   } else {
     return MPI_COMM_NULL;
   }
 }
 
 void Comm::free_f(int id) {
-  char key[KEY_SIZE];
-  xbt_dict_remove(F2C::f2c_lookup(), id==0? get_key(key, id) : get_key_id(key, id));
+  F2C::f2c_lookup()->erase(id==0? get_key(id) : get_key_id(id));
 }
 
 int Comm::add_f() {
   if(F2C::f2c_lookup()==nullptr){
-    F2C::set_f2c_lookup(xbt_dict_new_homogeneous(nullptr));
+    F2C::set_f2c_lookup(new Lookup());
   }
-  char key[KEY_SIZE];
-  xbt_dict_set(F2C::f2c_lookup(), this==MPI_COMM_WORLD? get_key(key, F2C::f2c_id()) : get_key_id(key,F2C::f2c_id()), this, nullptr);
+  (*F2C::f2c_lookup())[this==MPI_COMM_WORLD? get_key(F2C::f2c_id()) : get_key_id(F2C::f2c_id())] = this;
   f2c_id_increment();
   return F2C::f2c_id()-1;
 }
@@ -8,6 +8,8 @@
 #include "src/smpi/private.h"
 #include "src/smpi/smpi_comm.hpp"
 #include "src/smpi/SmpiHost.hpp"
+#include "src/xbt/flat_map.hpp"
+#include "xbt/interned_string.hpp"
 
 namespace simgrid {
 namespace smpi {
@@ -35,7 +37,7 @@ public:
 }
 }
 namespace s4u {
-extern std::map<std::string, simgrid::s4u::Host*> host_list;
+extern simgrid::xbt::FlatMap<simgrid::xbt::InternedString, simgrid::s4u::Host*> host_list;
 }
 }
 
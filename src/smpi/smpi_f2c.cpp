@@ -7,20 +7,18 @@
 #include "src/smpi/smpi_f2c.hpp"
 #include "src/smpi/smpi_process.hpp"
 
-#include <cstdio>
-
 namespace simgrid{
 namespace smpi{
 
-xbt_dict_t F2C::f2c_lookup_=nullptr;
+F2C::Lookup* F2C::f2c_lookup_=nullptr;
 int F2C::f2c_id_=0;
 
-xbt_dict_t F2C::f2c_lookup(){
+F2C::Lookup* F2C::f2c_lookup(){
   return f2c_lookup_;
 }
 
-void F2C::set_f2c_lookup(xbt_dict_t dict){
-  f2c_lookup_=dict;
+void F2C::set_f2c_lookup(Lookup* lookup){
+  f2c_lookup_=lookup;
 }
 
 void F2C::f2c_id_increment(){
@@ -31,58 +29,54 @@ int F2C::f2c_id(){
   return f2c_id_;
 };
 
-char* F2C::get_key(char* key, int id) {
-  std::snprintf(key, KEY_SIZE, "%x",id);
-  return key;
+uint64_t F2C::get_key(int id) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(id)) << 32;
 }
 
-char* F2C::get_key_id(char* key, int id) {
-  std::snprintf(key, KEY_SIZE, "%x_%d",id, smpi_process()->index());
-  return key;
+uint64_t F2C::get_key_id(int id) {
+  return get_key(id) | static_cast<uint32_t>(smpi_process()->index() + 1);
 }
 
 void F2C::delete_lookup(){
-  xbt_dict_free(&f2c_lookup_);
+  delete f2c_lookup_;
+  f2c_lookup_ = nullptr;
 }
 
-xbt_dict_t F2C::lookup(){
+F2C::Lookup* F2C::lookup(){
   return f2c_lookup_;
 }
 
 void F2C::free_f(int id){
-  char key[KEY_SIZE];
-  xbt_dict_remove(f2c_lookup_, get_key(key, id));
+  f2c_lookup_->erase(get_key(id));
 }
 
 int F2C::add_f(){
   if(f2c_lookup_==nullptr){
-    f2c_lookup_=xbt_dict_new_homogeneous(nullptr);
+    f2c_lookup_=new Lookup();
   }
-  char key[KEY_SIZE];
-  xbt_dict_set(f2c_lookup_, get_key(key, f2c_id_), this, nullptr);
+  (*f2c_lookup_)[get_key(f2c_id_)] = this;
   f2c_id_increment();
   return f2c_id_-1;
 }
 
 int F2C::c2f(){
   if(f2c_lookup_==nullptr){
-    f2c_lookup_=xbt_dict_new_homogeneous(nullptr);
+    f2c_lookup_=new Lookup();
   }
 
-  char* existing_key = xbt_dict_get_key(f2c_lookup_, this);
-  if(existing_key!=nullptr){
-    return atoi(existing_key);}
-  else{
-    return this->add_f();}
+  for (auto const& elm : *f2c_lookup_)
+    if (elm.second == this)
+      return static_cast<int>(elm.first >> 32);
+  return this->add_f();
 }
 
 F2C* F2C::f2c(int id){
   if(f2c_lookup_==nullptr){
-    f2c_lookup_=xbt_dict_new_homogeneous(nullptr);
+    f2c_lookup_=new Lookup();
   }
-  char key[KEY_SIZE];
   if(id >= 0){
-    return static_cast<F2C*>(xbt_dict_get_or_null(f2c_lookup_, get_key(key, id)));
+    auto elm = f2c_lookup_->find(get_key(id));
+    return elm == f2c_lookup_->end() ? nullptr : elm->second;
   }else
     return NULL;
 }
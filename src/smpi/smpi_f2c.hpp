@@ -9,29 +9,32 @@
 #ifndef SMPI_F2C_HPP_INCLUDED
 #define SMPI_F2C_HPP_INCLUDED
 
-#include "xbt/dict.h"
+#include "src/xbt/flat_map.hpp"
 
-#define KEY_SIZE (sizeof(int) * 2 + 1)
+#include <cstdint>
 
 namespace simgrid{
 namespace smpi{
 
 class F2C {
+  public:
+    // The id is in the upper half of the key, and the lower half is 0 or 1 + the index of the owning process
+    using Lookup = simgrid::xbt::FlatMap<uint64_t, F2C*>;
   private:
     // We use a single lookup table for every type. 
     // Beware of collisions if id in mpif.h is not unique
-    static xbt_dict_t f2c_lookup_;
+    static Lookup* f2c_lookup_;
     static int f2c_id_;
   protected:
-    static xbt_dict_t f2c_lookup();
-    static void set_f2c_lookup(xbt_dict_t dict);
+    static Lookup* f2c_lookup();
+    static void set_f2c_lookup(Lookup* lookup);
     static int f2c_id();
     static void f2c_id_increment();
   public:
-    static char* get_key(char* key, int id);
-    static char* get_key_id(char* key, int id);
+    static uint64_t get_key(int id);
+    static uint64_t get_key_id(int id);
     static void delete_lookup();
-    static xbt_dict_t lookup();
+    static Lookup* lookup();
 
     //Override these to handle specific values.
     int add_f();
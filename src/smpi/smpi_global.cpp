@@ -7,6 +7,7 @@
 #include "simgrid/s4u/Mailbox.hpp"
 #include "simgrid/s4u/Host.hpp"
 #include "src/msg/msg_private.h"
+#include "src/simix/smx_network_private.h"
 #include "src/simix/smx_private.h"
 #include "src/surf/surf_interface.hpp"
 #include "src/smpi/SmpiHost.hpp"
@@ -17,6 +18,7 @@
 #include "src/smpi/smpi_group.hpp"
 #include "src/smpi/smpi_info.hpp"
 #include "src/smpi/smpi_process.hpp"
+#include "src/smpi/smpi_request.hpp"
 
 #include <dlfcn.h>
 #include <fcntl.h>
@@ -237,6 +239,9 @@ void smpi_global_init()
 {
   MPI_Group group;
 
+  SIMIX_comm_set_match_key_function(&simgrid::smpi::Request::match_send, &simgrid::smpi::Request::match_key);
+  SIMIX_comm_set_match_key_function(&simgrid::smpi::Request::match_recv, &simgrid::smpi::Request::match_key);
+
   if (not MC_is_active()) {
     global_timer = xbt_os_timer_new();
     xbt_os_walltimer_start(global_timer);
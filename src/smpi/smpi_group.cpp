@@ -18,14 +18,13 @@ Group::Group()
 {
   size_=0;                            /* size */
   rank_to_index_map_=nullptr;                         /* rank_to_index_map_ */
-  index_to_rank_map_=nullptr;                         /* index_to_rank_map_ */
   refcount_=1;                            /* refcount_: start > 0 so that this group never gets freed */
 }
 
 Group::Group(int n) : size_(n)
 {
   rank_to_index_map_ = xbt_new(int, size_);
-  index_to_rank_map_ = xbt_dict_new_homogeneous(xbt_free_f);
+  index_to_rank_map_.reserve(size_);
   refcount_ = 1;
   for (int i = 0; i < size_; i++) {
     rank_to_index_map_[i] = MPI_UNDEFINED;
@@ -39,42 +38,25 @@ Group::Group(MPI_Group origin)
     {
       size_ = origin->size();
       rank_to_index_map_ = xbt_new(int, size_);
-      index_to_rank_map_ = xbt_dict_new_homogeneous(xbt_free_f);
+      index_to_rank_map_ = origin->index_to_rank_map_;
       refcount_ = 1;
       for (int i = 0; i < size_; i++) {
         rank_to_index_map_[i] = origin->rank_to_index_map_[i];
       }
-
-      char* key;
-      char* ptr_rank;
-      xbt_dict_cursor_t cursor = nullptr;
-      xbt_dict_foreach(origin->index_to_rank_map_, cursor, key, ptr_rank) {
-        int * cp = static_cast<int*>(xbt_malloc(sizeof(int)));
-        *cp=*reinterpret_cast<int*>(ptr_rank);
-        xbt_dict_set(index_to_rank_map_, key, cp, nullptr);
-      }
     }
 }
 
 Group::~Group()
 {
   xbt_free(rank_to_index_map_);
-  xbt_dict_free(&index_to_rank_map_);
 }
 
 void Group::set_mapping(int index, int rank)
 {
-  int * val_rank;
-
   if (rank < size_) {
     rank_to_index_map_[rank] = index;
     if (index!=MPI_UNDEFINED ) {
-      val_rank = static_cast<int *>(xbt_malloc(sizeof(int)));
-      *val_rank = rank;
-
-      char * key = bprintf("%d", index);
-      xbt_dict_set(index_to_rank_map_, key, val_rank, nullptr);
-      xbt_free(key);
+      index_to_rank_map_[index] = rank;
     }
   }
 }
@@ -91,16 +73,12 @@ int Group::index(int rank)
 
 int Group::rank(int index)
 {
-  int * ptr_rank = nullptr;
   if (this==MPI_GROUP_EMPTY)
     return MPI_UNDEFINED;
-  char * key = bprintf("%d", index);
-  ptr_rank = static_cast<int*>(xbt_dict_get_or_null(index_to_rank_map_, key));
-  xbt_free(key);
-
-  if (ptr_rank==nullptr)
+  auto rank = index_to_rank_map_.find(index);
+  if (rank == index_to_rank_map_.end())
     return MPI_UNDEFINED;
-  return *ptr_rank;
+  return rank->second;
 }
 
 void Group::ref()
@@ -379,8 +357,8 @@ MPI_Group Group::f2c(int id) {
   if(id == -2) {
     return MPI_GROUP_EMPTY;
   } else if(F2C::f2c_lookup() != nullptr && id >= 0) {
-    char key[KEY_SIZE];
-    return static_cast<MPI_Group>(xbt_dict_get_or_null(F2C::f2c_lookup(), get_key(key, id)));
+    auto group = F2C::f2c_lookup()->find(get_key(id));
+    return group == F2C::f2c_lookup()->end() ? nullptr : static_cast<MPI_Group>(group->second);
   } else {
     return static_cast<MPI_Group>(MPI_GROUP_NULL);
   }
@@ -8,6 +8,7 @@
 #define SMPI_GROUP_HPP_INCLUDED
 
 #include "src/smpi/smpi_f2c.hpp"
+#include "src/xbt/flat_map.hpp"
 
 namespace simgrid{
 namespace smpi{
@@ -16,7 +17,7 @@ class Group : public F2C{
   private:
     int size_;
     int *rank_to_index_map_;
-    xbt_dict_t index_to_rank_map_;
+    simgrid::xbt::FlatMap<int, int> index_to_rank_map_;
     int refcount_;
   public:
     explicit Group();
@@ -10,6 +10,7 @@
 #include "src/smpi/smpi_group.hpp"
 #include "src/smpi/smpi_process.hpp"
 #include "src/smpi/smpi_request.hpp"
+#include "src/xbt/parse_number.hpp"
 #include "xbt/replay.hpp"
 
 #include <unordered_map>
@@ -80,9 +81,8 @@ void smpi_free_tmp_buffer(void* buf){
 /* Helper function */
 static double parse_double(const char *string)
 {
-  char *endptr;
-  double value = strtod(string, &endptr);
-  if (*endptr != '\0')
+  double value;
+  if (*simgrid::xbt::parse_double(string, &value) != '\0')
     THROWF(unknown_error, 0, "%s is not a double", string);
   return value;
 }
@@ -24,6 +24,12 @@ static simgrid::config::Flag<double> smpi_iprobe_sleep(
 static simgrid::config::Flag<double> smpi_test_sleep(
   "smpi/test", "Minimum time to inject inside a call to MPI_Test", 1e-4);
 
+/* Read at each message */
+static simgrid::config::Handle<int> smpi_async_small_thresh("smpi/async-small-thresh");
+static simgrid::config::Handle<int> smpi_send_is_detached_thresh("smpi/send-is-detached-thresh");
+static simgrid::config::Handle<bool> smpi_grow_injected_times("smpi/grow-injected-times");
+static simgrid::config::Handle<double> smpi_iprobe_cpu_usage("smpi/iprobe-cpu-usage");
+
 std::vector<s_smpi_factor_t> smpi_ois_values;
 
 extern void (*smpi_comm_copy_data_callback) (smx_activity_t, void*, size_t);
@@ -163,6 +169,17 @@ int Request::match_send(void* a, void* b,smx_activity_t ignored) {
     return 0;
 }
 
+/* Requests naming both their source and their tag only match the requests with the same (src, tag) pair, or with
+ * wildcards. This lets the mailboxes find their partner without testing all the posted requests. */
+bool Request::match_key(void* a, uint64_t* key)
+{
+  MPI_Request req = static_cast<MPI_Request>(a);
+  if (req->src_ == MPI_ANY_SOURCE || req->tag_ == MPI_ANY_TAG)
+    return false;
+  *key = (static_cast<uint64_t>(static_cast<uint32_t>(req->src_)) << 32) | static_cast<uint32_t>(req->tag_);
+  return true;
+}
+
 void Request::print_request(const char *message)
 {
   XBT_VERB("%s  request %p  [buf = %p, size = %zu, src = %d, dst = %d, tag = %d, flags = %x]",
@@ -331,7 +348,7 @@ void Request::start()
 
     simgrid::smpi::Process* process = smpi_process_remote(dst_);
 
-    int async_small_thresh = xbt_cfg_get_int("smpi/async-small-thresh");
+    int async_small_thresh = smpi_async_small_thresh;
 
     xbt_mutex_t mut = process->mailboxes_mutex();
     if (async_small_thresh != 0 || (flags_ & RMA) != 0)
@@ -391,7 +408,7 @@ void Request::start()
 
     void* buf = buf_;
     if ((flags_ & SSEND) == 0 && ( (flags_ & RMA) != 0
-        || static_cast<int>(size_) < xbt_cfg_get_int("smpi/send-is-detached-thresh") ) ) {
+        || static_cast<int>(size_) < smpi_send_is_detached_thresh ) ) {
       void *oldbuf = nullptr;
       detached_ = 1;
       XBT_DEBUG("Send request %p is detached", this);
@@ -426,7 +443,7 @@ void Request::start()
       XBT_DEBUG("sending size of %zu : sleep %f ", size_, sleeptime);
     }
 
-    int async_small_thresh = xbt_cfg_get_int("smpi/async-small-thresh");
+    int async_small_thresh = smpi_async_small_thresh;
 
     xbt_mutex_t mut=process->mailboxes_mutex();
 
@@ -509,7 +526,7 @@ int Request::test(MPI_Request * request, MPI_Status * status) {
       nsleeps=1;//reset the number of sleeps we will do next time
       if (*request != MPI_REQUEST_NULL && ((*request)->flags_ & PERSISTENT)==0)
       *request = MPI_REQUEST_NULL;
-    } else if (xbt_cfg_get_boolean("smpi/grow-injected-times")){
+    } else if (smpi_grow_injected_times){
       nsleeps++;
     }
   }
@@ -625,7 +642,7 @@ void Request::iprobe(int source, int tag, MPI_Comm comm, int* flag, MPI_Status*
   // This can speed up the execution of certain applications by an order of magnitude, such as HPL
   static int nsleeps = 1;
   double speed       = simgrid::s4u::Actor::self()->host()->speed();
-  double maxrate = xbt_cfg_get_double("smpi/iprobe-cpu-usage");
+  double maxrate = smpi_iprobe_cpu_usage;
   MPI_Request request = new Request(nullptr, 0, MPI_CHAR, source == MPI_ANY_SOURCE ? MPI_ANY_SOURCE :
                  comm->group()->index(source), comm->rank(), tag, comm, PERSISTENT | RECV);
   if (smpi_iprobe_sleep > 0) {
@@ -637,7 +654,7 @@ void Request::iprobe(int source, int tag, MPI_Comm comm, int* flag, MPI_Status*
 
   request->print_request("New iprobe");
   // We have to test both mailboxes as we don't know if we will receive one one or another
-  if (xbt_cfg_get_int("smpi/async-small-thresh") > 0){
+  if (smpi_async_small_thresh > 0){
       mailbox = smpi_process()->mailbox_small();
       XBT_DEBUG("Trying to probe the perm recv mailbox");
       request->action_ = simcall_comm_iprobe(mailbox, 0, request->src_, request->tag_, &match_recv,
@@ -666,7 +683,7 @@ void Request::iprobe(int source, int tag, MPI_Comm comm, int* flag, MPI_Status*
   }
   else {
     *flag = 0;
-    if (xbt_cfg_get_boolean("smpi/grow-injected-times"))
+    if (smpi_grow_injected_times)
       nsleeps++;
   }
   unref(&request);
@@ -895,26 +912,26 @@ int Request::waitsome(int incount, MPI_Request requests[], int *indices, MPI_Sta
 }
 
 MPI_Request Request::f2c(int id) {
-  char key[KEY_SIZE];
   if(id==MPI_FORTRAN_REQUEST_NULL)
     return static_cast<MPI_Request>(MPI_REQUEST_NULL);
-  return static_cast<MPI_Request>(xbt_dict_get(F2C::f2c_lookup(), get_key_id(key, id)));
+  auto request = F2C::f2c_lookup()->find(get_key_id(id));
+  if (request == F2C::f2c_lookup()->end())
+    xbt_die("Unknown Fortran request %d", id);
+  return static_cast<MPI_Request>(request->second);
 }
 
 int Request::add_f() {
   if(F2C::f2c_lookup()==nullptr){
-    F2C::set_f2c_lookup(xbt_dict_new_homogeneous(nullptr));
+    F2C::set_f2c_lookup(new Lookup());
   }
-  char key[KEY_SIZE];
-  xbt_dict_set(F2C::f2c_lookup(), get_key_id(key, F2C::f2c_id()), this, nullptr);
+  (*F2C::f2c_lookup())[get_key_id(F2C::f2c_id())] = this;
   F2C::f2c_id_increment();
   return F2C::f2c_id()-1;
 }
 
 void Request::free_f(int id) {
-  char key[KEY_SIZE];
   if(id!=MPI_FORTRAN_REQUEST_NULL)
-    xbt_dict_remove(F2C::f2c_lookup(), get_key_id(key, id));
+    F2C::f2c_lookup()->erase(get_key_id(id));
 }
 
 }
@@ -90,6 +90,7 @@ class Request : public F2C {
 
     static int match_send(void* a, void* b,smx_activity_t ignored);
     static int match_recv(void* a, void* b,smx_activity_t ignored);
+    static bool match_key(void* a, uint64_t* key);
 
     int add_f();
     static void free_f(int id);
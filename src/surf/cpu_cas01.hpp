@@ -6,6 +6,7 @@
 #include <xbt/base.h>
 
 #include "cpu_interface.hpp"
+#include "src/xbt/pool.hpp"
 
 /***********
  * Classes *
@@ -55,7 +56,7 @@ protected:
 /**********
  * Action *
  **********/
-class CpuCas01Action: public CpuAction {
+class CpuCas01Action : public CpuAction, public simgrid::xbt::PoolAllocated<CpuCas01Action> {
   friend CpuAction *CpuCas01::execution_start(double size);
   friend CpuAction *CpuCas01::sleep(double duration);
 public:
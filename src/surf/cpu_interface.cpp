@@ -6,6 +6,7 @@
 
 #include <xbt/dynar.h>
 #include "cpu_interface.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/instr/instr_private.h" // TRACE_is_enabled(). FIXME: remove by subscribing tracing to the surf signals
 
 XBT_LOG_EXTERNAL_CATEGORY(surf_kernel);
@@ -113,11 +114,17 @@ Cpu::Cpu(Model* model, simgrid::s4u::Host* host, lmm_constraint_t constraint, st
   for (double value : *speedPerPstate) {
     speedPerPstate_.push_back(value);
   }
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::platform,
+                                     sizeof(Cpu) + speedPerPstate_.capacity() * sizeof(double));
 
   xbt_assert(model == surf_cpu_model_pm || core==1, "Currently, VM cannot be multicore");
 }
 
-Cpu::~Cpu() = default;
+Cpu::~Cpu()
+{
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::platform,
+                                 sizeof(Cpu) + speedPerPstate_.capacity() * sizeof(double));
+}
 
 int Cpu::getNbPStates()
 {
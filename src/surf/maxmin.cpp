@@ -6,6 +6,7 @@
 /* \file callbacks.h */
 
 #include "maxmin_private.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "xbt/log.h"
 #include "xbt/mallocator.h"
 #include "xbt/sysdep.h"
@@ -178,12 +179,15 @@ static inline void lmm_variable_remove(lmm_system_t sys, lmm_variable_t var)
 
 static void lmm_var_free(lmm_system_t sys, lmm_variable_t var)
 {
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::lmm,
+                                 sizeof(s_lmm_variable_t) + var->cnsts_size * sizeof(s_lmm_element_t));
   lmm_variable_remove(sys, var);
   xbt_mallocator_release(sys->variable_mallocator, var);
 }
 
 static inline void lmm_cnst_free(lmm_system_t sys, lmm_constraint_t cnst)
 {
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::lmm, sizeof(s_lmm_constraint_t));
   make_constraint_inactive(sys, cnst);
   free(cnst);
 }
@@ -207,6 +211,7 @@ lmm_constraint_t lmm_constraint_new(lmm_system_t sys, void *id, double bound_val
   cnst->usage = 0;
   cnst->sharing_policy = 1; /* FIXME: don't hardcode the value */
   insert_constraint(sys, cnst);
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::lmm, sizeof(s_lmm_constraint_t));
 
   return cnst;
 }
@@ -300,6 +305,8 @@ lmm_variable_t lmm_variable_new(lmm_system_t sys, simgrid::surf::Action* id, dou
   }
   var->cnsts_size = number_of_constraints;
   var->cnsts_number = 0;
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::lmm,
+                                     sizeof(s_lmm_variable_t) + number_of_constraints * sizeof(s_lmm_element_t));
   var->weight = weight;
   var->staged_weight = 0.0;
   var->bound = bound;
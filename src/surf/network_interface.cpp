@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "network_interface.hpp"
+#include "src/kernel/MemoryAccounting.hpp"
 #include "simgrid/sg_config.h"
 
 #ifndef NETWORK_INTERFACE_CPP_
@@ -18,13 +19,17 @@ namespace simgrid {
   namespace surf {
 
   /* List of links */
-  std::unordered_map<std::string, LinkImpl*>* LinkImpl::links = new std::unordered_map<std::string, LinkImpl*>();
+  simgrid::xbt::FlatMap<simgrid::xbt::InternedString, LinkImpl*>* LinkImpl::links =
+      new simgrid::xbt::FlatMap<simgrid::xbt::InternedString, LinkImpl*>();
 
   LinkImpl* LinkImpl::byName(const char* name)
   {
-    if (links->find(name) == links->end())
+    /* A name that was never interned cannot be the one of a link */
+    simgrid::xbt::InternedString key = simgrid::xbt::InternedString::find(name);
+    if (not key)
       return nullptr;
-    return links->at(name);
+    auto link = links->find(key);
+    return link == links->end() ? nullptr : link->second;
   }
   /** @brief Returns the amount of links in the platform */
   int LinkImpl::linksCount()
@@ -36,7 +41,7 @@ namespace simgrid {
   {
     LinkImpl** res = xbt_new(LinkImpl*, (int)links->size());
     int i          = 0;
-    for (auto kv : *links) {
+    for (auto const& kv : *links) {
       res[i] = kv.second;
       i++;
     }
@@ -45,7 +50,7 @@ namespace simgrid {
   /** @brief destructor of the static data */
   void LinkImpl::linksExit()
   {
-    for (auto kv : *links)
+    for (auto const& kv : *links)
       (kv.second)->destroy();
     delete links;
   }
@@ -109,8 +114,9 @@ namespace simgrid {
       latency_.scale   = 1;
       bandwidth_.scale = 1;
 
-      links->insert({name, this});
+      links->emplace(internedName(), this);
       XBT_DEBUG("Create link '%s'",name);
+      simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::platform, sizeof(LinkImpl));
 
     }
 
@@ -118,6 +124,7 @@ namespace simgrid {
     LinkImpl::~LinkImpl()
     {
       xbt_assert(currentlyDestroying_, "Don't delete Links directly. Call destroy() instead.");
+      simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::platform, sizeof(LinkImpl));
     }
     /** @brief Fire the required callbacks and destroy the object
      *
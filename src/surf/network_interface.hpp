@@ -9,6 +9,7 @@
 #include "simgrid/s4u/Link.hpp"
 #include "src/surf/PropertyHolder.hpp"
 #include "src/surf/surf_interface.hpp"
+#include "src/xbt/flat_map.hpp"
 #include "xbt/base.h"
 #include <list>
 #include <unordered_map>
@@ -168,7 +169,7 @@ private:
   void* userData = nullptr;
 
   /* List of all links. FIXME: should move to the Engine */
-  static std::unordered_map<std::string, LinkImpl*>* links;
+  static simgrid::xbt::FlatMap<simgrid::xbt::InternedString, LinkImpl*>* links;
 
 public:
   static LinkImpl* byName(const char* name);
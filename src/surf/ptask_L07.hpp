@@ -8,6 +8,7 @@
 #include <vector>
 #include <xbt/base.h>
 #include "src/surf/HostImpl.hpp"
+#include "src/xbt/pool.hpp"
 
 #ifndef HOST_L07_HPP_
 #define HOST_L07_HPP_
@@ -96,7 +97,7 @@ public:
 /**********
  * Action *
  **********/
-class L07Action : public CpuAction {
+class L07Action : public CpuAction, public simgrid::xbt::PoolAllocated<L07Action> {
   friend Action *CpuL07::execution_start(double size);
   friend Action *CpuL07::sleep(double duration);
   friend Action *HostL07Model::executeParallelTask(int host_nb, sg_host_t*host_list,
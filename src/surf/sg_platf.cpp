@@ -40,13 +40,6 @@ simgrid::xbt::signal<void(sg_platf_cluster_cbarg_t)> on_cluster;
 }
 }
 
-// FIXME: The following duplicates the content of s4u::Host
-namespace simgrid {
-namespace s4u {
-extern std::map<std::string, simgrid::s4u::Host*> host_list;
-}
-}
-
 static int surf_parse_models_setup_already_called = 0;
 std::map<std::string, storage_type_t> storage_types;
 
@@ -445,8 +438,9 @@ void sg_platf_new_process(sg_platf_process_cbarg_t process)
     // The requested host does not exist. Do a nice message to the user
     std::string msg = std::string("Cannot create process '") + process->function + "': host '" + process->host +
                       "' does not exist\nExisting hosts: '";
-    for (auto kv : simgrid::s4u::host_list) {
-      simgrid::s4u::Host* host = kv.second;
+    std::vector<simgrid::s4u::Host*> hosts;
+    simgrid::s4u::Engine::instance()->hostList(&hosts);
+    for (auto host : hosts) {
       msg += host->name();
       msg += "', '";
       if (msg.length() > 1024) {
@@ -460,59 +454,11 @@ void sg_platf_new_process(sg_platf_process_cbarg_t process)
   simgrid::simix::ActorCodeFactory& factory = SIMIX_get_actor_code_factory(process->function);
   xbt_assert(factory, "Function '%s' unknown", process->function);
 
-  double start_time = process->start_time;
-  double kill_time  = process->kill_time;
-  int auto_restart = process->on_failure == SURF_ACTOR_ON_FAILURE_DIE ? 0 : 1;
+  bool auto_restart = process->on_failure != SURF_ACTOR_ON_FAILURE_DIE;
 
   std::vector<std::string> args(process->argv, process->argv + process->argc);
-  std::function<void()> code = factory(std::move(args));
-
-  smx_process_arg_t arg = nullptr;
-
-  arg = new simgrid::simix::ProcessArg();
-  arg->name = std::string(process->argv[0]);
-  arg->code = code;
-  arg->data = nullptr;
-  arg->host = host;
-  arg->kill_time = kill_time;
-  arg->properties = current_property_set;
-
-  host->extension<simgrid::simix::Host>()->boot_processes.push_back(arg);
-
-  if (start_time > SIMIX_get_clock()) {
-
-    arg = new simgrid::simix::ProcessArg();
-    arg->name = std::string(process->argv[0]);
-    arg->code = std::move(code);
-    arg->data = nullptr;
-    arg->host = host;
-    arg->kill_time = kill_time;
-    arg->properties = current_property_set;
-
-    XBT_DEBUG("Process %s@%s will be started at time %f", arg->name.c_str(), arg->host->cname(), start_time);
-    SIMIX_timer_set(start_time, [arg, auto_restart]() {
-      smx_actor_t actor = simix_global->create_process_function(arg->name.c_str(), std::move(arg->code), arg->data,
-                                                                arg->host, arg->properties, nullptr);
-      if (arg->kill_time >= 0)
-        simcall_process_set_kill_time(actor, arg->kill_time);
-      if (auto_restart)
-        SIMIX_process_auto_restart_set(actor, auto_restart);
-      delete arg;
-    });
-  } else {                      // start_time <= SIMIX_get_clock()
-    XBT_DEBUG("Starting Process %s(%s) right now", arg->name.c_str(), host->cname());
-
-    smx_actor_t actor = simix_global->create_process_function(arg->name.c_str(), std::move(code), nullptr, host,
-                                                              current_property_set, nullptr);
-
-    /* The actor creation will fail if the host is currently dead, but that's fine */
-    if (actor != nullptr) {
-      if (arg->kill_time >= 0)
-        simcall_process_set_kill_time(actor, arg->kill_time);
-      if (auto_restart)
-        SIMIX_process_auto_restart_set(actor, auto_restart);
-    }
-  }
+  simgrid::simix::deploy_actor(host, process->argv[0], factory(std::move(args)), process->start_time,
+                               process->kill_time, auto_restart, current_property_set);
   current_property_set = nullptr;
 }
 
@@ -5,6 +5,7 @@
 
 #include "simgrid/s4u/Engine.hpp"
 #include "src/instr/instr_private.h"
+#include "src/kernel/Profiler.hpp"
 #include "src/plugins/vm/VirtualMachineImpl.hpp"
 
 XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(surf_kernel);
@@ -40,6 +41,7 @@ void surf_presolve()
 
 double surf_solve(double max_date)
 {
+  simgrid::kernel::profiler::Scope scope(simgrid::kernel::profiler::Phase::surf);
   double time_delta = -1.0; /* duration */
   double next_event_date = -1.0;
   double model_next_action_end = -1.0;
@@ -101,7 +103,7 @@ double surf_solve(double max_date)
     XBT_DEBUG("Updating models (min = %g, NOW = %g, next_event_date = %g)", time_delta, NOW, next_event_date);
 
     while ((event = future_evt_set->pop_leq(next_event_date, &value, &resource))) {
-      if (resource->isUsed() || xbt_dict_get_or_null(watched_hosts_lib, resource->cname())) {
+      if (resource->isUsed() || watched_hosts_lib.count(resource->internedName())) {
         time_delta = next_event_date - NOW;
         XBT_DEBUG("This event invalidates the next_occuring_event() computation of models. Next event set to %f", time_delta);
       }
@@ -130,8 +132,10 @@ double surf_solve(double max_date)
   NOW = NOW + time_delta;
 
   // Inform the models of the date change
-  for (auto model : *all_existing_models) {
-    model->updateActionsState(NOW, time_delta);
+  {
+    simgrid::kernel::profiler::Scope update(simgrid::kernel::profiler::Phase::update_actions);
+    for (auto model : *all_existing_models)
+      model->updateActionsState(NOW, time_delta);
   }
   simgrid::s4u::onTimeAdvance(time_delta);
 
@@ -8,7 +8,9 @@
 #include "simgrid/s4u/Engine.hpp"
 #include "simgrid/sg_config.h"
 #include "src/instr/instr_private.h" // TRACE_is_enabled(). FIXME: remove by subscribing tracing to the surf signals
+#include "src/kernel/Profiler.hpp"
 #include "src/kernel/routing/NetPoint.hpp"
+#include "src/surf/maxmin_private.hpp"
 #include "src/surf/HostImpl.hpp"
 
 #include <fstream>
@@ -26,7 +28,7 @@ std::vector<surf_model_t> * all_existing_models = nullptr; /* to destroy models
 simgrid::trace_mgr::future_evt_set *future_evt_set = nullptr;
 std::vector<std::string> surf_path;
 std::vector<simgrid::s4u::Host*> host_that_restart;
-xbt_dict_t watched_hosts_lib;
+watched_hosts_t watched_hosts_lib;
 extern std::map<std::string, storage_type_t> storage_types;
 
 namespace simgrid {
@@ -340,8 +342,6 @@ void surf_init(int *argc, char **argv)
   XBT_DEBUG("Create all Libs");
   USER_HOST_LEVEL = simgrid::s4u::Host::extension_create(nullptr);
 
-  watched_hosts_lib = xbt_dict_new_homogeneous(nullptr);
-
   xbt_init(argc, argv);
   if (not all_existing_models)
     all_existing_models = new std::vector<simgrid::surf::Model*>();
@@ -363,7 +363,7 @@ void surf_exit()
 
   sg_host_exit();
   sg_link_exit();
-  xbt_dict_free(&watched_hosts_lib);
+  watched_hosts_lib.clear();
   for (auto e : storage_types) {
     storage_type_t stype = e.second;
     free(stype->model);
@@ -436,10 +436,20 @@ double Model::nextOccuringEvent(double now)
     xbt_die("Invalid cpu update mechanism!");
 }
 
+/* Solves the LMM system of a model, and accounts it to the kernel profiler */
+static void solve_system(lmm_system_t sys, void (*solve_fun)(lmm_system_t))
+{
+  if (simgrid::kernel::profiler::enabled && sys->modified)
+    simgrid::kernel::profiler::count_lmm_solve(xbt_swag_size(&sys->variable_set),
+                                               xbt_swag_size(&sys->active_constraint_set));
+  simgrid::kernel::profiler::Scope scope(simgrid::kernel::profiler::Phase::lmm);
+  solve_fun(sys);
+}
+
 double Model::nextOccuringEventLazy(double now)
 {
   XBT_DEBUG("Before share resources, the size of modified actions set is %zd", modifiedSet_->size());
-  lmm_solve(maxminSystem_);
+  solve_system(maxminSystem_, &lmm_solve);
   XBT_DEBUG("After share resources, The size of modified actions set is %zd", modifiedSet_->size());
 
   while (not modifiedSet_->empty()) {
@@ -501,7 +511,7 @@ double Model::nextOccuringEventLazy(double now)
 }
 
 double Model::nextOccuringEventFull(double /*now*/) {
-  maxminSystem_->solve_fun(maxminSystem_);
+  solve_system(maxminSystem_, maxminSystem_->solve_fun);
 
   double min = -1;
   for (auto it(getRunningActionSet()->begin()), itend(getRunningActionSet()->end()); it != itend ; ++it) {
@@ -10,6 +10,7 @@
 
 #include "src/surf/surf_private.h"
 #include "surf/surf.h"
+#include "xbt/interned_string.hpp"
 #include "xbt/str.h"
 
 #include <boost/intrusive/list.hpp>
@@ -379,6 +380,8 @@ public:
 
   /** @brief Get the name of the current Resource */
   const char* cname() const;
+  /** @brief Get the name of the current Resource, as a key of the registries */
+  simgrid::xbt::InternedString internedName() const { return name_; }
 
   bool operator==(const Resource &other) const;
 
@@ -403,7 +406,7 @@ public:
   virtual void turnOff();
 
 private:
-  std::string name_;
+  simgrid::xbt::InternedString name_;
   Model *model_;
   bool isOn_ = true;
 
@@ -9,12 +9,16 @@
 #include "surf/surf.h"
 #include "surf/maxmin.h"
 #include "src/surf/trace_mgr.hpp"
+#include "src/xbt/flat_map.hpp"
+#include "xbt/interned_string.hpp"
 
 #define NO_MAX_DURATION -1.0
 
-SG_BEGIN_DECL()
+/** @brief Hosts that have actors to restart, indexed by name: the events of their resources must be handled */
+typedef simgrid::xbt::FlatMap<simgrid::xbt::InternedString, sg_host_t> watched_hosts_t;
+XBT_PUBLIC_DATA(watched_hosts_t) watched_hosts_lib;
 
-XBT_PUBLIC_DATA(xbt_dict_t) watched_hosts_lib;
+SG_BEGIN_DECL()
 
 extern XBT_PRIVATE const char *surf_action_state_names[6];
 
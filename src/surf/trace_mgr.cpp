@@ -9,13 +9,16 @@
 #include "xbt/log.h"
 #include "xbt/str.h"
 
+#include "src/kernel/MemoryAccounting.hpp"
 #include "src/surf/surf_interface.hpp"
 #include "src/surf/trace_mgr.hpp"
+#include "src/xbt/parse_number.hpp"
 #include "surf_private.h"
 #include "xbt/RngStream.h"
-#include <boost/algorithm/string.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <boost/algorithm/string/join.hpp>
-#include <boost/algorithm/string/split.hpp>
 #include <fstream>
 #include <math.h>
 #include <sstream>
@@ -49,8 +52,13 @@ trace::trace()
   /* Add the first fake event storing the time at which the trace begins */
   tmgr::DatedValue val(0, -1);
   event_list.push_back(val);
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::traces, sizeof(trace) + sizeof(DatedValue));
+}
+trace::~trace()
+{
+  simgrid::kernel::memory::freed(simgrid::kernel::memory::Tag::traces,
+                                 sizeof(trace) + event_list.size() * sizeof(DatedValue));
 }
-trace::~trace()                  = default;
 future_evt_set::future_evt_set() = default;
 simgrid::trace_mgr::future_evt_set::~future_evt_set()
 {
@@ -59,6 +67,15 @@ simgrid::trace_mgr::future_evt_set::~future_evt_set()
 }
 }
 
+/* Parses a "KEYWORD value" line of a trace */
+static bool parse_keyword(const char* line, const char* end, const char* keyword, double* value)
+{
+  size_t len = strlen(keyword);
+  if (static_cast<size_t>(end - line) < len || strncmp(line, keyword, len) != 0)
+    return false;
+  return simgrid::xbt::parse_double(line + len, end, value) != line + len;
+}
+
 tmgr_trace_t tmgr_trace_new_from_string(const char* name, std::string input, double periodicity)
 {
   int linecount = 0;
@@ -67,21 +84,29 @@ tmgr_trace_t tmgr_trace_new_from_string(const char* name, std::string input, dou
 
   xbt_assert(trace_list.find(name) == trace_list.end(), "Refusing to define trace %s twice", name);
 
-  std::vector<std::string> list;
-  boost::split(list, input, boost::is_any_of("\n\r"));
-  for (auto val : list) {
-    tmgr::DatedValue event;
+  /* The lines are parsed in place: this is the bulk of the platform loading time when the traces are large */
+  const char* line_end  = input.c_str();
+  const char* input_end = line_end + input.size();
+  while (line_end < input_end) {
+    const char* line = line_end;
+    line_end         = std::find_if(line, input_end, [](char c) { return c == '\n' || c == '\r'; });
     linecount++;
-    boost::trim(val);
-    if (val[0] == '#' || val[0] == '\0' || val[0] == '%') // pass comments
+    const char* stop = line_end;
+    while (line < stop && isspace(static_cast<unsigned char>(*line)))
+      line++;
+    while (stop > line && isspace(static_cast<unsigned char>(stop[-1])))
+      stop--;
+    line_end++;
+    if (line == stop || *line == '#' || *line == '%') // pass comments
       continue;
-    if (sscanf(val.c_str(), "PERIODICITY %lg\n", &periodicity) == 1)
-      continue;
-    if (sscanf(val.c_str(), "LOOPAFTER %lg\n", &periodicity) == 1)
+    if (parse_keyword(line, stop, "PERIODICITY", &periodicity) || parse_keyword(line, stop, "LOOPAFTER", &periodicity))
       continue;
 
-    xbt_assert(sscanf(val.c_str(), "%lg  %lg\n", &event.date_, &event.value_) == 2, "%s:%d: Syntax error in trace\n%s",
-               name, linecount, input.c_str());
+    tmgr::DatedValue event;
+    const char* date_end  = simgrid::xbt::parse_double(line, stop, &event.date_);
+    const char* value_end = simgrid::xbt::parse_double(date_end, stop, &event.value_);
+    xbt_assert(date_end != line && value_end != date_end, "%s:%d: Syntax error in trace\n%s", name, linecount,
+               input.c_str());
 
     xbt_assert(last_event->date_ <= event.date_,
                "%s:%d: Invalid trace: Events must be sorted, but time %g > time %g.\n%s", name, linecount,
@@ -98,6 +123,9 @@ tmgr_trace_t tmgr_trace_new_from_string(const char* name, std::string input, dou
       last_event->date_ = -1;
     }
   }
+  trace->event_list.shrink_to_fit();
+  simgrid::kernel::memory::allocated(simgrid::kernel::memory::Tag::traces,
+                                     (trace->event_list.size() - 1) * sizeof(tmgr::DatedValue));
 
   trace_list.insert({xbt_strdup(name), trace});
 
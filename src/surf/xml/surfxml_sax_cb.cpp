@@ -7,6 +7,7 @@
 #include "simgrid/sg_config.h"
 #include "src/kernel/routing/NetPoint.hpp"
 #include "src/surf/network_interface.hpp"
+#include "src/xbt/parse_number.hpp"
 #include "xbt/file.h"
 
 #include "src/surf/xml/platf_private.hpp"
@@ -14,6 +15,7 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 #include <string>
+#include <vector>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(surf_parse, surf, "Logging specific to the SURF parsing module");
 
@@ -120,10 +122,10 @@ struct unit_scale {
 static double surf_parse_get_value_with_unit(const char *string, const struct unit_scale *units,
     const char *entity_kind, const char *name, const char *error_msg, const char *default_unit)
 {
-  char* ptr;
+  double res;
   int i;
-  errno = 0;
-  double res   = strtod(string, &ptr);
+  errno           = 0;
+  const char* ptr = simgrid::xbt::parse_double(string, &res);
   if (errno == ERANGE)
     surf_parse_error("value out of range: %s", string);
   if (ptr == string)
@@ -133,7 +135,7 @@ static double surf_parse_get_value_with_unit(const char *string, const struct un
       return res; // Ok, 0 can be unit-less
 
     XBT_WARN("Deprecated unit-less value '%s' for %s %s. %s",string, entity_kind, name, error_msg);
-    ptr = (char*)default_unit;
+    ptr = default_unit;
   }
   for (i = 0; units[i].unit != nullptr && strcmp(ptr, units[i].unit) != 0; i++);
 
@@ -1001,8 +1003,8 @@ void ETag_surfxml_config()
   current_property_set = nullptr;
 }
 
-static int argc;
-static char **argv;
+/* Reused from one actor to the next, so that large deployment files do not reallocate it for each argument */
+static std::vector<char*> argv;
 
 void STag_surfxml_process()
 {
@@ -1012,9 +1014,8 @@ void STag_surfxml_process()
 void STag_surfxml_actor()
 {
   ZONE_TAG  = 0;
-  argc    = 1;
-  argv    = xbt_new(char *, 1);
-  argv[0] = xbt_strdup(A_surfxml_actor_function);
+  argv.clear();
+  argv.push_back(xbt_strdup(A_surfxml_actor_function));
   xbt_assert(current_property_set == nullptr, "Someone forgot to reset the property set to nullptr in its closing tag (or XML malformed)");
 }
 
@@ -1032,8 +1033,8 @@ void ETag_surfxml_actor()
   s_sg_platf_process_cbarg_t actor;
   memset(&actor,0,sizeof(actor));
 
-  actor.argc       = argc;
-  actor.argv       = (const char **)argv;
+  actor.argc       = argv.size();
+  actor.argv       = const_cast<const char**>(argv.data());
   actor.properties = current_property_set;
   actor.host       = A_surfxml_actor_host;
   actor.function   = A_surfxml_actor_function;
@@ -1055,18 +1056,15 @@ void ETag_surfxml_actor()
 
   sg_platf_new_process(&actor);
 
-  for (int i = 0; i != argc; ++i)
-    xbt_free(argv[i]);
-  xbt_free(argv);
-  argv = nullptr;
+  for (char* arg : argv)
+    xbt_free(arg);
+  argv.clear();
 
   current_property_set = nullptr;
 }
 
 void STag_surfxml_argument(){
-  argc++;
-  argv = (char**)xbt_realloc(argv, (argc) * sizeof(char **));
-  argv[(argc) - 1] = xbt_strdup(A_surfxml_argument_value);
+  argv.push_back(xbt_strdup(A_surfxml_argument_value));
 }
 
 void STag_surfxml_model___prop(){
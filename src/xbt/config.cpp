@@ -96,6 +96,21 @@ static long int parseLong(const char* value)
     return res;
 }
 
+static unsigned long long parseUnsignedLongLong(const char* value)
+{
+  char* end;
+  errno = 0;
+  unsigned long long res = std::strtoull(value, &end, 0);
+  if (errno == ERANGE)
+    throw std::range_error("overflow");
+  else if (errno)
+    xbt_die("Unexpected errno");
+  if (end == value || *end != '\0' || std::strchr(value, '-') != nullptr)
+    throw std::range_error("invalid unsigned integer");
+  else
+    return res;
+}
+
 // ***** ConfigType *****
 
 /// A trait which define possible options types:
@@ -108,6 +123,13 @@ template<> struct ConfigType<int> {
     return parseLong(value);
   }
 };
+template<> struct ConfigType<unsigned long long> {
+  static constexpr const char* type_name = "unsigned long long";
+  static inline unsigned long long parse(const char* value)
+  {
+    return parseUnsignedLongLong(value);
+  }
+};
 template<> struct ConfigType<double> {
   static constexpr const char* type_name = "double";
   static inline double parse(const char* value)
@@ -135,6 +157,10 @@ template<> struct ConfigType<bool> {
 class ConfigurationElement ;
 template<class T> class TypedConfigurationElement;
 
+/* Amount of living BulkUpdate, and the options changed meanwhile (whose watchers are still to notify) */
+int bulk_updates = 0;
+std::vector<ConfigurationElement*> pending_notifications;
+
 // **** ConfigurationElement ****
 
 class ConfigurationElement {
@@ -158,6 +184,8 @@ public:
   virtual std::string getStringValue() = 0;
   virtual void setStringValue(const char* value) = 0;
   virtual const char* getTypeName() = 0;
+  /** Calls the watchers */
+  virtual void notify() = 0;
 
   template<class T>
   T const& getValue() const
@@ -187,6 +215,7 @@ class TypedConfigurationElement : public ConfigurationElement {
 private:
   T content;
   std::function<void(T&)> callback;
+  std::vector<std::function<void(T const&)>> watchers;
 
 public:
   TypedConfigurationElement(const char* key, const char* desc, T value = T())
@@ -207,12 +236,30 @@ public:
   const char* getTypeName() override;
   void setStringValue(const char* value) override;
 
+  void notify() override
+  {
+    for (auto const& watcher : watchers)
+      watcher(content);
+  }
+
   void update()
   {
     if (old_callback)
       this->old_callback(key.c_str());
     if (this->callback)
       this->callback(this->content);
+    if (watchers.empty())
+      return;
+    if (bulk_updates == 0)
+      notify();
+    else if (std::find(pending_notifications.begin(), pending_notifications.end(), this) == pending_notifications.end())
+      pending_notifications.push_back(this);
+  }
+
+  void watch(std::function<void(T const&)> watcher)
+  {
+    watcher(content);
+    watchers.push_back(std::move(watcher));
   }
 
   T const& getValue() const { return content; }
@@ -427,10 +474,42 @@ XBT_PUBLIC(T const&) getConfig(const char* name)
 }
 
 template XBT_PUBLIC(int const&) getConfig<int>(const char* name);
+template XBT_PUBLIC(unsigned long long const&) getConfig<unsigned long long>(const char* name);
 template XBT_PUBLIC(double const&) getConfig<double>(const char* name);
 template XBT_PUBLIC(bool const&) getConfig<bool>(const char* name);
 template XBT_PUBLIC(std::string const&) getConfig<std::string>(const char* name);
 
+// ***** watchConfig *****
+
+template<class T>
+XBT_PUBLIC(void) watchConfig(const char* name, std::function<void(T const&)> callback)
+{
+  dynamic_cast<TypedConfigurationElement<T>&>((*simgrid_config)[name]).watch(std::move(callback));
+}
+
+template XBT_PUBLIC(void) watchConfig<int>(const char* name, std::function<void(int const&)> callback);
+template XBT_PUBLIC(void)
+    watchConfig<unsigned long long>(const char* name, std::function<void(unsigned long long const&)> callback);
+template XBT_PUBLIC(void) watchConfig<double>(const char* name, std::function<void(double const&)> callback);
+template XBT_PUBLIC(void) watchConfig<bool>(const char* name, std::function<void(bool const&)> callback);
+template XBT_PUBLIC(void)
+    watchConfig<std::string>(const char* name, std::function<void(std::string const&)> callback);
+
+BulkUpdate::BulkUpdate()
+{
+  bulk_updates++;
+}
+
+BulkUpdate::~BulkUpdate()
+{
+  if (--bulk_updates > 0)
+    return;
+  std::vector<ConfigurationElement*> elements;
+  elements.swap(pending_notifications);
+  for (ConfigurationElement* element : elements)
+    element->notify();
+}
+
 // ***** alias *****
 
 void alias(const char* realname, const char* aliasname)
@@ -454,6 +533,8 @@ XBT_PUBLIC(void) declareFlag(const char* name, const char* description,
 
 template XBT_PUBLIC(void) declareFlag(const char* name,
   const char* description, int value, std::function<void(int const &)> callback);
+template XBT_PUBLIC(void) declareFlag(const char* name, const char* description, unsigned long long value,
+                                      std::function<void(unsigned long long const&)> callback);
 template XBT_PUBLIC(void) declareFlag(const char* name,
   const char* description, double value, std::function<void(double const &)> callback);
 template XBT_PUBLIC(void) declareFlag(const char* name,
@@ -539,6 +620,7 @@ void xbt_cfg_set_parse(const char *options)
   if (not options || not strlen(options)) { /* nothing to do */
     return;
   }
+  simgrid::config::BulkUpdate bulk_update;
   char *optionlist_cpy = xbt_strdup(options);
 
   XBT_DEBUG("List to parse and set:'%s'", options);
@@ -897,14 +979,42 @@ XBT_TEST_UNIT("c++flags", test_config_cxx_flags, "C++ flags")
   simgrid::config::Flag<double> double_flag("double", "", 0.32);
   simgrid::config::Flag<bool> bool_flag1("bool1", "", false);
   simgrid::config::Flag<bool> bool_flag2("bool2", "", true);
+  simgrid::config::Flag<unsigned long long> ull_flag("ull", "", 0);
 
   xbt_test_add("Parse values");
-  xbt_cfg_set_parse("int:42 string:bar double:8.0 bool1:true bool2:false");
+  xbt_cfg_set_parse("int:42 string:bar double:8.0 bool1:true bool2:false ull:18446744073709551615");
   xbt_test_assert(int_flag == 42, "Check int flag");
   xbt_test_assert(string_flag == "bar", "Check string flag");
   xbt_test_assert(double_flag == 8.0, "Check double flag");
   xbt_test_assert(bool_flag1, "Check bool1 flag");
   xbt_test_assert(not bool_flag2, "Check bool2 flag");
+  xbt_test_assert(ull_flag == 18446744073709551615ULL, "Check unsigned long long flag");
+
+  xbt_cfg_free(&simgrid_config);
+  simgrid_config = temp;
+}
+
+XBT_TEST_UNIT("handles", test_config_handles, "Watchers and handles")
+{
+  auto temp = simgrid_config;
+  make_set();
+  xbt_test_add("Handles on options");
+
+  simgrid::config::Handle<int> speed("speed");
+  simgrid::config::Handle<std::string> user("user");
+  xbt_test_assert(speed == 0, "Check the initial value");
+  xbt_cfg_set_int("speed", 12);
+  xbt_test_assert(speed == 12, "Check the updated value");
+
+  xbt_test_add("Watchers see the options set together at once");
+  std::string seen;
+  simgrid::config::watchConfig<int>("speed", [&seen, &user](int const& value) {
+    seen = std::to_string(value) + " " + user.get();
+  });
+  xbt_test_assert(seen == "12 ", "Watchers are called at registration (got '%s')", seen.c_str());
+  xbt_cfg_set_parse("speed:42 user:bidule");
+  xbt_test_assert(seen == "42 bidule", "Watchers are called after the bulk update (got '%s')", seen.c_str());
+  xbt_test_assert(speed == 42 && user.get() == "bidule", "Check the handles after the bulk update");
 
   xbt_cfg_free(&simgrid_config);
   simgrid_config = temp;
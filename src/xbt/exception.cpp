@@ -105,6 +105,7 @@ static void handler()
   catch (std::exception& e) {
     logException(xbt_log_priority_critical, "Uncaught exception", e);
     showBacktrace(bt);
+    xbt_log_flush();
     std::abort();
   }
 
@@ -116,6 +117,7 @@ static void handler()
     else {
       XBT_ERROR("Unknown uncaught exception");
       showBacktrace(bt);
+      xbt_log_flush();
       std::abort();
     }
   }
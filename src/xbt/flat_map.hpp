@@ -0,0 +1,200 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_FLAT_MAP_HPP
+#define SIMGRID_XBT_FLAT_MAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief A hash map storing its elements contiguously, for the lookups of the simulation kernel
+ *
+ *  The elements are kept in a vector, and indexed by an open-addressing table of 32-bit positions with linear
+ *  probing. An element thus costs its own size plus 8 to 16 bytes of index, with no allocation per element, and a
+ *  lookup usually reads a single cache line of the index before comparing the key.
+ *
+ *  The elements are iterated in the order of their insertion, except that erasing an element moves the last one in
+ *  its place. The iteration order thus depends neither on the hash function nor on the memory addresses, which keeps
+ *  the simulations reproducible from one platform to another.
+ *
+ *  Unlike std::unordered_map, inserting or erasing an element invalidates the iterators and the references to the
+ *  elements. The keys must not be modified through the iterators.
+ */
+template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class FlatMap {
+public:
+  using key_type       = Key;
+  using mapped_type    = T;
+  using value_type     = std::pair<Key, T>;
+  using iterator       = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  FlatMap() = default;
+  explicit FlatMap(size_t count) { reserve(count); }
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+  size_t bucket_count() const { return slots_.size(); }
+  /** Bytes used by the elements and by the index, not counting what the elements point to */
+  size_t memory_footprint() const
+  {
+    return entries_.capacity() * sizeof(value_type) + slots_.capacity() * sizeof(Slot);
+  }
+
+  iterator find(const Key& key)
+  {
+    size_t slot = lookup(key, hash(key));
+    return slot == npos ? end() : begin() + (slots_[slot].position - 1);
+  }
+  const_iterator find(const Key& key) const
+  {
+    size_t slot = lookup(key, hash(key));
+    return slot == npos ? end() : begin() + (slots_[slot].position - 1);
+  }
+  size_t count(const Key& key) const { return lookup(key, hash(key)) == npos ? 0 : 1; }
+
+  /** Builds the value from the arguments if the key is not present yet, as std::map::try_emplace() */
+  template <class... Args> std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+  {
+    uint32_t h  = hash(key);
+    size_t slot = lookup(key, h);
+    if (slot != npos)
+      return {begin() + (slots_[slot].position - 1), false};
+    if ((entries_.size() + 1) * 4 > slots_.size() * 3)
+      rehash(std::max<size_t>(8, slots_.size() * 2));
+    entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+    slots_[free_slot(h)] = {static_cast<uint32_t>(entries_.size()), h};
+    return {end() - 1, true};
+  }
+  std::pair<iterator, bool> insert(const value_type& value) { return emplace(value.first, value.second); }
+  T& operator[](const Key& key) { return emplace(key).first->second; }
+
+  size_t erase(const Key& key)
+  {
+    size_t slot = lookup(key, hash(key));
+    if (slot == npos)
+      return 0;
+    erase_slot(slot);
+    return 1;
+  }
+  /** Returns an iterator on the element that took the place of the erased one (or end()) */
+  iterator erase(iterator pos)
+  {
+    size_t position = pos - begin();
+    erase_slot(lookup(pos->first, hash(pos->first)));
+    return begin() + position;
+  }
+
+  void clear()
+  {
+    entries_.clear();
+    std::fill(slots_.begin(), slots_.end(), Slot{0, 0});
+  }
+  void reserve(size_t count)
+  {
+    size_t capacity = 8;
+    while (capacity * 3 < count * 4)
+      capacity *= 2;
+    if (capacity > slots_.size())
+      rehash(capacity);
+    entries_.reserve(count);
+  }
+
+private:
+  /* position is 1 + the index of the element in entries_, or 0 for an empty slot */
+  struct Slot {
+    uint32_t position;
+    uint32_t hash;
+  };
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  std::vector<value_type> entries_;
+  std::vector<Slot> slots_; // Its size is a power of 2
+  Hash hasher_;
+  KeyEqual equal_;
+
+  /* Fibonacci hashing, so that the keys hashed by identity (integers, aligned pointers) spread over the table */
+  uint32_t hash(const Key& key) const
+  {
+    return static_cast<uint32_t>((static_cast<uint64_t>(hasher_(key)) * 0x9E3779B97F4A7C15ULL) >> 32);
+  }
+  size_t mask() const { return slots_.size() - 1; }
+
+  size_t lookup(const Key& key, uint32_t h) const
+  {
+    if (slots_.empty())
+      return npos;
+    for (size_t i = h & mask();; i = (i + 1) & mask()) {
+      const Slot& slot = slots_[i];
+      if (slot.position == 0)
+        return npos;
+      if (slot.hash == h && equal_(entries_[slot.position - 1].first, key))
+        return i;
+    }
+  }
+  size_t free_slot(uint32_t h) const
+  {
+    size_t i = h & mask();
+    while (slots_[i].position != 0)
+      i = (i + 1) & mask();
+    return i;
+  }
+
+  void rehash(size_t capacity)
+  {
+    slots_.assign(capacity, Slot{0, 0});
+    for (size_t i = 0; i < entries_.size(); i++) {
+      uint32_t h           = hash(entries_[i].first);
+      slots_[free_slot(h)] = {static_cast<uint32_t>(i + 1), h};
+    }
+  }
+
+  void erase_slot(size_t slot)
+  {
+    uint32_t position = slots_[slot].position;
+
+    /* Backward-shift deletion: pull back the following slots that would not be reachable anymore, no tombstone */
+    size_t hole = slot;
+    for (size_t i = (hole + 1) & mask(); slots_[i].position != 0; i = (i + 1) & mask()) {
+      size_t home = slots_[i].hash & mask();
+      if (((i - home) & mask()) >= ((i - hole) & mask())) {
+        slots_[hole] = slots_[i];
+        hole         = i;
+      }
+    }
+    slots_[hole] = Slot{0, 0};
+
+    /* Move the last element in the place of the erased one */
+    uint32_t last = static_cast<uint32_t>(entries_.size());
+    if (position != last) {
+      entries_[position - 1] = std::move(entries_.back());
+      size_t i               = hash(entries_[position - 1].first) & mask();
+      while (slots_[i].position != last)
+        i = (i + 1) & mask();
+      slots_[i].position = position;
+    }
+    entries_.pop_back();
+  }
+};
+}
+}
+
+#endif
@@ -0,0 +1,209 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "xbt/interned_string.hpp"
+#include "xbt/sysdep.h"
+
+namespace simgrid {
+namespace xbt {
+
+/* The characters of the interned strings, packed after their headers in chunks that are never freed, and indexed by an
+ * open-addressing table whose slots point to the headers: a lookup reads the slot, then the header and the characters
+ * that follow it. The actors look names up from several threads in parallel mode, so every access takes the lock. */
+class InternedStringPool {
+public:
+  InternedString intern(const char* str, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t h   = hash(str, size);
+    size_t found = lookup(str, size, h);
+    if (slots_[found].header != nullptr)
+      return InternedString(slots_[found].header);
+
+    xbt_assert(size <= UINT32_MAX && strings_.size() < UINT32_MAX, "Too many or too large interned strings");
+    InternedString::Header* header = allocate(sizeof(InternedString::Header) + size + 1);
+    header->id                     = static_cast<uint32_t>(strings_.size());
+    header->size                   = static_cast<uint32_t>(size);
+    char* chars                    = reinterpret_cast<char*>(header + 1);
+    memcpy(chars, str, size);
+    chars[size] = '\0';
+    strings_.push_back(header);
+    slots_[found] = Slot{h, header};
+    if (strings_.size() * 4 > slots_.size() * 3)
+      rehash(slots_.size() * 2);
+    return InternedString(header);
+  }
+  InternedString find(const char* str, size_t size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const InternedString::Header* header = slots_[lookup(str, size, hash(str, size))].header;
+    return header == nullptr ? InternedString() : InternedString(header);
+  }
+  InternedString byId(uint32_t id)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id == 0 || id >= strings_.size() ? InternedString() : InternedString(strings_[id]);
+  }
+  size_t count()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return strings_.size() - 1;
+  }
+  size_t memory_footprint()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size() * chunk_size + large_bytes_ + slots_.capacity() * sizeof(Slot) +
+           strings_.capacity() * sizeof(InternedString::Header*);
+  }
+
+private:
+  struct Slot {
+    uint32_t hash;
+    const InternedString::Header* header; // nullptr for an empty slot
+  };
+
+  static constexpr size_t chunk_size = 64 * 1024;
+  static constexpr size_t alignment  = alignof(InternedString::Header);
+
+  std::mutex mutex_;
+  std::vector<Slot> slots_ = std::vector<Slot>(1024, Slot{0, nullptr}); // Its size is a power of 2
+  std::vector<const InternedString::Header*> strings_{nullptr};         // By id, the id 0 being the null handle
+  std::vector<std::unique_ptr<char[]>> chunks_;
+  std::vector<std::unique_ptr<char[]>> large_; // The strings too large for a chunk, alone in their allocation
+  size_t large_bytes_ = 0;
+  size_t used_        = chunk_size; // In the last chunk
+
+  /* FNV-1a */
+  static uint32_t hash(const char* str, size_t size)
+  {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; i++)
+      hash = (hash ^ static_cast<unsigned char>(str[i])) * 0x100000001b3ULL;
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+  }
+  /* The slot of these characters, or the empty slot where they would go */
+  size_t lookup(const char* str, size_t size, uint32_t h) const
+  {
+    size_t mask = slots_.size() - 1;
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+      const Slot& slot = slots_[i];
+      if (slot.header == nullptr ||
+          (slot.hash == h && slot.header->size == size && memcmp(slot.header + 1, str, size) == 0))
+        return i;
+    }
+  }
+  void rehash(size_t capacity)
+  {
+    std::vector<Slot> old(capacity, Slot{0, nullptr});
+    old.swap(slots_);
+    size_t mask = capacity - 1;
+    for (Slot const& slot : old)
+      if (slot.header != nullptr) {
+        size_t i = slot.hash & mask;
+        while (slots_[i].header != nullptr)
+          i = (i + 1) & mask;
+        slots_[i] = slot;
+      }
+  }
+
+  InternedString::Header* allocate(size_t bytes)
+  {
+    bytes = (bytes + alignment - 1) & ~(alignment - 1);
+    if (bytes > chunk_size / 4) {
+      large_.emplace_back(new char[bytes]);
+      large_bytes_ += bytes;
+      return reinterpret_cast<InternedString::Header*>(large_.back().get());
+    }
+    if (used_ + bytes > chunk_size) {
+      chunks_.emplace_back(new char[chunk_size]);
+      used_ = 0;
+    }
+    char* res = chunks_.back().get() + used_;
+    used_ += bytes;
+    return reinterpret_cast<InternedString::Header*>(res);
+  }
+};
+
+/* Never destroyed: the interned strings outlive the static objects that keep some */
+static InternedStringPool& pool()
+{
+  static InternedStringPool* pool = new InternedStringPool();
+  return *pool;
+}
+
+InternedString::InternedString(const char* str, size_t size) : InternedString(pool().intern(str, size))
+{
+}
+InternedString InternedString::find(const char* str, size_t size)
+{
+  return pool().find(str, size);
+}
+InternedString InternedString::byId(uint32_t id)
+{
+  return pool().byId(id);
+}
+size_t InternedString::count()
+{
+  return pool().count();
+}
+size_t InternedString::memory_footprint()
+{
+  return pool().memory_footprint();
+}
+}
+}
+
+#ifdef SIMGRID_TEST
+#include "xbt/interned_string.hpp"
+#include <vector>
+
+XBT_TEST_SUITE("interned_string", "Interned strings");
+
+XBT_TEST_UNIT("interning", test_interning, "Intern strings and look them up")
+{
+  using simgrid::xbt::InternedString;
+
+  xbt_test_add("Intern the same characters twice");
+  InternedString first("Tremblay");
+  std::string name = "Tremblay";
+  InternedString second(name);
+  xbt_test_assert(first == second && first.c_str() == second.c_str(), "Two handles for the same characters");
+  xbt_test_assert(not strcmp(first.c_str(), "Tremblay") && first.size() == 8, "Wrong characters: %s", first.c_str());
+  xbt_test_assert(first.id() != 0 && InternedString::byId(first.id()) == first, "Wrong id %u", first.id());
+
+  xbt_test_add("Intern other characters");
+  InternedString other("Jupiter");
+  InternedString prefix("Trem");
+  InternedString empty("");
+  xbt_test_assert(other != first && prefix != first && empty != first, "Different characters give the same handle");
+  xbt_test_assert(prefix.size() == 4 && empty && empty.size() == 0, "Wrong size of a short string");
+  xbt_test_assert(first < other && other < prefix, "The ids are not in the order of interning");
+
+  xbt_test_add("Look strings up without interning them");
+  size_t count = InternedString::count();
+  xbt_test_assert(InternedString::find("Jupiter") == other, "Interned string not found");
+  xbt_test_assert(not InternedString::find("Fafard") && InternedString::count() == count,
+                  "A lookup interned a string");
+  xbt_test_assert(not InternedString() && InternedString().id() == 0 && not InternedString::byId(0),
+                  "The null handle is not null");
+
+  xbt_test_add("Intern many strings, some larger than a chunk");
+  std::vector<InternedString> strings;
+  for (int i = 0; i < 10000; i++)
+    strings.emplace_back("mailbox-" + std::to_string(i));
+  std::string large(100000, 'x');
+  InternedString large_first(large);
+  for (int i = 0; i < 10000; i++)
+    xbt_test_assert(InternedString::find("mailbox-" + std::to_string(i)) == strings[i] &&
+                        strings[i].str() == "mailbox-" + std::to_string(i),
+                    "Lost mailbox-%d", i);
+  xbt_test_assert(InternedString(large) == large_first && large_first.str() == large, "Lost the large string");
+  xbt_test_assert(InternedString::find("Tremblay") == first, "Lost the first string");
+}
+#endif /* SIMGRID_TEST */
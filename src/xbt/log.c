@@ -115,6 +115,7 @@ static void xbt_log_connect_categories(void)
   XBT_LOG_CONNECT(xbt_mallocator);
   XBT_LOG_CONNECT(xbt_memory_map);
   XBT_LOG_CONNECT(xbt_parmap);
+  XBT_LOG_CONNECT(xbt_pool);
   XBT_LOG_CONNECT(xbt_sync);
   XBT_LOG_CONNECT(xbt_sync_os);
 
@@ -194,10 +195,12 @@ static void xbt_log_connect_categories(void)
   /* s4u */
   XBT_LOG_CONNECT(s4u);
   XBT_LOG_CONNECT(s4u_activity);
+  XBT_LOG_CONNECT(s4u_activityset);
   XBT_LOG_CONNECT(s4u_actor);
   XBT_LOG_CONNECT(s4u_netzone);
   XBT_LOG_CONNECT(s4u_channel);
   XBT_LOG_CONNECT(s4u_comm);
+  XBT_LOG_CONNECT(s4u_engine);
   XBT_LOG_CONNECT(s4u_file);
    
   /* sg */
@@ -220,10 +223,15 @@ static void xbt_log_connect_categories(void)
   XBT_LOG_CONNECT(simix_host);
   XBT_LOG_CONNECT(simix_io);
   XBT_LOG_CONNECT(simix_kernel);
+  XBT_LOG_CONNECT(simix_memory);
   XBT_LOG_CONNECT(simix_network);
+  XBT_LOG_CONNECT(simix_partition);
   XBT_LOG_CONNECT(simix_process);
   XBT_LOG_CONNECT(simix_popping);
+  XBT_LOG_CONNECT(simix_profiler);
+  XBT_LOG_CONNECT(simix_progress);
   XBT_LOG_CONNECT(simix_synchro);
+  XBT_LOG_CONNECT(simix_timer);
 
   /* smpi */
   /* SMPI categories are connected in smpi_global.c */
@@ -663,6 +671,10 @@ static xbt_log_setting_t _xbt_log_parse_setting(const char *control_string)
       set->appender = xbt_log_appender2_file_new(neweq + 9,1);
     }else if (!strncmp(neweq, "splitfile:", 10)) {
       set->appender = xbt_log_appender2_file_new(neweq + 10,0);
+    }else if (!strcmp(neweq, "async")) {
+      set->appender = xbt_log_appender_async_new(NULL);
+    }else if (!strncmp(neweq, "async:", 6)) {
+      set->appender = xbt_log_appender_async_new(neweq + 6);
     } else {
       THROWF(arg_error, 0, "Unknown appender log type: '%s'", neweq);
     }
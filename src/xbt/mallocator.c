@@ -13,6 +13,8 @@
 #include "mc/mc.h" /* kill mallocators when model-checking is enabled */
 #include "mallocator_private.h"
 
+#include <string.h>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(xbt_mallocator, xbt, "Mallocators");
 
 /** Implementation note on the mallocators:
@@ -32,6 +34,10 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(xbt_mallocator, xbt, "Mallocators");
  *
  * This design avoids to store all mallocators somewhere for later conversion, which would be hard to achieve provided
  * that all our data structures use some mallocators internally...
+ *
+ * When the mallocators are protected (parallel mode), each thread keeps a magazine of objects in front of the shared
+ * stack, and only takes the lock to move half a magazine at once from or to the shared stack. The magazines are only
+ * used in that mode, which the model-checker does not support, so they never mix with its memory either.
  */
 
 /* Value != 0 when the framework configuration is done.  Value > 1 if the
@@ -58,6 +64,92 @@ static inline void lock_release(xbt_mallocator_t m)
     __sync_lock_release(&m->lock);
 }
 
+/* Ids of the mallocators, never reused so that the thread-local magazines of a freed mallocator are left alone */
+static int mallocator_count = 0;
+
+#if HAVE_THREAD_LOCAL_STORAGE
+/* The magazines of the current thread, indexed by mallocator id */
+static XBT_THREAD_LOCAL xbt_mallocator_magazine_t *thread_magazines = NULL;
+static XBT_THREAD_LOCAL int thread_magazines_size = 0;
+
+static inline int xbt_mallocator_use_magazines(void)
+{
+  return initialization_done > 1;
+}
+
+static xbt_mallocator_magazine_t thread_magazine(xbt_mallocator_t m)
+{
+  if (m->id < thread_magazines_size && thread_magazines[m->id] != NULL)
+    return thread_magazines[m->id];
+
+  if (m->id >= thread_magazines_size) {
+    int size = MAX(2 * thread_magazines_size, m->id + 1);
+    thread_magazines = xbt_realloc(thread_magazines, size * sizeof(xbt_mallocator_magazine_t));
+    memset(thread_magazines + thread_magazines_size, 0,
+           (size - thread_magazines_size) * sizeof(xbt_mallocator_magazine_t));
+    thread_magazines_size = size;
+  }
+  xbt_mallocator_magazine_t magazine = xbt_new0(s_xbt_mallocator_magazine_t, 1);
+  lock_acquire(m);
+  magazine->next = m->magazines;
+  m->magazines = magazine;
+  lock_release(m);
+  thread_magazines[m->id] = magazine;
+  return magazine;
+}
+
+static void *magazine_get(xbt_mallocator_t m)
+{
+  xbt_mallocator_magazine_t magazine = thread_magazine(m);
+  if (magazine->count == 0) {
+    /* Refill half of the magazine from the shared stack, and create the missing objects out of the lock */
+    int amount = XBT_MALLOCATOR_MAGAZINE_SIZE / 2;
+    lock_acquire(m);
+    int taken = MIN(amount, m->current_size);
+    m->current_size -= taken;
+    memcpy(magazine->objects, m->objects + m->current_size, taken * sizeof(void *));
+    lock_release(m);
+    for (int i = taken; i < amount; i++)
+      magazine->objects[i] = m->new_f();
+    magazine->count = amount;
+  }
+  return magazine->objects[--magazine->count];
+}
+
+static void magazine_release(xbt_mallocator_t m, void *object)
+{
+  xbt_mallocator_magazine_t magazine = thread_magazine(m);
+  if (magazine->count == XBT_MALLOCATOR_MAGAZINE_SIZE) {
+    /* Return the older half of the magazine to the shared stack, and free what does not fit in there */
+    int amount = XBT_MALLOCATOR_MAGAZINE_SIZE / 2;
+    lock_acquire(m);
+    int given = MIN(amount, m->max_size - m->current_size);
+    memcpy(m->objects + m->current_size, magazine->objects, given * sizeof(void *));
+    m->current_size += given;
+    lock_release(m);
+    for (int i = given; i < amount; i++)
+      m->free_f(magazine->objects[i]);
+    magazine->count -= amount;
+    memmove(magazine->objects, magazine->objects + amount, magazine->count * sizeof(void *));
+  }
+  magazine->objects[magazine->count++] = object;
+}
+#else
+static inline int xbt_mallocator_use_magazines(void)
+{
+  return 0;
+}
+/* Never called */
+static void *magazine_get(xbt_mallocator_t m)
+{
+  return m->new_f();
+}
+static void magazine_release(xbt_mallocator_t m, void *object)
+{
+  m->free_f(object);
+}
+#endif
+
 /**
  * This function must be called once the framework configuration is done. If not, mallocators will never get used.
  * Check the implementation notes in src/xbt/mallocator.c for the justification of this.
@@ -107,6 +199,8 @@ xbt_mallocator_t xbt_mallocator_new(int size, pvoid_f_void_t new_f, void_f_pvoid
   m->free_f = free_f;
   m->reset_f = reset_f;
   m->max_size = size;
+  m->id = __sync_fetch_and_add(&mallocator_count, 1);
+  m->magazines = NULL;
 
   return m;
 }
@@ -127,6 +221,13 @@ void xbt_mallocator_free(xbt_mallocator_t m)
   for (i = 0; i < m->current_size; i++) {
     m->free_f(m->objects[i]);
   }
+  while (m->magazines != NULL) {
+    xbt_mallocator_magazine_t magazine = m->magazines;
+    for (i = 0; i < magazine->count; i++)
+      m->free_f(magazine->objects[i]);
+    m->magazines = magazine->next;
+    xbt_free(magazine);
+  }
   xbt_free(m->objects);
   xbt_free(m);
 }
@@ -149,7 +250,9 @@ void *xbt_mallocator_get(xbt_mallocator_t m)
 {
   void *object;
 
-  if (m->objects != NULL) { // this mallocator is active, stop thinking and go for it!
+  if (m->objects != NULL && xbt_mallocator_use_magazines()) {
+    object = magazine_get(m);
+  } else if (m->objects != NULL) { // this mallocator is active, stop thinking and go for it!
     lock_acquire(m);
     if (m->current_size <= 0) {
       /* No object is ready yet. Create a bunch of them to try to group the
@@ -198,7 +301,9 @@ void xbt_mallocator_release(xbt_mallocator_t m, void *object)
 {
   if (m == NULL) // The mallocators are already destroyed. Bail out ASAP.
      return;
-  if (m->objects != NULL) { // Go for it
+  if (m->objects != NULL && xbt_mallocator_use_magazines()) {
+    magazine_release(m, object);
+  } else if (m->objects != NULL) { // Go for it
     lock_acquire(m);
     if (m->current_size < m->max_size) {
       /* there is enough place to push the object */
@@ -10,6 +10,15 @@
 
 #include <xbt/function_types.h>
 
+/* Objects cached by a thread in front of the shared stack, in parallel mode */
+#define XBT_MALLOCATOR_MAGAZINE_SIZE 64
+typedef struct s_xbt_mallocator_magazine {
+  int count;                                    /* number of objects in the magazine */
+  struct s_xbt_mallocator_magazine *next;       /* next magazine of the same mallocator */
+  void *objects[XBT_MALLOCATOR_MAGAZINE_SIZE];
+} s_xbt_mallocator_magazine_t;
+typedef struct s_xbt_mallocator_magazine *xbt_mallocator_magazine_t;
+
 typedef struct s_xbt_mallocator {
   void **objects;               /* objects stored by the mallocator and available for the user */
   int current_size;             /* number of objects currently stored */
@@ -18,6 +27,8 @@ typedef struct s_xbt_mallocator {
   void_f_pvoid_t free_f;        /* function to call when we have got too many objects */
   void_f_pvoid_t reset_f;       /* function to call when an object is released by the user */
   int lock;                     /* lock to ensure the mallocator is thread-safe */
+  int id;                       /* index of the magazine of this mallocator in the thread-local arrays */
+  xbt_mallocator_magazine_t magazines; /* magazines of all threads, protected by the lock */
 } s_xbt_mallocator_t;
 
 #endif
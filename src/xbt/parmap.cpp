@@ -68,7 +68,8 @@ typedef struct s_xbt_parmap {
   unsigned int num_workers;        /**< total number of worker threads including the controller */
   xbt_os_thread_t *workers;        /**< worker thread handlers */
   void_f_pvoid_t fun;              /**< function to run in parallel on each element of data */
-  xbt_dynar_t data;                /**< parameters to pass to fun in parallel */
+  void* data;                      /**< parameters to pass to fun in parallel */
+  xbt_parmap_get_f get;            /**< accessor to the elements of data */
   std::atomic<unsigned int> index; /**< index of the next element of data to pick */
 
   /* posix only */
@@ -229,10 +230,29 @@ static void xbt_parmap_set_mode(xbt_parmap_t parmap, e_xbt_parmap_mode_t mode)
  * \param data each element of this dynar will be passed as an argument to fun
  */
 void xbt_parmap_apply(xbt_parmap_t parmap, void_f_pvoid_t fun, xbt_dynar_t data)
+{
+  xbt_parmap_apply_getter(parmap, fun, data, [](void* dynar, unsigned long i) {
+    return i < xbt_dynar_length(static_cast<xbt_dynar_t>(dynar)) ? xbt_dynar_get_as(static_cast<xbt_dynar_t>(dynar), i, void*)
+                                                                 : nullptr;
+  });
+}
+
+/**
+ * \brief Applies a list of tasks in parallel, from any container.
+ *
+ * The elements are fetched one after the other with get(), so the container may grow while the tasks are running.
+ *
+ * \param parmap a parallel map object
+ * \param fun the function to call in parallel
+ * \param data the container of the arguments to pass to fun
+ * \param get returns the element of a given index of data (or NULL past its end)
+ */
+void xbt_parmap_apply_getter(xbt_parmap_t parmap, void_f_pvoid_t fun, void* data, xbt_parmap_get_f get)
 {
   /* Assign resources to worker threads (we are maestro here)*/
   parmap->fun = fun;
   parmap->data = data;
+  parmap->get = get;
   parmap->index = 0;
   parmap->master_signal_f(parmap); // maestro runs futex_wait to wake all the minions (the working threads)
   xbt_parmap_work(parmap);         // maestro works with its minions
@@ -250,18 +270,15 @@ void xbt_parmap_apply(xbt_parmap_t parmap, void_f_pvoid_t fun, xbt_dynar_t data)
 void* xbt_parmap_next(xbt_parmap_t parmap)
 {
   unsigned int index = parmap->index++;
-  if (index < xbt_dynar_length(parmap->data)) {
-    return xbt_dynar_get_as(parmap->data, index, void*);
-  }
-  return nullptr;
+  return parmap->get(parmap->data, index);
 }
 
 static void xbt_parmap_work(xbt_parmap_t parmap)
 {
-  unsigned int index = parmap->index++;
-  while (index < xbt_dynar_length(parmap->data)){
-    parmap->fun(xbt_dynar_get_as(parmap->data, index, void*));
-    index = parmap->index++;
+  void* work = xbt_parmap_next(parmap);
+  while (work != nullptr) {
+    parmap->fun(work);
+    work = xbt_parmap_next(parmap);
   }
 }
 
@@ -0,0 +1,239 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* The fast path is the one of Clinger ("How to read floating point numbers accurately", PLDI'90): when the decimal
+ * mantissa and the power of ten are both exact doubles, a single multiplication or division gives the correctly
+ * rounded result. The digits are read 8 at a time with SWAR (SIMD within a register) arithmetic on 64-bit words. */
+
+#include <cerrno>
+#include <cfloat>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include "src/xbt/parse_number.hpp"
+
+namespace simgrid {
+namespace xbt {
+
+namespace {
+/* The powers of ten that are exact doubles */
+const double exact_powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+constexpr int max_exact_power       = 22;
+constexpr uint64_t max_exact_mantissa = uint64_t(1) << 53;
+/* A mantissa of that many digits fits in 64 bits */
+constexpr int max_digits = 19;
+/* The x87 unit rounds twice (to its own precision, then to double), which breaks the fast path */
+constexpr bool fast_path_usable = FLT_EVAL_METHOD == 0;
+
+inline bool is_digit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+/* isspace() in the C locale */
+inline bool is_space(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline uint64_t load_word(const char* p)
+{
+  uint64_t word;
+  memcpy(&word, p, sizeof word);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+/* Whether the 8 characters of the word are all digits */
+inline bool is_eight_digits(uint64_t word)
+{
+  return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+/* The value of 8 digits, the first one in the lowest byte: pairs, then quadruples, then the whole */
+inline uint32_t eight_digits_value(uint64_t word)
+{
+  const uint64_t mask = 0x000000FF000000FF;
+  const uint64_t mul1 = 100 + (1000000ULL << 32);
+  const uint64_t mul2 = 1 + (10000ULL << 32);
+  word -= 0x3030303030303030;
+  word = (word * 10) + (word >> 8);
+  word = (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+  return static_cast<uint32_t>(word);
+}
+
+/* Reads the digits at p into the mantissa, 8 at a time while the mantissa cannot overflow. Leading zeros are not
+ * counted in digits. Returns the position after the digits, and sets *read to their amount. */
+const char* read_digits(const char* p, const char* end, uint64_t* mantissa, int* digits, int* read)
+{
+  const char* start = p;
+  if (*mantissa == 0)
+    while (p < end && *p == '0')
+      p++;
+  while (*digits + 8 <= max_digits && end - p >= 8 && is_eight_digits(load_word(p))) {
+    *mantissa = *mantissa * 100000000 + eight_digits_value(load_word(p));
+    *digits += 8;
+    p += 8;
+  }
+  for (; p < end && is_digit(*p); p++) {
+    if (*mantissa == 0 && *p == '0')
+      continue;
+    if (*digits < max_digits)
+      *mantissa = *mantissa * 10 + (*p - '0');
+    (*digits)++;
+  }
+  *read = p - start;
+  return p;
+}
+
+/* Gives the number (or whatever strtod() accepts) starting at start to strtod(), through a terminated copy unless a
+ * separator within the range already stops it */
+const char* parse_with_strtod(const char* start, const char* end, double* value)
+{
+  const char* stop = start;
+  while (stop < end && *stop != '\0' && not is_space(*stop))
+    stop++;
+  if (stop < end) {
+    char* text_end;
+    *value = strtod(start, &text_end);
+    return text_end;
+  }
+  char buffer[64];
+  std::string copy;
+  const char* text = buffer;
+  if (stop - start < static_cast<ptrdiff_t>(sizeof buffer)) {
+    memcpy(buffer, start, stop - start);
+    buffer[stop - start] = '\0';
+  } else {
+    copy.assign(start, stop);
+    text = copy.c_str();
+  }
+  char* text_end;
+  *value = strtod(text, &text_end);
+  return start + (text_end - text);
+}
+}
+
+const char* parse_double(const char* begin, const char* end, double* value)
+{
+  const char* p = begin;
+  while (p < end && is_space(*p))
+    p++;
+  const char* start = p;
+
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    p++;
+  }
+  /* Not a plain decimal number (hexadecimal, infinity, NaN or nothing at all) */
+  if (p == end || (*p == '0' && end - p > 1 && (p[1] == 'x' || p[1] == 'X')) || not(is_digit(*p) || *p == '.')) {
+    const char* res = parse_with_strtod(start, end, value);
+    return res == start ? begin : res;
+  }
+
+  uint64_t mantissa = 0;
+  int digits        = 0;
+  int integer_digits;
+  int fraction_digits = 0;
+  int exponent        = 0;
+  p = read_digits(p, end, &mantissa, &digits, &integer_digits);
+  if (p < end && *p == '.') {
+    p = read_digits(p + 1, end, &mantissa, &digits, &fraction_digits);
+    /* Each digit after the dot divides by 10, including the zeros skipped before the first significant digit */
+    exponent = -fraction_digits;
+  }
+  if (integer_digits == 0 && fraction_digits == 0) { // "." or "-." alone
+    *value = 0.0;
+    return begin;
+  }
+  if (digits > max_digits)
+    return parse_with_strtod(start, end, value);
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char* q       = p + 1;
+    bool negative_power = false;
+    if (q < end && (*q == '+' || *q == '-')) {
+      negative_power = *q == '-';
+      q++;
+    }
+    if (q < end && is_digit(*q)) {
+      int power = 0;
+      for (; q < end && is_digit(*q); q++)
+        if (power < 100000)
+          power = power * 10 + (*q - '0');
+      exponent += negative_power ? -power : power;
+      p = q;
+    }
+  }
+
+  if (mantissa == 0) {
+    *value = negative ? -0.0 : 0.0;
+    return p;
+  }
+  if (not fast_path_usable || mantissa > max_exact_mantissa || exponent < -max_exact_power ||
+      exponent > max_exact_power)
+    return parse_with_strtod(start, end, value);
+
+  double res = static_cast<double>(mantissa);
+  if (exponent < 0)
+    res /= exact_powers[-exponent];
+  else
+    res *= exact_powers[exponent];
+  *value = negative ? -res : res;
+  return p;
+}
+
+const char* parse_integer(const char* begin, const char* end, long long* value)
+{
+  const char* p = begin;
+  while (p < end && is_space(*p))
+    p++;
+  bool negative = false;
+  if (p < end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    p++;
+  }
+  if (p == end || not is_digit(*p)) {
+    *value = 0;
+    return begin;
+  }
+
+  /* Up to 18 digits cannot overflow: read them 8 at a time */
+  uint64_t magnitude = 0;
+  int digits         = 0;
+  while (*p == '0' && p + 1 < end && is_digit(p[1]))
+    p++;
+  while (digits + 8 <= 18 && end - p >= 8 && is_eight_digits(load_word(p))) {
+    magnitude = magnitude * 100000000 + eight_digits_value(load_word(p));
+    digits += 8;
+    p += 8;
+  }
+  const uint64_t limit = negative ? static_cast<uint64_t>(LLONG_MAX) + 1 : static_cast<uint64_t>(LLONG_MAX);
+  bool overflow        = false;
+  for (; p < end && is_digit(*p); p++) {
+    unsigned digit = *p - '0';
+    if (overflow || magnitude > (limit - digit) / 10)
+      overflow = true;
+    else
+      magnitude = magnitude * 10 + digit;
+  }
+
+  if (overflow) {
+    errno  = ERANGE;
+    *value = negative ? LLONG_MIN : LLONG_MAX;
+  } else if (negative) {
+    *value = magnitude == static_cast<uint64_t>(LLONG_MAX) + 1 ? LLONG_MIN : -static_cast<long long>(magnitude);
+  } else {
+    *value = static_cast<long long>(magnitude);
+  }
+  return p;
+}
+}
+}
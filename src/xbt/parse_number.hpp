@@ -0,0 +1,43 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_PARSE_NUMBER_HPP
+#define SIMGRID_XBT_PARSE_NUMBER_HPP
+
+#include <cstring>
+
+#include <xbt/base.h>
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief Parses the number at the beginning of [begin, end), as strtod() does
+ *
+ *  Leading white spaces are skipped, and the result is correctly rounded. The plain decimal numbers of at most 19
+ *  significant digits and whose exponent is small enough are parsed directly, reading the digits 8 at a time when
+ *  possible. The other inputs (longer or larger numbers, hexadecimal ones, infinities, NaNs) are given to strtod().
+ *
+ *  @return the position after the number (where a unit may follow), or begin if there is no number, in which case
+ *  value is 0. errno is set to ERANGE on overflow or underflow, as strtod() does, and left untouched otherwise.
+ */
+XBT_PUBLIC(const char*) parse_double(const char* begin, const char* end, double* value);
+inline const char* parse_double(const char* str, double* value)
+{
+  return parse_double(str, str + strlen(str), value);
+}
+
+/** @brief Parses the decimal integer at the beginning of [begin, end), as strtoll(..., 10) does
+ *
+ *  @return the position after the number, or begin if there is no number. errno is set to ERANGE on overflow.
+ */
+XBT_PUBLIC(const char*) parse_integer(const char* begin, const char* end, long long* value);
+inline const char* parse_integer(const char* str, long long* value)
+{
+  return parse_integer(str, str + strlen(str), value);
+}
+}
+}
+
+#endif
@@ -0,0 +1,55 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <string>
+
+#include "src/xbt/pool.hpp"
+#include "xbt/backtrace.hpp"
+#include "xbt/log.h"
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(xbt_pool, xbt, "Pools of objects");
+
+namespace simgrid {
+namespace xbt {
+
+static std::atomic<Pool*> all_pools{nullptr};
+
+Pool::Pool(const char* name, size_t block_size, pvoid_f_void_t new_f)
+    : name_(name), block_size_(block_size), mallocator_(xbt_mallocator_new(16384, new_f, xbt_free_f, nullptr))
+{
+  next_ = all_pools.load();
+  while (not all_pools.compare_exchange_weak(next_, this))
+    ;
+}
+
+void* Pool::allocate()
+{
+  void* block = xbt_mallocator_get(mallocator_);
+  allocations_.fetch_add(1, std::memory_order_relaxed);
+  size_t in_use     = in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+  size_t high_water = high_water_.load(std::memory_order_relaxed);
+  while (in_use > high_water && not high_water_.compare_exchange_weak(high_water, in_use, std::memory_order_relaxed))
+    ;
+  return block;
+}
+
+void Pool::release(void* block)
+{
+  in_use_.fetch_sub(1, std::memory_order_relaxed);
+  xbt_mallocator_release(mallocator_, block);
+}
+
+void Pool::report()
+{
+  if (not XBT_LOG_ISENABLED(xbt_pool, xbt_log_priority_verbose))
+    return;
+  for (Pool* pool = all_pools.load(); pool != nullptr; pool = pool->next_) {
+    auto name = simgrid::xbt::demangle(pool->name());
+    XBT_VERB("%s: %zu objects of %zu bytes in use at most, %llu allocations, %zu still in use", name.get(),
+             pool->high_water(), pool->block_size(), pool->allocations(), pool->in_use());
+  }
+}
+}
+}
@@ -0,0 +1,91 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_POOL_HPP
+#define SIMGRID_XBT_POOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <typeinfo>
+
+#include <xbt/base.h>
+#include <xbt/function_types.h>
+#include <xbt/mallocator.h>
+#include <xbt/sysdep.h>
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief A pool of memory blocks of a given size, recycled through a mallocator
+ *
+ *  The blocks are kept in an xbt_mallocator, so the pool is protected against concurrent accesses when the contexts
+ *  are parallel, and disabled when the model-checker is active. It also counts the blocks in use, to report how many
+ *  of them were in use at most.
+ *
+ *  The pools are never destroyed, since the objects they hold may be freed after the end of main().
+ */
+class XBT_PRIVATE Pool {
+public:
+  Pool(const char* name, size_t block_size, pvoid_f_void_t new_f);
+  Pool(Pool const&) = delete;
+  Pool& operator=(Pool const&) = delete;
+
+  void* allocate();
+  void release(void* block);
+
+  const char* name() const { return name_; }
+  size_t block_size() const { return block_size_; }
+  size_t in_use() const { return in_use_.load(std::memory_order_relaxed); }
+  size_t high_water() const { return high_water_.load(std::memory_order_relaxed); }
+  unsigned long long allocations() const { return allocations_.load(std::memory_order_relaxed); }
+
+  /** Logs the high-water mark of every pool (in verbose mode) */
+  static void report();
+
+private:
+  const char* name_;
+  size_t block_size_;
+  xbt_mallocator_t mallocator_;
+  std::atomic<size_t> in_use_{0};
+  std::atomic<size_t> high_water_{0};
+  std::atomic<unsigned long long> allocations_{0};
+  Pool* next_ = nullptr; // All the pools, for the report
+};
+
+/** @brief Allocates the instances of T out of a pool dedicated to that type
+ *
+ *  Inherit from it to make `new T` and `delete` recycle the memory of the deleted instances:
+ *
+ *  @code{.cpp}
+ *  class CommImpl : public ActivityImpl, public simgrid::xbt::PoolAllocated<CommImpl> { ... };
+ *  @endcode
+ *
+ *  Subclasses of T that are bigger than T inherit the operators, but they are allocated with the global operator new.
+ */
+template <class T> class PoolAllocated {
+public:
+  static void* operator new(size_t size)
+  {
+    return size == sizeof(T) ? pool().allocate() : ::operator new(size);
+  }
+  static void operator delete(void* object, size_t size)
+  {
+    if (size == sizeof(T))
+      pool().release(object);
+    else
+      ::operator delete(object);
+  }
+
+  static Pool& pool()
+  {
+    static Pool* pool = new Pool(typeid(T).name(), sizeof(T), []() -> void* { return xbt_malloc(sizeof(T)); });
+    return *pool;
+  }
+};
+}
+}
+
+#endif
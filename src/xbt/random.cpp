@@ -0,0 +1,169 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Philox4x32-10, from "Parallel Random Numbers: As Easy as 1, 2, 3" (Salmon et al., SC'11). The numbers are the ones
+ * of the reference implementation (Random123), with the block number in the low half of the counter and the id of
+ * the stream in its high half. */
+
+#include <algorithm>
+#include <cmath>
+
+#include "xbt/random.hpp"
+
+namespace simgrid {
+namespace xbt {
+
+namespace {
+constexpr uint32_t multiplier0 = 0xD2511F53;
+constexpr uint32_t multiplier1 = 0xCD9E8D57;
+constexpr uint32_t weyl0       = 0x9E3779B9;
+constexpr uint32_t weyl1       = 0xBB67AE85;
+constexpr unsigned rounds      = 10;
+
+/* Amount of blocks generated together by the bulk functions. With fewer, the compiler unrolls the loops completely
+ * instead of vectorizing them. */
+constexpr unsigned lanes = 32;
+/* Amount of doubles converted at once by the bulk functions */
+constexpr size_t chunk = 256;
+
+/* The block function on consecutive counters, in structure-of-arrays form so that the compiler vectorizes the rounds
+ * (the 32x32->64 multiplications map onto pmuludq and its successors) */
+void philox_lanes(uint64_t block, uint64_t stream, const uint32_t key[2], uint32_t* out)
+{
+  uint32_t c0[lanes];
+  uint32_t c1[lanes];
+  uint32_t c2[lanes];
+  uint32_t c3[lanes];
+  for (unsigned l = 0; l < lanes; l++) {
+    c0[l] = static_cast<uint32_t>(block + l);
+    c1[l] = static_cast<uint32_t>((block + l) >> 32);
+    c2[l] = static_cast<uint32_t>(stream);
+    c3[l] = static_cast<uint32_t>(stream >> 32);
+  }
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  for (unsigned r = 0; r < rounds; r++) {
+    for (unsigned l = 0; l < lanes; l++) {
+      uint64_t p0 = static_cast<uint64_t>(multiplier0) * c0[l];
+      uint64_t p1 = static_cast<uint64_t>(multiplier1) * c2[l];
+      uint32_t n0 = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+      uint32_t n2 = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+      c1[l]       = static_cast<uint32_t>(p1);
+      c3[l]       = static_cast<uint32_t>(p0);
+      c0[l]       = n0;
+      c2[l]       = n2;
+    }
+    k0 += weyl0;
+    k1 += weyl1;
+  }
+  for (unsigned l = 0; l < lanes; l++) {
+    out[4 * l]     = c0[l];
+    out[4 * l + 1] = c1[l];
+    out[4 * l + 2] = c2[l];
+    out[4 * l + 3] = c3[l];
+  }
+}
+}
+
+void RandomStream::philox(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+{
+  uint32_t c0 = counter[0];
+  uint32_t c1 = counter[1];
+  uint32_t c2 = counter[2];
+  uint32_t c3 = counter[3];
+  uint32_t k0 = key[0];
+  uint32_t k1 = key[1];
+  for (unsigned r = 0; r < rounds; r++) {
+    uint64_t p0 = static_cast<uint64_t>(multiplier0) * c0;
+    uint64_t p1 = static_cast<uint64_t>(multiplier1) * c2;
+    c0          = static_cast<uint32_t>(p1 >> 32) ^ c1 ^ k0;
+    c1          = static_cast<uint32_t>(p1);
+    c2          = static_cast<uint32_t>(p0 >> 32) ^ c3 ^ k1;
+    c3          = static_cast<uint32_t>(p0);
+    k0 += weyl0;
+    k1 += weyl1;
+  }
+  out[0] = c0;
+  out[1] = c1;
+  out[2] = c2;
+  out[3] = c3;
+}
+
+/* Writes the count blocks starting at that one */
+void RandomStream::generate(uint64_t block, size_t count, uint32_t* out) const
+{
+  for (; count >= lanes; count -= lanes) {
+    philox_lanes(block, stream_, key_, out);
+    block += lanes;
+    out += 4 * lanes;
+  }
+  for (; count > 0; count--) {
+    uint32_t counter[4] = {static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32),
+                           static_cast<uint32_t>(stream_), static_cast<uint32_t>(stream_ >> 32)};
+    philox(counter, key_, out);
+    block++;
+    out += 4;
+  }
+}
+
+void RandomStream::refill()
+{
+  generate(block_, 1, buffer_);
+  block_++;
+  index_ = 0;
+}
+
+double RandomStream::exponential(double rate)
+{
+  return -std::log1p(-uniform()) / rate;
+}
+
+void RandomStream::skip(uint64_t count)
+{
+  uint64_t target = position() + count;
+  block_          = target / 4;
+  index_          = 4;
+  if (target % 4 != 0) {
+    refill();
+    index_ = target % 4;
+  }
+}
+
+void RandomStream::fill(uint32_t* out, size_t count)
+{
+  for (; count > 0 && index_ < 4; count--)
+    *out++ = buffer_[index_++];
+
+  size_t blocks = count / 4;
+  generate(block_, blocks, out);
+  block_ += blocks;
+  out += 4 * blocks;
+  count -= 4 * blocks;
+
+  for (; count > 0; count--)
+    *out++ = (*this)();
+}
+
+void RandomStream::fill_uniform(double* out, size_t count, double min, double max)
+{
+  uint32_t bits[2 * chunk];
+  while (count > 0) {
+    size_t n = std::min(count, chunk);
+    fill(bits, 2 * n);
+    for (size_t i = 0; i < n; i++)
+      out[i] = min + (max - min) * to_unit((static_cast<uint64_t>(bits[2 * i]) << 32) | bits[2 * i + 1]);
+    out += n;
+    count -= n;
+  }
+}
+
+void RandomStream::fill_exponential(double* out, size_t count, double rate)
+{
+  fill_uniform(out, count);
+  for (size_t i = 0; i < count; i++)
+    out[i] = -std::log1p(-out[i]) / rate;
+}
+}
+}
@@ -0,0 +1,372 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+#include "src/internal_config.h"
+#include "src/xbt/parse_number.hpp"
+#include "src/xbt/replay_binary.hpp"
+#include "xbt/log.h"
+#include "xbt/sysdep.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(replay);
+
+namespace simgrid {
+namespace xbt {
+
+static const char magic[]      = "SGREPLAY";
+static const size_t magic_size = sizeof magic - 1;
+static const uint64_t version  = 1;
+enum Tag : uint64_t { tag_string = 0, tag_integer = 1, tag_real = 2 };
+
+/* Encoding */
+
+static void put_varint(std::string* out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+static uint64_t zigzag(long long value)
+{
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static void put_real(std::string* out, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof bits);
+  for (int i = 0; i < 8; i++)
+    out->push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+}
+
+/* Decoding. The bounds are checked, so that a truncated or corrupted file is reported rather than read past its end */
+
+static uint64_t get_varint(const uint8_t** position, const uint8_t* end, const char* filename)
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*position >= end)
+      xbt_die("Truncated binary trace '%s'", filename);
+    uint8_t byte = *(*position)++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  xbt_die("Corrupted binary trace '%s': invalid varint", filename);
+}
+
+static long long unzigzag(uint64_t value)
+{
+  return static_cast<long long>(value >> 1) ^ -static_cast<long long>(value & 1);
+}
+
+static double get_real(const uint8_t** position, const uint8_t* end, const char* filename)
+{
+  if (end - *position < 8)
+    xbt_die("Truncated binary trace '%s'", filename);
+  uint64_t bits = 0;
+  for (int i = 0; i < 8; i++)
+    bits |= static_cast<uint64_t>((*position)[i]) << (8 * i);
+  *position += 8;
+  double value;
+  memcpy(&value, &bits, sizeof value);
+  return value;
+}
+
+/* Reader */
+
+bool BinaryReplayTrace::is_binary(const char* filename)
+{
+  char header[magic_size];
+  FILE* file = fopen(filename, "rb");
+  if (file == nullptr)
+    return false;
+  bool res = fread(header, 1, magic_size, file) == magic_size && memcmp(header, magic, magic_size) == 0;
+  fclose(file);
+  return res;
+}
+
+BinaryReplayTrace::BinaryReplayTrace(const char* filename) : filename_(filename)
+{
+  XBT_VERB("Prepare to replay binary file '%s'", filename);
+#ifndef _WIN32
+  int fd = open(filename, O_RDONLY);
+  if (fd < 0)
+    xbt_die("Cannot read replay file '%s': %s", filename, strerror(errno));
+  struct stat st;
+  int stat_res = fstat(fd, &st);
+  if (stat_res != 0)
+    xbt_die("Cannot stat replay file '%s': %s", filename, strerror(errno));
+  size_ = st.st_size;
+  if (size_ > 0) {
+    void* map = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED)
+      xbt_die("Cannot map replay file '%s': %s", filename, strerror(errno));
+    madvise(map, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const uint8_t*>(map);
+  }
+  close(fd);
+#else
+  std::ifstream fs(filename, std::ifstream::binary);
+  if (not fs.is_open())
+    xbt_die("Cannot read replay file '%s'", filename);
+  buffer_.assign(std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  const uint8_t* position = data_;
+  const uint8_t* end      = data_ + size_;
+  if (size_ < magic_size || memcmp(data_, magic, magic_size) != 0)
+    xbt_die("'%s' is not a binary trace", filename);
+  position += magic_size;
+  uint64_t file_version = get_varint(&position, end, filename);
+  if (file_version != version)
+    xbt_die("Unsupported version %llu of binary trace '%s'", static_cast<unsigned long long>(file_version), filename);
+
+  uint64_t strings_count = get_varint(&position, end, filename);
+  if (strings_count > static_cast<uint64_t>(end - position)) // Each string takes at least one byte
+    xbt_die("Truncated binary trace '%s'", filename);
+  strings_.reserve(strings_count);
+  for (uint64_t i = 0; i < strings_count; i++) {
+    uint64_t length = get_varint(&position, end, filename);
+    if (static_cast<uint64_t>(end - position) < length)
+      xbt_die("Truncated binary trace '%s'", filename);
+    strings_.emplace_back(reinterpret_cast<const char*>(position), length);
+    position += length;
+  }
+
+  uint64_t actors_count = get_varint(&position, end, filename);
+  if (actors_count > static_cast<uint64_t>(end - position) / 3) // Each stream header takes at least three bytes
+    xbt_die("Truncated binary trace '%s'", filename);
+  streams_.resize(actors_count);
+  std::vector<uint64_t> lengths(actors_count);
+  for (size_t i = 0; i < actors_count; i++) {
+    Stream& stream = streams_[i];
+    stream.trace_  = this;
+    stream.actor_  = string(get_varint(&position, end, filename));
+    stream.size_   = get_varint(&position, end, filename);
+    lengths[i]     = get_varint(&position, end, filename);
+    bool inserted  = actors_.emplace(stream.actor_, i).second;
+    if (not inserted)
+      xbt_die("Actor '%s' has two streams in '%s'", stream.actor_, filename);
+  }
+  for (size_t i = 0; i < actors_count; i++) {
+    if (static_cast<uint64_t>(end - position) < lengths[i])
+      xbt_die("Truncated binary trace '%s'", filename);
+    streams_[i].position_ = position;
+    streams_[i].end_      = position + lengths[i];
+    position += lengths[i];
+  }
+}
+
+BinaryReplayTrace::~BinaryReplayTrace()
+{
+#ifndef _WIN32
+  if (data_ != nullptr)
+    munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+}
+
+const char* BinaryReplayTrace::string(uint64_t id) const
+{
+  if (id >= strings_.size())
+    xbt_die("Corrupted binary trace '%s': invalid string id", filename_.c_str());
+  return strings_[id].c_str();
+}
+
+BinaryReplayTrace::Stream BinaryReplayTrace::stream(std::string const& actor) const
+{
+  auto it = actors_.find(actor);
+  if (it == actors_.end())
+    return Stream();
+  return streams_[it->second];
+}
+
+bool BinaryReplayTrace::Stream::next(ReplayArgs* args)
+{
+  args->clear();
+  if (position_ >= end_)
+    return false;
+
+  const char* filename = trace_->filename_.c_str();
+  args->push_string(actor_);
+  args->push_string(trace_->string(get_varint(&position_, end_, filename)));
+  uint64_t count = get_varint(&position_, end_, filename);
+  for (uint64_t i = 0; i < count; i++) {
+    switch (get_varint(&position_, end_, filename)) {
+      case tag_string:
+        args->push_string(trace_->string(get_varint(&position_, end_, filename)));
+        break;
+      case tag_integer:
+        args->push_int(unzigzag(get_varint(&position_, end_, filename)));
+        break;
+      case tag_real:
+        args->push_double(get_real(&position_, end_, filename));
+        break;
+      default:
+        xbt_die("Corrupted binary trace '%s': invalid argument tag", filename);
+    }
+  }
+  return true;
+}
+
+/* Converters */
+
+/* Integers without leading zero nor plus sign, so that they are written back as they were read */
+static bool parse_integer(std::string const& token, long long* value)
+{
+  const char* digits = token[0] == '-' ? token.c_str() + 1 : token.c_str();
+  if (*digits == '\0' || (digits[0] == '0' && (digits[1] != '\0' || digits != token.c_str())))
+    return false;
+  for (const char* c = digits; *c != '\0'; c++)
+    if (*c < '0' || *c > '9')
+      return false;
+  errno = 0;
+  parse_integer(token.c_str(), token.c_str() + token.size(), value);
+  return errno == 0;
+}
+
+/* Decimal floating-point numbers only: not hexadecimal ones, nor infinities or NaNs */
+static bool parse_real(std::string const& token, double* value)
+{
+  if (token.find_first_not_of("0123456789.eE+-") != std::string::npos)
+    return false;
+  const char* end = token.c_str() + token.size();
+  return parse_double(token.c_str(), end, value) == end && std::isfinite(*value);
+}
+
+struct ActorStream {
+  uint64_t name;
+  size_t count = 0;
+  std::string bytes;
+};
+
+void replay_text_to_binary(const char* input, const char* output)
+{
+  std::ifstream fs(input, std::ifstream::in);
+  if (not fs.is_open())
+    xbt_die("Cannot read replay file '%s'", input);
+
+  std::vector<std::string> strings;
+  FlatMap<std::string, uint64_t> string_ids;
+  auto intern = [&strings, &string_ids](std::string const& str) {
+    auto res = string_ids.emplace(str, strings.size());
+    if (res.second)
+      strings.push_back(str);
+    return res.first->second;
+  };
+  std::vector<ActorStream> actors;
+  FlatMap<uint64_t, size_t> actor_index;
+
+  std::string line;
+  std::vector<std::string> tokens;
+  while (std::getline(fs, line)) {
+    tokens.clear();
+    size_t start = line.find_first_not_of(" \t\r");
+    while (start != std::string::npos) {
+      size_t stop = line.find_first_of(" \t\r", start);
+      tokens.push_back(line.substr(start, stop == std::string::npos ? std::string::npos : stop - start));
+      start = line.find_first_not_of(" \t\r", stop);
+    }
+    if (tokens.empty() || tokens.front()[0] == '#')
+      continue;
+    if (tokens.size() < 2)
+      xbt_die("Action without name in '%s': %s", input, line.c_str());
+
+    uint64_t actor = intern(tokens[0]);
+    auto it        = actor_index.emplace(actor, actors.size()).first;
+    if (it->second == actors.size()) {
+      actors.emplace_back();
+      actors.back().name = actor;
+    }
+    ActorStream& stream = actors[it->second];
+    stream.count++;
+    put_varint(&stream.bytes, intern(tokens[1]));
+    put_varint(&stream.bytes, tokens.size() - 2);
+    for (size_t i = 2; i < tokens.size(); i++) {
+      long long integer;
+      double real;
+      if (parse_integer(tokens[i], &integer)) {
+        put_varint(&stream.bytes, tag_integer);
+        put_varint(&stream.bytes, zigzag(integer));
+      } else if (parse_real(tokens[i], &real)) {
+        put_varint(&stream.bytes, tag_real);
+        put_real(&stream.bytes, real);
+      } else {
+        put_varint(&stream.bytes, tag_string);
+        put_varint(&stream.bytes, intern(tokens[i]));
+      }
+    }
+  }
+
+  std::string header(magic, magic_size);
+  put_varint(&header, version);
+  put_varint(&header, strings.size());
+  for (std::string const& str : strings) {
+    put_varint(&header, str.size());
+    header += str;
+  }
+  put_varint(&header, actors.size());
+  for (ActorStream const& stream : actors) {
+    put_varint(&header, stream.name);
+    put_varint(&header, stream.count);
+    put_varint(&header, stream.bytes.size());
+  }
+
+  FILE* file = fopen(output, "wb");
+  if (file == nullptr)
+    xbt_die("Cannot write binary trace '%s': %s", output, strerror(errno));
+  bool ok = fwrite(header.data(), 1, header.size(), file) == header.size();
+  for (ActorStream const& stream : actors)
+    ok = ok && fwrite(stream.bytes.data(), 1, stream.bytes.size(), file) == stream.bytes.size();
+  ok = (fclose(file) == 0) && ok;
+  if (not ok)
+    xbt_die("Cannot write binary trace '%s': %s", output, strerror(errno));
+}
+
+void replay_binary_to_text(const char* input, const char* output)
+{
+  BinaryReplayTrace trace(input);
+  FILE* file = fopen(output, "w");
+  if (file == nullptr)
+    xbt_die("Cannot write text trace '%s': %s", output, strerror(errno));
+  ReplayArgs args;
+  for (BinaryReplayTrace::Stream stream : trace.streams()) {
+    while (stream.next(&args)) {
+      for (size_t i = 0; i < args.size(); i++) {
+        fputs(args.get_string(i), file);
+        fputc(i + 1 < args.size() ? ' ' : '\n', file);
+      }
+    }
+  }
+  int close_res = fclose(file);
+  if (close_res != 0)
+    xbt_die("Cannot write text trace '%s': %s", output, strerror(errno));
+}
+
+bool replay_is_binary(const char* filename)
+{
+  return BinaryReplayTrace::is_binary(filename);
+}
+}
+}
@@ -0,0 +1,73 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_XBT_REPLAY_BINARY_HPP
+#define SIMGRID_XBT_REPLAY_BINARY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/xbt/flat_map.hpp"
+#include "xbt/replay.hpp"
+
+namespace simgrid {
+namespace xbt {
+
+/** @brief A binary trace, memory-mapped
+ *
+ *  Layout, where the integers are unsigned LEB128 varints unless specified otherwise:
+ *    - the magic "SGREPLAY", then the version (1);
+ *    - the amount of interned strings, then each of them as its length followed by its bytes;
+ *    - the amount of actors, then for each of them the id of its name, its amount of actions and the size of its stream;
+ *    - the streams of all actors, in the same order.
+ *  An action is the id of its name, its amount of arguments, then each argument as a tag followed by its value: an
+ *  interned string id (tag 0), a zigzag-encoded integer (tag 1) or the 8 bytes of a double, little-endian (tag 2).
+ */
+class BinaryReplayTrace {
+public:
+  /** The actions of an actor */
+  class Stream {
+  public:
+    /** Decodes the next action in args, without allocating once args reached its size. Returns false at the end. */
+    bool next(ReplayArgs* args);
+    size_t size() const { return size_; }
+
+  private:
+    friend BinaryReplayTrace;
+    const BinaryReplayTrace* trace_ = nullptr;
+    const uint8_t* position_        = nullptr;
+    const uint8_t* end_             = nullptr;
+    const char* actor_              = nullptr;
+    size_t size_                    = 0;
+  };
+
+  explicit BinaryReplayTrace(const char* filename);
+  ~BinaryReplayTrace();
+  BinaryReplayTrace(BinaryReplayTrace const&) = delete;
+  BinaryReplayTrace& operator=(BinaryReplayTrace const&) = delete;
+
+  static bool is_binary(const char* filename);
+
+  /** The actions of that actor (none if it is not in the trace) */
+  Stream stream(std::string const& actor) const;
+  std::vector<Stream> const& streams() const { return streams_; }
+
+private:
+  std::string filename_;
+  const uint8_t* data_ = nullptr;
+  size_t size_         = 0;
+  std::vector<uint8_t> buffer_; // Where the file is read if it cannot be mapped
+  std::vector<std::string> strings_;
+  std::vector<Stream> streams_;
+  FlatMap<std::string, size_t> actors_; // Index in streams_
+
+  const char* string(uint64_t id) const;
+};
+}
+}
+
+#endif
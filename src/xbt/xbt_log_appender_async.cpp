@@ -0,0 +1,389 @@
+/* async_appender - a log appender writing to a file from a background thread */
+
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Each thread that logs gets its own single-producer single-consumer ring buffer, in which it copies the formatted
+ * messages without taking any lock. A single writer thread drains the rings and writes the messages to their files
+ * through buffered stdio.
+ *
+ * To keep the output in the order in which the messages were emitted (the logs of the actors running in separate
+ * threads must interleave as in synchronous mode), each message takes a number from a global atomic counter, and the
+ * writer outputs them by increasing numbers. A message larger than the ring is streamed through it: it is the next one
+ * to write, so the writer consumes it as it comes.
+ *
+ * The ring of a thread is retired when that thread exits, and freed by the writer once it is drained, so that the
+ * threads coming and going do not pile up rings for the writer to scan.
+ *
+ * Only the thread calling fork() survives in the child, so the backend is flushed and locked before forking, and the
+ * child starts a writer thread of its own (Engine::fork() relies on this to run the branches of a simulation).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "src/xbt/log_private.h"
+#include "xbt/sysdep.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+namespace {
+
+struct Header {
+  uint64_t number;
+  FILE* file;
+  size_t length;
+};
+
+class Ring {
+public:
+  static constexpr size_t capacity = 64 * 1024; // Power of 2
+
+  size_t readable() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_relaxed); }
+
+  /* Producer side: blocks while the ring is full */
+  void push(const void* data, size_t length)
+  {
+    const char* bytes = static_cast<const char*>(data);
+    while (length > 0) {
+      size_t tail = tail_.load(std::memory_order_relaxed);
+      size_t room = capacity - (tail - head_.load(std::memory_order_acquire));
+      if (room == 0) {
+        std::this_thread::yield();
+        continue;
+      }
+      size_t chunk = std::min(room, length);
+      copy_in(tail, bytes, chunk);
+      tail_.store(tail + chunk, std::memory_order_release);
+      bytes += chunk;
+      length -= chunk;
+    }
+  }
+  /* Producer side: the header is published at once, so that the consumer never reads half of it */
+  void push_header(const Header& header)
+  {
+    while (capacity - (tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire)) < sizeof header)
+      std::this_thread::yield();
+    push(&header, sizeof header);
+  }
+
+  /* Consumer side */
+  void peek(void* data, size_t length) const
+  {
+    size_t offset = head_.load(std::memory_order_relaxed) & (capacity - 1);
+    size_t first  = std::min(length, capacity - offset);
+    memcpy(data, buffer_ + offset, first);
+    memcpy(static_cast<char*>(data) + first, buffer_, length - first);
+  }
+  void pop(size_t length) { head_.store(head_.load(std::memory_order_relaxed) + length, std::memory_order_release); }
+  /* Whether the producer is gone and everything it pushed was consumed */
+  bool drained() const { return retired_.load(std::memory_order_acquire) && readable() == 0; }
+  /* Writes at most length readable bytes to the file, and returns how many were written */
+  size_t pop_to(FILE* file, size_t length)
+  {
+    size_t offset = head_.load(std::memory_order_relaxed) & (capacity - 1);
+    size_t count  = std::min(length, readable());
+    size_t first  = std::min(count, capacity - offset);
+    fwrite(buffer_ + offset, 1, first, file);
+    fwrite(buffer_, 1, count - first, file);
+    pop(count);
+    return count;
+  }
+
+  /* Producer side, once it pushed its last message */
+  void retire() { retired_.store(true, std::memory_order_release); }
+
+private:
+  std::atomic<bool> retired_{false};
+  /* Monotonic positions, wrapped on use. The buffer keeps them on separate cache lines. */
+  std::atomic<size_t> head_{0};
+  char buffer_[capacity];
+  std::atomic<size_t> tail_{0};
+
+  void copy_in(size_t position, const char* data, size_t length)
+  {
+    size_t offset = position & (capacity - 1);
+    size_t first  = std::min(length, capacity - offset);
+    memcpy(buffer_ + offset, data, first);
+    memcpy(buffer_, data + first, length - first);
+  }
+};
+
+/* The ring of the current thread, retired when the thread exits. The backend owns the ring too, so that it outlives the
+ * thread until the writer drained it, while the thread never needs the backend to be alive. */
+struct LocalRing {
+  std::shared_ptr<Ring> ring;
+  unsigned generation = 0;
+  ~LocalRing()
+  {
+    if (ring)
+      ring->retire();
+  }
+};
+thread_local LocalRing local;
+
+class Backend {
+public:
+  Backend() : writer_(new std::thread([this] { this->run(); })) {}
+  ~Backend()
+  {
+    stopping_ = true;
+    writer_->join();
+  }
+
+  void append(FILE* file, const char* str)
+  {
+    Ring* ring    = local_ring();
+    Header header = {number_.fetch_add(1, std::memory_order_relaxed), file, strlen(str)};
+    ring->push_header(header);
+    ring->push(str, header.length);
+  }
+
+  /** Waits until every message numbered so far is written, and flushes the files */
+  void flush()
+  {
+    uint64_t target = number_.load();
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_target_ = std::max(flush_target_, target);
+    flushed_cond_.wait(lock, [this, target] { return flushed_ >= target; });
+  }
+
+  /** Before a fork: everything is written, and the writer is kept out of the state that the child copies */
+  void prepare_fork()
+  {
+    flush();
+    mutex_.lock();
+  }
+  void parent_after_fork() { mutex_.unlock(); }
+  /** In the child, where the writer and the other threads do not exist: the rings are empty, the ones of these threads
+   *  are retired, and the writer is to be replaced */
+  void child_after_fork()
+  {
+    for (std::shared_ptr<Ring> const& ring : rings_)
+      if (ring != local.ring)
+        ring->retire();
+    mutex_.unlock();
+    (void)writer_.release(); // Neither joinable nor detachable here
+    writer_.reset(new std::thread([this] { this->run(); }));
+  }
+
+private:
+  static std::atomic<unsigned> generations;
+  /* To detect the thread-local rings of a previous backend */
+  const unsigned generation_ = ++generations;
+
+  std::atomic<uint64_t> number_{0};
+  std::atomic<bool> stopping_{false};
+
+  /* Protected by mutex_. The counters are only increased by the writer. */
+  std::vector<std::shared_ptr<Ring>> rings_;
+  uint64_t written_      = 0;
+  uint64_t flushed_      = 0;
+  uint64_t flush_target_ = 0;
+  std::mutex mutex_;
+  std::condition_variable flushed_cond_;
+
+  /* Only used by the writer */
+  std::vector<FILE*> dirty_files_;
+
+  std::unique_ptr<std::thread> writer_; // Last, to start once the rest is constructed
+
+  Ring* local_ring()
+  {
+    if (not local.ring || local.generation != generation_) {
+      local.ring       = std::make_shared<Ring>();
+      local.generation = generation_;
+      std::lock_guard<std::mutex> lock(mutex_);
+      rings_.push_back(local.ring);
+    }
+    return local.ring.get();
+  }
+
+  void flush_files()
+  {
+    for (FILE* file : dirty_files_)
+      fflush(file);
+    dirty_files_.clear();
+    flushed_ = written_;
+    flushed_cond_.notify_all();
+  }
+
+  /* Returns the ring holding the next message at its head, with the header of that message consumed */
+  Ring* next_message(std::vector<std::shared_ptr<Ring>> const& rings, Header* header)
+  {
+    for (std::shared_ptr<Ring> const& ring : rings) {
+      if (ring->readable() < sizeof *header)
+        continue;
+      ring->peek(header, sizeof *header);
+      if (header->number == written_) {
+        ring->pop(sizeof *header);
+        return ring.get();
+      }
+    }
+    return nullptr;
+  }
+
+  void run()
+  {
+    std::vector<std::shared_ptr<Ring>> rings;
+    Ring* current = nullptr; // Ring of the message being written, if any
+    Header header;
+    unsigned idle = 0;
+
+    while (true) {
+      if (current == nullptr) {
+        current = next_message(rings, &header);
+        if (current != nullptr && std::find(dirty_files_.begin(), dirty_files_.end(), header.file) == dirty_files_.end())
+          dirty_files_.push_back(header.file);
+      }
+      if (current != nullptr) {
+        size_t count = current->pop_to(header.file, header.length);
+        header.length -= count;
+        if (header.length == 0) {
+          current = nullptr;
+          std::lock_guard<std::mutex> lock(mutex_);
+          written_++;
+          if (flushed_ < flush_target_ && written_ >= flush_target_)
+            flush_files();
+        }
+        if (count > 0 || current == nullptr) {
+          idle = 0;
+          continue;
+        }
+      }
+
+      /* Nothing to write: catch up with the new rings, free the drained ones, flush the files, and wait a bit longer
+       * each time */
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rings_.erase(std::remove_if(rings_.begin(), rings_.end(),
+                                    [current](std::shared_ptr<Ring> const& ring) {
+                                      return ring.get() != current && ring->drained();
+                                    }),
+                     rings_.end());
+        rings = rings_;
+        if (current == nullptr && written_ == number_.load()) {
+          if (flushed_ < written_)
+            flush_files();
+          if (stopping_)
+            return;
+        }
+      }
+      if (idle < 16)
+        std::this_thread::yield();
+      else
+        std::this_thread::sleep_for(std::chrono::microseconds(idle < 64 ? 10 : 500));
+      idle++;
+    }
+  }
+};
+
+std::atomic<unsigned> Backend::generations{0};
+
+/* The backend is shared by all the async appenders, and lives as long as one of them */
+std::mutex backend_mutex;
+Backend* backend      = nullptr;
+unsigned backend_refs = 0;
+
+void flush_at_exit()
+{
+  xbt_log_flush();
+}
+
+#ifndef _WIN32
+void prepare_fork()
+{
+  backend_mutex.lock();
+  if (backend != nullptr)
+    backend->prepare_fork();
+}
+void parent_after_fork()
+{
+  if (backend != nullptr)
+    backend->parent_after_fork();
+  backend_mutex.unlock();
+}
+void child_after_fork()
+{
+  if (backend != nullptr)
+    backend->child_after_fork();
+  backend_mutex.unlock();
+}
+#endif
+
+struct AsyncFile {
+  FILE* file;
+};
+
+void append_async(xbt_log_appender_t this_, char* str)
+{
+  backend->append(static_cast<AsyncFile*>(this_->data)->file, str);
+}
+
+void free_async(xbt_log_appender_t this_)
+{
+  AsyncFile* data = static_cast<AsyncFile*>(this_->data);
+  {
+    std::lock_guard<std::mutex> lock(backend_mutex);
+    backend->flush();
+    if (--backend_refs == 0) {
+      delete backend;
+      backend = nullptr;
+    }
+  }
+  if (data->file != stderr)
+    fclose(data->file);
+  delete data;
+}
+}
+
+/** Writes to the file (or stderr if arg is NULL) from a background thread */
+xbt_log_appender_t xbt_log_appender_async_new(char* arg)
+{
+  FILE* file = stderr;
+  if (arg) {
+    file = fopen(arg, "w");
+    xbt_assert(file, "Cannot open the log file '%s'", arg);
+  }
+
+  std::lock_guard<std::mutex> lock(backend_mutex);
+  if (backend_refs++ == 0)
+    backend = new Backend();
+  /* Registered after the one of xbt, so called before it: the messages of the appenders that outlive the cleanup of
+   * the library (e.g., with --cfg=clean-atexit:no) are written anyway */
+  static bool flush_registered = false;
+  if (not flush_registered) {
+    atexit(flush_at_exit);
+#ifndef _WIN32
+    pthread_atfork(prepare_fork, parent_after_fork, child_after_fork);
+#endif
+    flush_registered = true;
+  }
+
+  xbt_log_appender_t res = xbt_new0(s_xbt_log_appender_t, 1);
+  res->do_append         = &append_async;
+  res->free_             = &free_async;
+  res->data              = new AsyncFile{file};
+  return res;
+}
+
+void xbt_log_flush()
+{
+  std::lock_guard<std::mutex> lock(backend_mutex);
+  if (backend != nullptr)
+    backend->flush();
+}
@@ -155,6 +155,8 @@ void xbt_free_ref(void *d)
 /** @brief Kill the program in silence */
 void xbt_abort()
 {
+  /* Write the last words of the program, such as the message of xbt_die() */
+  xbt_log_flush();
 #ifdef COVERAGE
   /* Call __gcov_flush on abort when compiling with coverage options. */
   extern void __gcov_flush();
@@ -4,12 +4,28 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include "simgrid/modelchecker.h"
+#include "src/xbt/flat_map.hpp"
+#include "src/xbt/parse_number.hpp"
+#include "src/xbt/replay_binary.hpp"
 #include "xbt/ex.hpp"
 #include "xbt/log.h"
 #include "xbt/replay.hpp"
+#include "xbt/str.h"
 
 #include <boost/algorithm/string.hpp>
 
+#include <cerrno>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(replay,xbt,"Replay trace reader");
 
 namespace simgrid {
@@ -17,6 +33,98 @@ namespace xbt {
 
 std::ifstream* action_fs = nullptr;
 std::unordered_map<std::string, action_fun> action_funs;
+static std::unordered_map<std::string, replay_fun> typed_action_funs;
+/* The trace shared by all actors, if it is a binary one */
+static BinaryReplayTrace* shared_binary_trace = nullptr;
+
+ReplayArgs::Field const& ReplayArgs::field(size_t i) const
+{
+  if (i >= fields_.size())
+    THROWF(arg_error, 0, "Action '%s' has no argument #%zu", fields_.size() > 1 ? name() : "", i);
+  return fields_[i];
+}
+
+const char* ReplayArgs::get_string(size_t i) const
+{
+  Field const& f = field(i);
+  switch (f.kind) {
+    case Kind::integer:
+      snprintf(f.text, sizeof f.text, "%lld", f.integer);
+      return f.text;
+    case Kind::real:
+      /* The shortest representation that reads back as the same value */
+      if (f.real == std::floor(f.real) && std::fabs(f.real) < 1e15) {
+        snprintf(f.text, sizeof f.text, "%.0f", f.real);
+      } else {
+        for (int precision = 1; precision <= 17; precision++) {
+          snprintf(f.text, sizeof f.text, "%.*g", precision, f.real);
+          if (strtod(f.text, nullptr) == f.real)
+            break;
+        }
+      }
+      return f.text;
+    default:
+      return f.string;
+  }
+}
+
+double ReplayArgs::get_double(size_t i) const
+{
+  Field const& f = field(i);
+  switch (f.kind) {
+    case Kind::integer:
+      return static_cast<double>(f.integer);
+    case Kind::real:
+      return f.real;
+    default:
+      return xbt_str_parse_double(f.string, "%s is not a double");
+  }
+}
+
+long long ReplayArgs::get_int(size_t i) const
+{
+  Field const& f = field(i);
+  switch (f.kind) {
+    case Kind::integer:
+      return f.integer;
+    case Kind::real:
+      if (f.real != std::floor(f.real))
+        THROWF(arg_error, 0, "%s is not an integer", get_string(i));
+      return static_cast<long long>(f.real);
+    default: {
+      /* Accept the integers written as reals (e.g., 1e9), as the binary traces do */
+      long long res;
+      errno = 0;
+      if (f.string[0] != '\0' && *parse_integer(f.string, &res) == '\0' && errno == 0)
+        return res;
+      double real = xbt_str_parse_double(f.string, "%s is not an integer");
+      if (real != std::floor(real))
+        THROWF(arg_error, 0, "%s is not an integer", f.string);
+      return static_cast<long long>(real);
+    }
+  }
+}
+
+void ReplayArgs::push_string(const char* value)
+{
+  fields_.emplace_back();
+  fields_.back().kind   = Kind::string;
+  fields_.back().string = value;
+}
+
+void ReplayArgs::push_int(long long value)
+{
+  fields_.emplace_back();
+  fields_.back().kind    = Kind::integer;
+  fields_.back().integer = value;
+}
+
+void ReplayArgs::push_double(double value)
+{
+  fields_.emplace_back();
+  fields_.back().kind = Kind::real;
+  fields_.back().real = value;
+}
 
 static void read_and_trim_line(std::ifstream* fs, std::string* line)
 {
@@ -53,73 +161,259 @@ bool ReplayReader::get(ReplayAction* action)
   return not fs->eof();
 }
 
-static ReplayAction* get_action(char* name)
-{
-  ReplayAction* action;
+/** @brief Demultiplexes the trace shared by all actors into per-actor queues, ahead of their consumption
+ *
+ *  A background thread reads the file, splits each line in place (its fields separated by '\0' characters) and
+ *  appends it to the queue of its actor. The actors are numbered in the order in which they appear in the file (or
+ *  start replaying), so that they look their name up only once.
+ *
+ *  The thread waits while the queue it appends to is full, which bounds the amount of lines read ahead. It does not
+ *  wait while an actor waits for its next line: the trace may list many actions of an actor before the one that
+ *  another actor needs to progress (e.g., the send matching a recv), and they must be stored anyway.
+ *
+ *  An actor that finds its queue empty reads the file itself if the thread is not reading it, instead of waiting for
+ *  the thread to get a core. Under the model checker, there is no thread: the actors read the file in any case.
+ */
+class SharedTextTrace {
+public:
+  static constexpr size_t queue_capacity = 1024; // Lines read ahead for each actor
+  static constexpr size_t npos           = SIZE_MAX;
 
-  std::queue<ReplayAction*>* myqueue = nullptr;
-  if (action_queues.find(std::string(name)) != action_queues.end())
-    myqueue = action_queues.at(std::string(name));
-  if (myqueue == nullptr || myqueue->empty()) { // Nothing stored for me. Read the file further
-    // Read lines until I reach something for me (which breaks in loop body) or end of file reached
-    while (true) {
-      std::string action_line;
-      read_and_trim_line(action_fs, &action_line);
-      if (action_fs->eof())
-        break;
-      /* we cannot split in place here because we parse&store several lines for the colleagues... */
-      action = new ReplayAction();
-      boost::split(*action, action_line, boost::is_any_of(" \t"), boost::token_compress_on);
-
-      // if it's for me, I'm done
-      std::string evtname = action->front();
-      if (evtname.compare(name) == 0) {
-        return action;
+  explicit SharedTextTrace(std::ifstream* fs) : fs_(fs)
+  {
+    if (not MC_is_active())
+      reader_ = std::thread([this] { this->read_all(); });
+  }
+  ~SharedTextTrace()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    space_.notify_one();
+    if (reader_.joinable())
+      reader_.join();
+    for (Queue* queue : queues_)
+      delete queue;
+  }
+
+  std::ifstream* file() const { return fs_; }
+
+  void warn_unconsumed()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bool warned = false;
+    for (auto const& actor : ids_) {
+      size_t count = queues_[actor.second]->lines.size();
+      if (count == 0)
+        continue;
+      if (not warned)
+        XBT_WARN("Not all actions got consumed. If the simulation ended successfully (without deadlock),"
+                 " you may want to add new processes to your deployment file.");
+      warned = true;
+      XBT_WARN("Still %zu actions for %s", count, actor.first.c_str());
+    }
+  }
+
+  /** Returns the id of that actor */
+  size_t subscribe(const char* actor)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_++;
+    return id(actor);
+  }
+  void unsubscribe()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--subscribers_ == 0 && eof_ && reader_.joinable()) // The thread is done: do not wait for the destructor
+      reader_.join();
+  }
+
+  /** Moves the next line of that actor in line, or returns false at the end of the file */
+  bool next(size_t id, std::string* line)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Queue& queue = *queues_[id];
+    while (queue.lines.empty() && not eof_) {
+      lock.unlock();
+      std::unique_lock<std::mutex> reading(reading_, std::try_to_lock);
+      if (reading.owns_lock()) { // Nobody is reading: do it rather than waiting for the thread to get the CPU
+        size_t actor;
+        do {
+          actor = read_line(false);
+        } while (actor != id && actor != npos);
+        reading.unlock();
+        lock.lock();
       } else {
-        // Else, I have to store it for the relevant colleague
-        std::queue<ReplayAction*>* otherqueue = nullptr;
-        if (action_queues.find(evtname) != action_queues.end())
-          otherqueue = action_queues.at(evtname);
-        else { // Damn. Create the queue of that guy
-          otherqueue = new std::queue<ReplayAction*>();
-          action_queues.insert({evtname, otherqueue});
-        }
-        otherqueue->push(action);
+        lock.lock();
+        starving_++;
+        space_.notify_one();
+        queue.available.wait(lock, [this, &queue] { return not queue.lines.empty() || eof_; });
+        starving_--;
       }
     }
-    // end of file reached while searching in vain for more work
-  } else {
-    // Get something from my queue and return it
-    action = myqueue->front();
-    myqueue->pop();
-    return action;
+    if (queue.lines.empty())
+      return false;
+    line->swap(queue.lines.front());
+    queue.lines.pop_front();
+    if (id == blocked_ && queue.lines.size() < queue_capacity)
+      space_.notify_one();
+    return true;
+  }
+
+private:
+  struct Queue {
+    std::deque<std::string> lines;
+    std::condition_variable available;
+  };
+
+  std::ifstream* fs_;
+  std::thread reader_;
+
+  /* Protected by mutex_ */
+  FlatMap<std::string, size_t> ids_;
+  std::vector<Queue*> queues_;
+  std::string actor_; // Key of the lookups, to keep its capacity
+  unsigned subscribers_ = 0;
+  unsigned starving_    = 0;    // Amount of actors waiting for their next line
+  size_t blocked_       = npos; // Queue that the thread waits to append to
+  bool eof_             = false;
+  bool stopping_        = false;
+  std::mutex mutex_;
+  std::condition_variable space_;
+
+  /* The thread or an actor reads the file while holding reading_ */
+  std::mutex reading_;
+  std::string line_;
+
+  size_t id(const char* actor)
+  {
+    actor_ = actor;
+    auto it = ids_.find(actor_);
+    if (it != ids_.end())
+      return it->second;
+    queues_.push_back(new Queue());
+    ids_.emplace(actor_, queues_.size() - 1);
+    return queues_.size() - 1;
+  }
+
+  /* Reads a line, and appends it to the queue of its actor (waiting for some room if asked to). Returns the id of the
+   * actor, or npos at the end of the file or when stopping. reading_ must be held. */
+  size_t read_line(bool may_wait)
+  {
+    if (eof_) // Only modified by the readers
+      return npos;
+    read_and_trim_line(fs_, &line_);
+    if (fs_->eof()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      eof_ = true;
+      for (Queue* queue : queues_)
+        queue->available.notify_one();
+      return npos;
+    }
+
+    /* Separate the fields by a single '\0' (the line is already trimmed) */
+    size_t length = 0;
+    for (size_t i = 0; i < line_.size(); i++) {
+      if (line_[i] != ' ' && line_[i] != '\t')
+        line_[length++] = line_[i];
+      else if (length > 0 && line_[length - 1] != '\0')
+        line_[length++] = '\0';
+    }
+    line_.resize(length);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t actor = id(line_.c_str());
+    Queue& queue = *queues_[actor];
+    if (may_wait && queue.lines.size() >= queue_capacity) {
+      blocked_ = actor;
+      space_.wait(lock, [this, &queue] { return queue.lines.size() < queue_capacity || starving_ > 0 || stopping_; });
+      blocked_ = npos;
+    }
+    queue.lines.push_back(std::move(line_));
+    queue.available.notify_one();
+    return stopping_ ? npos : actor;
+  }
+
+  void read_all()
+  {
+    while (true) {
+      std::lock_guard<std::mutex> reading(reading_);
+      if (read_line(true) == npos)
+        return;
+    }
+  }
+};
+
+/* The demultiplexer of action_fs, created by the first actor that replays it */
+static SharedTextTrace* shared_text_trace = nullptr;
+static std::mutex shared_text_trace_mutex;
+
+static SharedTextTrace* get_shared_text_trace()
+{
+  std::lock_guard<std::mutex> lock(shared_text_trace_mutex);
+  if (shared_text_trace == nullptr || shared_text_trace->file() != action_fs) {
+    delete shared_text_trace;
+    shared_text_trace = new SharedTextTrace(action_fs);
   }
-  return nullptr;
+  return shared_text_trace;
 }
 
-static void handle_action(ReplayAction* action)
+void replay_open(const char* filename)
 {
-  XBT_DEBUG("%s replays a %s action", action->at(0).c_str(), action->at(1).c_str());
-  char** c_action     = new char*[action->size() + 1];
-  action_fun function = action_funs.at(action->at(1));
-  int i               = 0;
-  for (auto arg : *action) {
-    c_action[i] = xbt_strdup(arg.c_str());
-    i++;
+  if (BinaryReplayTrace::is_binary(filename))
+    shared_binary_trace = new BinaryReplayTrace(filename);
+  else
+    action_fs = new std::ifstream(filename, std::ifstream::in);
+}
+
+void replay_close()
+{
+  if (shared_text_trace) {
+    shared_text_trace->warn_unconsumed();
+    delete shared_text_trace;
+    shared_text_trace = nullptr;
   }
-  c_action[i] = nullptr;
+  delete shared_binary_trace;
+  shared_binary_trace = nullptr;
+  delete action_fs;
+  action_fs = nullptr;
+}
+
+void replay_action_register(const char* action_name, replay_fun function)
+{
+  action_funs.erase(action_name);
+  typed_action_funs[action_name] = function;
+}
+
+/* c_action is only there to keep its capacity from an action to the other */
+static void handle_action(ReplayArgs const& args, std::vector<const char*>* c_action)
+{
+  XBT_DEBUG("%s replays a %s action", args.actor(), args.name());
   try {
-    function(c_action);
+    auto typed = typed_action_funs.find(args.name());
+    if (typed != typed_action_funs.end()) {
+      typed->second(args);
+    } else {
+      /* The callbacks do not modify their arguments, so they get the fields without copy */
+      action_fun function = action_funs.at(args.name());
+      c_action->clear();
+      for (size_t i = 0; i < args.size(); i++)
+        c_action->push_back(args.get_string(i));
+      c_action->push_back(nullptr);
+      function(c_action->data());
+    }
   } catch (xbt_ex& e) {
-    for (unsigned int j = 0; j < action->size(); j++)
-      xbt_free(c_action[j]);
-    delete[] c_action;
-    action->clear();
     xbt_die("Replay error:\n %s", e.what());
   }
-  for (unsigned int j = 0; j < action->size(); j++)
-    xbt_free(c_action[j]);
-  delete[] c_action;
+}
+
+static void handle_action(ReplayAction* action, ReplayArgs* args, std::vector<const char*>* c_action)
+{
+  args->clear();
+  for (std::string const& field : *action)
+    args->push_string(field.c_str());
+  handle_action(*args, c_action);
 }
 
 /**
@@ -128,28 +422,41 @@ static void handle_action(ReplayAction* action)
  */
 int replay_runner(int argc, char* argv[])
 {
-  if (simgrid::xbt::action_fs) { // A unique trace file
-    while (true) {
-      simgrid::xbt::ReplayAction* evt = simgrid::xbt::get_action(argv[0]);
-      if (evt == nullptr)
-        break;
-      simgrid::xbt::handle_action(evt);
-      delete evt;
-    }
-    if (action_queues.find(std::string(argv[0])) != action_queues.end()) {
-      std::queue<ReplayAction*>* myqueue = action_queues.at(std::string(argv[0]));
-      delete myqueue;
-      action_queues.erase(std::string(argv[0]));
+  ReplayArgs args;
+  std::vector<const char*> c_action;
+  if (shared_binary_trace) { // A unique binary trace file: each actor has its own stream
+    BinaryReplayTrace::Stream stream = shared_binary_trace->stream(argv[0]);
+    while (stream.next(&args))
+      handle_action(args, &c_action);
+  } else if (simgrid::xbt::action_fs) { // A unique trace file, read ahead in the background
+    SharedTextTrace* trace = get_shared_text_trace();
+    size_t id              = trace->subscribe(argv[0]);
+    std::string line;
+    while (trace->next(id, &line)) {
+      args.clear();
+      for (const char* field = line.c_str(); field < line.c_str() + line.size(); field += strlen(field) + 1)
+        args.push_string(field);
+      simgrid::xbt::handle_action(args, &c_action);
     }
+    trace->unsubscribe();
   } else { // Should have got my trace file in argument
-    simgrid::xbt::ReplayAction* evt = new simgrid::xbt::ReplayAction();
     xbt_assert(argc >= 2, "No '%s' agent function provided, no simulation-wide trace file provided, "
                           "and no process-wide trace file provided in deployment file. Aborting.",
                argv[0]);
+    if (BinaryReplayTrace::is_binary(argv[1])) {
+      BinaryReplayTrace trace(argv[1]);
+      BinaryReplayTrace::Stream stream = trace.stream(argv[0]);
+      if (trace.streams().size() > (stream.size() > 0 ? 1U : 0U))
+        XBT_WARN("Ignore the trace elements not for me");
+      while (stream.next(&args))
+        handle_action(args, &c_action);
+      return 0;
+    }
+    simgrid::xbt::ReplayAction* evt = new simgrid::xbt::ReplayAction();
     simgrid::xbt::ReplayReader* reader = new simgrid::xbt::ReplayReader(argv[1]);
     while (reader->get(evt)) {
       if (evt->front().compare(argv[0]) == 0) {
-        simgrid::xbt::handle_action(evt);
+        simgrid::xbt::handle_action(evt, &args, &c_action);
       } else {
         XBT_WARN("Ignore trace element not for me");
       }
@@ -177,6 +484,7 @@ int replay_runner(int argc, char* argv[])
  */
 void xbt_replay_action_register(const char* action_name, action_fun function)
 {
+  simgrid::xbt::typed_action_funs.erase(action_name);
   simgrid::xbt::action_funs.insert({std::string(action_name), function});
 }
 
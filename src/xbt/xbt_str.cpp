@@ -10,6 +10,9 @@
 #include "xbt/misc.h"
 #include "xbt/sysdep.h"
 #include "xbt/str.h"            /* headers of these functions */
+#include "src/xbt/parse_number.hpp"
+
+#include <climits>
 
 /**  @brief Strip whitespace (or other characters) from the end of a string.
  *
@@ -435,15 +438,19 @@ char *xbt_str_join_array(const char *const *strs, const char *sep)
  */
 long int xbt_str_parse_int(const char* str, const char* error_msg)
 {
-  char* endptr;
   if (str == nullptr || str[0] == '\0')
     THROWF(arg_error, 0, error_msg, str);
 
-  long int res = strtol(str, &endptr, 10);
-  if (endptr[0] != '\0')
+  long long res;
+  if (simgrid::xbt::parse_integer(str, &res)[0] != '\0')
     THROWF(arg_error, 0, error_msg, str);
 
-  return res;
+  /* Saturate as strtol() does where long is narrower */
+  if (res > LONG_MAX)
+    return LONG_MAX;
+  if (res < LONG_MIN)
+    return LONG_MIN;
+  return static_cast<long int>(res);
 }
 
 /** @brief Parse a double out of a string, or raise an error
@@ -453,12 +460,11 @@ long int xbt_str_parse_int(const char* str, const char* error_msg)
  */
 double xbt_str_parse_double(const char* str, const char* error_msg)
 {
-  char *endptr;
   if (str == nullptr || str[0] == '\0')
     THROWF(arg_error, 0, error_msg, str);
 
-  double res = strtod(str, &endptr);
-  if (endptr[0] != '\0')
+  double res;
+  if (simgrid::xbt::parse_double(str, &res)[0] != '\0')
     THROWF(arg_error, 0, error_msg, str);
 
   return res;
@@ -551,6 +557,11 @@ XBT_TEST_UNIT("xbt_str_parse", test_parse, "Test the parsing functions")
   test_parse_error(xbt_str_parse_int, "Parse '' as an int", rint, "");
   test_parse_error(xbt_str_parse_int, "Parse cruft as an int", rint, "cruft");
 
+  long rlong = -9999;
+  test_parse_ok(xbt_str_parse_int, "Parse INT_MIN as a long", rlong, "-2147483648", -2147483648L);
+  test_parse_ok(xbt_str_parse_int, "Parse leading zeros as a long", rlong, "000000000000000042", 42);
+  test_parse_error(xbt_str_parse_int, "Parse digits + noise", rlong, "1234567890x");
+
   double rdouble = -9999;
   test_parse_ok(xbt_str_parse_double, "Parse 42 as a double", rdouble, "42", 42);
   test_parse_ok(xbt_str_parse_double, "Parse 42.5 as a double", rdouble, "42.5", 42.5);
@@ -561,5 +572,20 @@ XBT_TEST_UNIT("xbt_str_parse", test_parse, "Test the parsing functions")
   test_parse_error(xbt_str_parse_double, "Parse nullptr as a double", rdouble, nullptr);
   test_parse_error(xbt_str_parse_double, "Parse '' as a double", rdouble, "");
   test_parse_error(xbt_str_parse_double, "Parse cruft as a double", rdouble, "cruft");
+
+  /* The fast path and its fallback must round as the compiler does */
+  test_parse_ok(xbt_str_parse_double, "Parse 0.1 as a double", rdouble, "0.1", 0.1);
+  test_parse_ok(xbt_str_parse_double, "Parse 1e23 as a double", rdouble, "1e23", 1e23);
+  test_parse_ok(xbt_str_parse_double, "Parse 1.25e-3 as a double", rdouble, "1.25e-3", 1.25e-3);
+  test_parse_ok(xbt_str_parse_double, "Parse -.5 as a double", rdouble, "-.5", -.5);
+  test_parse_ok(xbt_str_parse_double, "Parse 2^53+1 as a double", rdouble, "9007199254740993", 9007199254740992.0);
+  test_parse_ok(xbt_str_parse_double, "Parse 30 digits as a double", rdouble, "123456789012345678901234567890",
+                123456789012345678901234567890.0);
+  test_parse_ok(xbt_str_parse_double, "Parse 0.000001234 as a double", rdouble, "0.000001234", 0.000001234);
+  test_parse_ok(xbt_str_parse_double, "Parse the smallest denormal", rdouble, "4.9406564584124654e-324",
+                4.9406564584124654e-324);
+  test_parse_ok(xbt_str_parse_double, "Parse hexadecimal as a double", rdouble, "0x1p4", 16);
+  test_parse_error(xbt_str_parse_double, "Parse a lone dot as a double", rdouble, ".");
+  test_parse_error(xbt_str_parse_double, "Parse an empty exponent as a double", rdouble, "1e");
 }
 #endif                          /* SIMGRID_TEST */
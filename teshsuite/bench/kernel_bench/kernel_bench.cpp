@@ -0,0 +1,311 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Microbenchmarks of the simulation kernel.
+ *
+ * Each run measures one aspect of the kernel, selected on the command line, and prints its results on stdout as CSV
+ * lines (benchmark,metric,value,unit). Durations are given in "us" and sizes in "B" (lower is better) while throughputs
+ * are given in "<something>/s" (higher is better). tools/bench/run_benchmarks.py runs all of them (that's `make bench`),
+ * and tools/bench/compare_benchmarks.py flags the regressions between the results of two builds.
+ *
+ * Each benchmark needs its own process, since the engine cannot be reset.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "simgrid/instr.h"
+#include "simgrid/s4u.hpp"
+#include "simgrid/s4u/NetZone.hpp"
+#include "simgrid/simix.hpp"
+#include "surf/maxmin.h"
+#include "xbt/config.h"
+#include "xbt/xbt_os_time.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(kernel_bench, "Messages specific for this benchmark");
+
+static int size = 0; // The amount of iterations of each benchmark (or actors for the "actors" one)
+
+static void report(const char* benchmark, std::string metric, double value, const char* unit)
+{
+  printf("%s,%s,%.6g,%s\n", benchmark, metric.c_str(), value, unit);
+}
+
+/* Any host of the platform */
+static simgrid::s4u::Host* some_host(unsigned rank)
+{
+  std::vector<simgrid::s4u::Host*> hosts;
+  simgrid::s4u::Engine::instance()->hostList(&hosts);
+  return hosts[rank % hosts.size()];
+}
+
+/* Wall-clock duration of the given amount of runs of the code, in micro-seconds per run */
+template <class F> static double measure(int runs, F code)
+{
+  double start = xbt_os_time();
+  for (int i = 0; i < runs; i++)
+    code();
+  return (xbt_os_time() - start) * 1e6 / runs;
+}
+
+/* context-switch: latency of a round-trip between an actor and maestro, through the configured context factory */
+static void bench_context_switch()
+{
+  static const int actor_count = 10;
+  static double start;
+  static double end = 0;
+  for (int i = 0; i < actor_count; i++)
+    simgrid::s4u::Actor::createActor("switcher", some_host(0), [] {
+      for (int j = 0; j < size; j++)
+        simgrid::simix::kernelImmediate([] { /* do nothing */ });
+      end = xbt_os_time();
+    });
+  start = xbt_os_time();
+  simgrid::s4u::Engine::instance()->run();
+  report("context-switch", xbt_cfg_get_string("contexts/factory"), (end - start) * 1e6 / (actor_count * size), "us");
+}
+
+/* simcalls: round-trip of the simcalls that the actors issue the most, each of them in a loop */
+static void bench_simcalls()
+{
+  simgrid::s4u::Actor::createActor("caller", some_host(0), [] {
+    smx_actor_t self = SIMIX_process_self();
+    report("simcalls", "run_kernel", measure(size, [] { simgrid::simix::kernelImmediate([] {}); }), "us");
+    report("simcalls", "process_is_suspended", measure(size, [self] { simcall_process_is_suspended(self); }), "us");
+    simgrid::s4u::MutexPtr mutex = simgrid::s4u::Mutex::createMutex();
+    report("simcalls", "mutex_lock+unlock", measure(size, [mutex] {
+                                                mutex->lock();
+                                                mutex->unlock();
+                                              }),
+           "us");
+    report("simcalls", "process_sleep", measure(size, [] { simgrid::s4u::this_actor::sleep_for(0.001); }), "us");
+    report("simcalls", "execution_wait", measure(size, [] { simgrid::s4u::this_actor::execute(1000); }), "us");
+  });
+  simgrid::s4u::Engine::instance()->run();
+}
+
+/* comms: creation, matching and completion of asynchronous communications between several pairs of actors */
+static void bench_comms()
+{
+  static const int pair_count = 10;
+  static int payload = 0; // The payload must not be null, but it's never read
+  for (int i = 0; i < pair_count; i++) {
+    simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName(std::string("pair-") + std::to_string(i));
+    simgrid::s4u::Actor::createActor("sender", some_host(i), [mbox] {
+      for (int j = 0; j < size; j++)
+        simgrid::s4u::this_actor::isend(mbox, &payload, 1000)->wait();
+    });
+    simgrid::s4u::Actor::createActor("receiver", some_host(i + 1), [mbox] {
+      void* data;
+      for (int j = 0; j < size; j++)
+        simgrid::s4u::this_actor::irecv(mbox, &data)->wait();
+    });
+  }
+  double start = xbt_os_time();
+  simgrid::s4u::Engine::instance()->run();
+  report("comms", "async_comms", pair_count * size / (xbt_os_time() - start), "comms/s");
+}
+
+/* lmm: resolution of randomly generated systems, with as many constraints as variables. The generator is the one
+ * of teshsuite/surf/maxmin_bench, without the concurrency limits. */
+static unsigned int seed = 42;
+static double float_random(double max)
+{
+  return max * rand_r(&seed) / (RAND_MAX + 1.0);
+}
+
+static void bench_lmm()
+{
+  for (int count : {10, 100, 2000}) {
+    double total  = 0;
+    int runs      = std::max(1, size * 10 / count);
+    for (int run = 0; run < runs; run++) {
+      lmm_system_t sys = lmm_system_new(1);
+      std::vector<lmm_constraint_t> cnsts;
+      std::vector<lmm_variable_t> vars;
+      for (int i = 0; i < count; i++)
+        cnsts.push_back(lmm_constraint_new(sys, nullptr, float_random(10.0)));
+      for (int i = 0; i < count; i++) {
+        vars.push_back(lmm_variable_new(sys, nullptr, 1.0, -1.0, 3));
+        for (int j = 0; j < 3; j++)
+          lmm_expand_add(sys, cnsts[rand_r(&seed) % count], vars.back(), float_random(1.5));
+      }
+      total += measure(1, [sys] { lmm_solve(sys); });
+      for (lmm_variable_t var : vars)
+        lmm_variable_free(sys, var);
+      lmm_system_free(sys);
+    }
+    report("lmm", std::string("solve_") + std::to_string(count) + "x" + std::to_string(count), total / runs, "us");
+  }
+}
+
+/* routing: lookup of the routes between random pairs of hosts. The zone type depends on the given platform. */
+static void bench_routing(const char* platform)
+{
+  std::vector<simgrid::s4u::Host*> hosts;
+  simgrid::s4u::Engine::instance()->hostList(&hosts);
+  std::vector<simgrid::surf::LinkImpl*> links;
+  double latency;
+  std::string name = platform;
+  if (name.rfind('/') != std::string::npos)
+    name = name.substr(name.rfind('/') + 1);
+  report("routing", name, measure(size, [&hosts, &links, &latency] {
+                            links.clear();
+                            latency = 0;
+                            hosts[rand_r(&seed) % hosts.size()]->routeTo(hosts[rand_r(&seed) % hosts.size()], &links,
+                                                                         &latency);
+                          }),
+         "us");
+}
+
+/* actors: creation and termination of actors, from another actor */
+static void bench_actors()
+{
+  simgrid::s4u::Actor::createActor("spawner", some_host(0), [] {
+    std::vector<simgrid::s4u::ActorPtr> actors;
+    simgrid::s4u::Host* host = some_host(1);
+    report("actors", "spawn", measure(size, [&actors, host] {
+                                actors.push_back(simgrid::s4u::Actor::createActor(
+                                    "sleeper", host, [] { simgrid::s4u::this_actor::sleep_for(10); }));
+                              }),
+           "us");
+    double start = xbt_os_time();
+    simgrid::s4u::this_actor::sleep_for(1); // Let them all start
+    report("actors", "start", (xbt_os_time() - start) * 1e6 / size, "us");
+    unsigned i = 0;
+    report("actors", "kill", measure(size, [&actors, &i] { actors[i++]->kill(); }), "us");
+  });
+  simgrid::s4u::Engine::instance()->run();
+}
+
+/* multisite: in each top-level netzone with two hosts, an actor sends messages to another one, except one out of ten
+ * that goes to the next netzone (the workload of teshsuite/surf/partition_report). Run it with
+ * --cfg=partition/report:yes to see how it would split along the netzones. */
+static void all_hosts(simgrid::s4u::NetZone* zone, std::vector<simgrid::s4u::Host*>* hosts)
+{
+  zone->hosts(hosts);
+  for (auto child : *zone->children())
+    all_hosts(child, hosts);
+}
+
+static void bench_multisite(const char* platform)
+{
+  static int payload = 0; // Never read
+  std::vector<std::vector<simgrid::s4u::Host*>> sites;
+  for (auto zone : *simgrid::s4u::Engine::instance()->netRoot()->children()) {
+    std::vector<simgrid::s4u::Host*> hosts;
+    all_hosts(zone, &hosts);
+    if (hosts.size() >= 2)
+      sites.push_back(hosts);
+  }
+  int count = sites.size();
+  xbt_assert(count > 1, "The multisite benchmark needs at least two top-level netzones with two hosts");
+  for (int site = 0; site < count; site++) {
+    simgrid::s4u::Actor::createActor("sender", sites[site][0], [site, count] {
+      for (int i = 0; i < size; i++)
+        simgrid::s4u::this_actor::send(
+            simgrid::s4u::Mailbox::byName("site-" + std::to_string(i % 10 == 9 ? (site + 1) % count : site)),
+            &payload, 1e6);
+    });
+    simgrid::s4u::Actor::createActor("receiver", sites[site][1], [site] {
+      simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("site-" + std::to_string(site));
+      for (int i = 0; i < size; i++)
+        simgrid::s4u::this_actor::recv(mbox);
+    });
+  }
+  std::string name = platform;
+  if (name.rfind('/') != std::string::npos)
+    name = name.substr(name.rfind('/') + 1);
+  double start = xbt_os_time();
+  simgrid::s4u::Engine::instance()->run();
+  report("multisite", name, count * size / (xbt_os_time() - start), "comms/s");
+}
+
+/* mailboxes: creation of many mailboxes named after an actor and a host, then lookups of random ones by name, and the
+ * memory accounted for each of them (including its name) */
+static void bench_mailboxes()
+{
+  std::vector<std::string> names;
+  for (int i = 0; i < size; i++)
+    names.push_back(std::string("worker-") + std::to_string(i) + "@host-" + std::to_string(i % 1000));
+  std::vector<simgrid::s4u::MailboxPtr> mailboxes;
+  mailboxes.reserve(size);
+  unsigned i = 0;
+  report("mailboxes", "create", measure(size, [&mailboxes, &names, &i] {
+                                  mailboxes.push_back(simgrid::s4u::Mailbox::byName(names[i++]));
+                                }),
+         "us");
+  report("mailboxes", "lookup_by_name",
+         measure(size, [&names] { simgrid::s4u::Mailbox::byName(names[rand_r(&seed) % names.size()]); }), "us");
+
+  size_t bytes = 0;
+  for (simgrid::s4u::MemoryUsage const& use : simgrid::s4u::Engine::instance()->memoryUsage())
+    if (use.subsystem == "mailboxes" || use.subsystem == "names")
+      bytes += use.current;
+  report("mailboxes", "accounted_bytes", static_cast<double>(bytes) / size, "B");
+}
+
+/* tracing: throughput of the Paje tracing of user variables, including the writing of the trace file */
+static void bench_tracing()
+{
+  TRACE_host_variable_declare("bench");
+  simgrid::s4u::Actor::createActor("tracer", some_host(0), [] {
+    for (int i = 0; i < size; i++) {
+      TRACE_host_variable_add(simgrid::s4u::this_actor::host()->cname(), "bench", 1);
+      if (i % 100 == 99) // Let the kernel dump its buffer
+        simgrid::s4u::this_actor::sleep_for(1);
+    }
+  });
+  double start = xbt_os_time();
+  simgrid::s4u::Engine::instance()->run();
+  report("tracing", "host_variable_add", size / (xbt_os_time() - start), "events/s");
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 2, "Usage: %s benchmark platform_file [size]\n"
+                       "  where benchmark is one of: context-switch simcalls comms lmm routing actors mailboxes multisite "
+                       "tracing",
+             argv[0]);
+  const char* benchmark = argv[1];
+  size                  = argc > 3 ? atoi(argv[3]) : 10000;
+
+  if (not strcmp(benchmark, "mailboxes"))
+    xbt_cfg_set_parse("memory/accounting:yes");
+  if (not strcmp(benchmark, "tracing")) {
+    /* The tracing must be configured before the platform gets loaded */
+    xbt_cfg_set_parse("tracing:yes");
+    xbt_cfg_set_parse("tracing/filename:kernel_bench.trace");
+  }
+  e->loadPlatform(argv[2]);
+
+  if (not strcmp(benchmark, "context-switch"))
+    bench_context_switch();
+  else if (not strcmp(benchmark, "simcalls"))
+    bench_simcalls();
+  else if (not strcmp(benchmark, "comms"))
+    bench_comms();
+  else if (not strcmp(benchmark, "lmm"))
+    bench_lmm();
+  else if (not strcmp(benchmark, "routing"))
+    bench_routing(argv[2]);
+  else if (not strcmp(benchmark, "actors"))
+    bench_actors();
+  else if (not strcmp(benchmark, "mailboxes"))
+    bench_mailboxes();
+  else if (not strcmp(benchmark, "multisite"))
+    bench_multisite(argv[2]);
+  else if (not strcmp(benchmark, "tracing"))
+    bench_tracing();
+  else
+    xbt_die("Unknown benchmark: %s", benchmark);
+
+  return 0;
+}
@@ -0,0 +1,124 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "simgrid/s4u.hpp"
+
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u example");
+
+static const int comm_count = 5;
+
+static void sender(int id)
+{
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("box-" + std::to_string(id));
+  simgrid::s4u::this_actor::send(mbox, new std::string("Message " + std::to_string(id)), 1e6 * (comm_count - id));
+}
+
+static void early_sender()
+{
+  simgrid::s4u::this_actor::send(simgrid::s4u::Mailbox::byName("early"), new std::string("Early message"), 1);
+}
+
+static void receiver()
+{
+  simgrid::s4u::ActivitySet set;
+  std::vector<void*> payloads(comm_count + 1);
+  std::vector<simgrid::s4u::CommPtr> comms;
+
+  for (int i = 0; i < comm_count; i++) {
+    simgrid::s4u::CommPtr comm = simgrid::s4u::Comm::recv_init(simgrid::s4u::Mailbox::byName("box-" + std::to_string(i)));
+    comm->setDstData(&payloads[i], sizeof(void*));
+    comm->setUserData(&payloads[i]);
+    set.add(comm);
+    comms.push_back(comm);
+  }
+  simgrid::s4u::CommPtr early = simgrid::s4u::this_actor::irecv(simgrid::s4u::Mailbox::byName("early"), &payloads[comm_count]);
+  early->setUserData(&payloads[comm_count]);
+  XBT_INFO("Waiting on %zu receives", set.size());
+
+  if (set.wait_any_for(0.1) == nullptr)
+    XBT_INFO("Nothing received within the timeout");
+
+  /* This one is terminated already: it must be returned right away */
+  set.add(early);
+
+  /* This one is waited directly */
+  set.remove(comms[0]);
+
+  while (not set.empty()) {
+    simgrid::s4u::CommPtr comm = set.wait_any();
+    std::string* msg           = *static_cast<std::string**>(comm->getUserData());
+    XBT_INFO("Received '%s', %zu remaining", msg->c_str(), set.size());
+    delete msg;
+  }
+  if (set.wait_any() == nullptr)
+    XBT_INFO("The set is empty");
+
+  comms[0]->wait();
+  std::string* msg = static_cast<std::string*>(payloads[0]);
+  XBT_INFO("Received '%s' out of the set", msg->c_str());
+  delete msg;
+}
+
+/* Once the first scenario is over, an actor adds a terminated comm to a set on which another actor is waiting */
+static simgrid::s4u::ActivitySet* shared_set = nullptr;
+
+static void shared_waiter()
+{
+  simgrid::s4u::this_actor::sleep_for(3);
+  void* payload;
+  simgrid::s4u::CommPtr late = simgrid::s4u::Comm::recv_init(simgrid::s4u::Mailbox::byName("late"));
+  late->setDstData(&payload, sizeof(void*));
+  late->setUserData(&payload);
+  shared_set = new simgrid::s4u::ActivitySet();
+  shared_set->add(late);
+
+  while (not shared_set->empty()) {
+    simgrid::s4u::CommPtr comm = shared_set->wait_any();
+    std::string* msg           = *static_cast<std::string**>(comm->getUserData());
+    XBT_INFO("Received '%s' from the shared set", msg->c_str());
+    delete msg;
+  }
+  delete shared_set;
+}
+
+static void shared_adder()
+{
+  simgrid::s4u::this_actor::sleep_for(3);
+  static void* payload;
+  simgrid::s4u::CommPtr comm = simgrid::s4u::this_actor::irecv(simgrid::s4u::Mailbox::byName("added"), &payload);
+  comm->setUserData(&payload);
+  simgrid::s4u::this_actor::sleep_for(1); // The comm terminates meanwhile
+  XBT_INFO("Add a terminated comm to the set on which the waiter blocks");
+  shared_set->add(comm);
+}
+
+static void shared_sender(std::string mailbox, double delay)
+{
+  simgrid::s4u::this_actor::sleep_for(delay);
+  simgrid::s4u::this_actor::send(simgrid::s4u::Mailbox::byName(mailbox), new std::string("Message to " + mailbox), 1);
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  e->loadPlatform(argv[1]);
+
+  for (int i = 0; i < comm_count; i++)
+    simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Tremblay"), [i] { sender(i); });
+  simgrid::s4u::Actor::createActor("early", simgrid::s4u::Host::by_name("Fafard"), early_sender);
+  simgrid::s4u::Actor::createActor("receiver", simgrid::s4u::Host::by_name("Jupiter"), receiver);
+  simgrid::s4u::Actor::createActor("waiter", simgrid::s4u::Host::by_name("Jupiter"), shared_waiter);
+  simgrid::s4u::Actor::createActor("adder", simgrid::s4u::Host::by_name("Jupiter"), shared_adder);
+  simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Fafard"), [] { shared_sender("added", 3); });
+  simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Fafard"), [] { shared_sender("late", 5); });
+
+  e->run();
+  XBT_INFO("Simulation time %g", e->getClock());
+
+  return 0;
+}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "simgrid/s4u.hpp"
+
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u example");
+
+static const int comm_count = 5;
+
+static void sender()
+{
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("box");
+  std::vector<simgrid::s4u::CommPtr> comms;
+
+  for (int i = 0; i < comm_count; i++) {
+    simgrid::s4u::CommPtr comm = simgrid::s4u::Comm::send_init(mbox);
+    comm->setRemains(1e6 * (i + 1));
+    comm->setSrcData(new std::string("Message " + std::to_string(i)));
+    comms.push_back(comm);
+  }
+  XBT_INFO("Post %d sends at once", comm_count);
+  simgrid::s4u::Comm::start_all(comms.begin(), comms.end());
+
+  while (not comms.empty()) {
+    auto done = simgrid::s4u::Comm::wait_any(comms.begin(), comms.end());
+    XBT_INFO("One send completed, %zu remaining", comms.size() - 1);
+    comms.erase(done);
+  }
+}
+
+static void receiver()
+{
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("box");
+  std::vector<simgrid::s4u::CommPtr> comms;
+  std::vector<void*> payloads(comm_count);
+
+  for (int i = 0; i < comm_count; i++) {
+    simgrid::s4u::CommPtr comm = simgrid::s4u::Comm::recv_init(mbox);
+    comm->setDstData(&payloads[i], sizeof(void*));
+    comms.push_back(comm);
+  }
+  XBT_INFO("Post %d receives at once", comm_count);
+  simgrid::s4u::Comm::start_all(comms.begin(), comms.end());
+
+  for (int i = 0; i < comm_count; i++) {
+    comms[i]->wait();
+    std::string* msg = static_cast<std::string*>(payloads[i]);
+    XBT_INFO("Received '%s'", msg->c_str());
+    delete msg;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  e->loadPlatform(argv[1]);
+
+  simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Tremblay"), sender);
+  simgrid::s4u::Actor::createActor("receiver", simgrid::s4u::Host::by_name("Jupiter"), receiver);
+
+  e->run();
+  XBT_INFO("Simulation time %g", e->getClock());
+
+  return 0;
+}
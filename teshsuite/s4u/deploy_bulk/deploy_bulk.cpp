@@ -0,0 +1,63 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Deploys a large table of actors with Engine::deploy(), alternating between two functions. Each worker sleeps for
+ * the delay given as argument, and reports it to the collector, that checks that all of them did run in order. */
+
+#include "simgrid/s4u.hpp"
+
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u test");
+
+static const int workers_count = 2000;
+
+static void worker(std::vector<std::string> args)
+{
+  xbt_assert(args.size() == 2, "The worker expects one argument");
+  double delay = std::stod(args[1]);
+  simgrid::s4u::this_actor::sleep_for(delay);
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("collector");
+  simgrid::s4u::this_actor::send(mbox, new double(delay), 1000);
+}
+
+static void collector(std::vector<std::string> args)
+{
+  xbt_assert(args.size() == 2, "The collector expects one argument");
+  int expected = std::stoi(args[1]);
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("collector");
+  double last                   = 0;
+  for (int i = 0; i < expected; i++) {
+    double* delay = static_cast<double*>(simgrid::s4u::this_actor::recv(mbox));
+    xbt_assert(*delay >= last, "Got the message of delay %f after the one of delay %f", *delay, last);
+    last = *delay;
+    delete delay;
+  }
+  XBT_INFO("Received the %d reports, the last one was sent after %.2f seconds", expected, last);
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  e->loadPlatform(argv[1]);
+  e->registerFunction("worker", &worker);
+  e->registerFunction("collector", &collector);
+
+  std::vector<simgrid::s4u::Host*> hosts;
+  e->hostList(&hosts);
+
+  std::vector<simgrid::s4u::ActorDeployment> actors;
+  actors.push_back({simgrid::s4u::Host::by_name("Tremblay"), "collector",
+                    {"collector", std::to_string(workers_count)}});
+  for (int i = 0; i < workers_count; i++)
+    actors.push_back({hosts[i % hosts.size()], "worker", {"worker-" + std::to_string(i), std::to_string(i)}});
+  e->deploy(std::move(actors));
+  XBT_INFO("Deployed %d actors", workers_count + 1);
+
+  e->run();
+  XBT_INFO("Simulation done");
+  return 0;
+}
@@ -0,0 +1,51 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Runs a common prefix of the simulation, then forks it in three branches that each continue it with another pstate
+ * for the host of the worker. Each branch reports the date at which the worker finished to the parent process. */
+
+#include "simgrid/s4u.hpp"
+
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u test");
+
+static double end_date = -1;
+
+static void worker()
+{
+  for (int i = 0; i < 10; i++) {
+    simgrid::s4u::this_actor::execute(1e8);
+    XBT_INFO("Task %d done", i);
+  }
+  end_date = simgrid::s4u::Engine::getClock();
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  e->loadPlatform(argv[1]);
+  simgrid::s4u::Host* host = simgrid::s4u::Host::by_name("MyHost1");
+  simgrid::s4u::Actor::createActor("worker", host, worker);
+
+  e->runUntil(4.5);
+  XBT_INFO("Common prefix simulated");
+
+  std::vector<std::string> results;
+  int branch = e->fork(3, &results);
+  if (branch >= 0) {
+    /* Keep the output of the branches out of the way, as they run concurrently */
+    xbt_log_control_set("s4u_test.thres:critical");
+    host->setPstate(branch);
+    e->run();
+    e->sendToParent(std::to_string(end_date));
+    return 0;
+  }
+
+  for (unsigned i = 0; i < results.size(); i++)
+    XBT_INFO("Branch %u (%.0f flop/s): the worker finished at %s", i, host->getPstateSpeed(i), results[i].c_str());
+  return 0;
+}
@@ -0,0 +1,74 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks the memory accounting of Engine::memoryUsage(): the platform is accounted once loaded, then the stacks and
+ * mailboxes of a set of workers are accounted while they live, and released when they terminate.
+ *
+ * The amount of bytes depends on the architecture, so only the stacks are displayed (in amount of stacks).
+ */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/config.h"
+
+#include <string>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u test");
+
+static const int workers_count = 10;
+
+static simgrid::s4u::MemoryUsage usage(std::string subsystem)
+{
+  for (simgrid::s4u::MemoryUsage const& use : simgrid::s4u::Engine::instance()->memoryUsage())
+    if (use.subsystem == subsystem)
+      return use;
+  xbt_die("No subsystem named %s", subsystem.c_str());
+}
+
+static void show_stacks()
+{
+  size_t stack_size = static_cast<size_t>(xbt_cfg_get_int("contexts/stack-size")) * 1024;
+  simgrid::s4u::MemoryUsage use = usage("stacks");
+  XBT_INFO("%zu stacks in use (peak: %zu)", use.current / stack_size, use.peak / stack_size);
+}
+
+static int payload = 0; // Never read
+
+static void worker(int id)
+{
+  simgrid::s4u::this_actor::recv(simgrid::s4u::Mailbox::byName(std::string("worker-") + std::to_string(id)));
+}
+
+static void master()
+{
+  for (int i = 0; i < workers_count; i++)
+    simgrid::s4u::Actor::createActor("worker", simgrid::s4u::Host::by_name("Jupiter"), worker, i);
+  simgrid::s4u::this_actor::sleep_for(1);
+  show_stacks();
+  XBT_INFO("Mailboxes: %s", usage("mailboxes").current > 0 ? "accounted" : "empty");
+
+  for (int i = 0; i < workers_count; i++)
+    simgrid::s4u::this_actor::send(simgrid::s4u::Mailbox::byName(std::string("worker-") + std::to_string(i)),
+                                   &payload, 1000);
+  simgrid::s4u::this_actor::sleep_for(1);
+  show_stacks();
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file", argv[0]);
+  e->loadPlatform(argv[1]);
+
+  for (const char* subsystem : {"platform", "routing", "lmm", "names"})
+    XBT_INFO("%s: %s", subsystem, usage(subsystem).current > 0 ? "accounted" : "empty");
+  show_stacks();
+
+  simgrid::s4u::Actor::createActor("master", simgrid::s4u::Host::by_name("Tremblay"), master);
+  e->run();
+  XBT_INFO("Simulation done");
+  show_stacks();
+
+  return 0;
+}
@@ -0,0 +1,90 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/random.hpp"
+
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(s4u_test, "Messages specific for this s4u test");
+
+using simgrid::xbt::RandomStream;
+
+/* Known answers of the reference implementation */
+static void check_block_function()
+{
+  const uint32_t counters[3][4] = {{0, 0, 0, 0},
+                                   {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                                   {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+  const uint32_t keys[3][2]     = {{0, 0}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+  const uint32_t expected[3][4] = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                                   {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                                   {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+  for (int i = 0; i < 3; i++) {
+    uint32_t out[4];
+    RandomStream::philox(counters[i], keys[i], out);
+    for (int j = 0; j < 4; j++)
+      xbt_assert(out[j] == expected[i][j], "Wrong output %d of block %d: %08x instead of %08x", j, i, out[j],
+                 expected[i][j]);
+  }
+}
+
+/* The bulk functions and the skips give the numbers of the scalar functions, from any position */
+static void check_bulk_and_skip()
+{
+  RandomStream scalar(42, 7);
+  RandomStream bulk(42, 7);
+  RandomStream skipping(42, 7);
+  scalar();
+  bulk();
+
+  std::vector<uint32_t> bits(1003);
+  bulk.fill(bits.data(), bits.size());
+  for (uint32_t value : bits)
+    xbt_assert(value == scalar(), "fill() differs from operator()");
+
+  std::vector<double> doubles(601);
+  bulk.fill_uniform(doubles.data(), doubles.size(), 2.0, 5.0);
+  for (double value : doubles)
+    xbt_assert(value == scalar.uniform(2.0, 5.0), "fill_uniform() differs from uniform()");
+  bulk.fill_exponential(doubles.data(), doubles.size(), 0.5);
+  for (double value : doubles)
+    xbt_assert(value == scalar.exponential(0.5), "fill_exponential() differs from exponential()");
+
+  skipping.skip(scalar.position() - 5);
+  skipping.skip(5);
+  xbt_assert(skipping.position() == scalar.position(), "Wrong position after skip()");
+  xbt_assert(skipping() == scalar(), "skip() differs from drawing");
+}
+
+/* Each actor sleeps for random delays: the delays only depend on its pid, whatever the order of the actors */
+static void arrivals()
+{
+  RandomStream stream = simgrid::s4u::this_actor::randomStream();
+  double delays[3];
+  stream.fill_exponential(delays, 3, 1.0);
+  for (double delay : delays) {
+    simgrid::s4u::this_actor::sleep_for(delay);
+    XBT_INFO("Arrival (size %u)", stream() % 1000);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc == 2, "Usage: %s platform_file", argv[0]);
+  e->loadPlatform(argv[1]);
+
+  check_block_function();
+  check_bulk_and_skip();
+
+  for (int i = 0; i < 4; i++)
+    simgrid::s4u::Actor::createActor(("arrivals-" + std::to_string(i)).c_str(), simgrid::s4u::Host::by_name("Tremblay"),
+                                     arrivals);
+  e->run();
+
+  return 0;
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Replays the same trace in the text and in the binary formats, with callbacks getting typed arguments (compute, send,
+ * recv) and a callback getting strings (sleep), which must behave the same in both cases. */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/replay.hpp"
+#include "xbt/str.h"
+
+#include <string>
+#include <unistd.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(replay_binary, "Messages specific for this test");
+
+static void compute(simgrid::xbt::ReplayArgs const& args)
+{
+  double flops = args.get_double(2);
+  XBT_INFO("compute %g flops", flops);
+  simgrid::s4u::this_actor::execute(flops);
+}
+
+static int payload = 0; // Never read
+
+static void send(simgrid::xbt::ReplayArgs const& args)
+{
+  long long size = args.get_int(3);
+  XBT_INFO("send %lld bytes to %s", size, args.get_string(2));
+  simgrid::s4u::this_actor::send(
+      simgrid::s4u::Mailbox::byName(std::string(args.actor()) + "_" + args.get_string(2)), &payload,
+      size < 0 ? 0 : size);
+}
+
+static void recv(simgrid::xbt::ReplayArgs const& args)
+{
+  simgrid::s4u::this_actor::recv(simgrid::s4u::Mailbox::byName(std::string(args.get_string(2)) + "_" + args.actor()));
+  XBT_INFO("received from %s", args.get_string(2));
+}
+
+static void sleep(const char* const* action)
+{
+  XBT_INFO("%s %s %s", action[0], action[1], action[2]);
+  simgrid::s4u::this_actor::sleep_for(xbt_str_parse_double(action[2], "%s is not a double"));
+}
+
+static void replayer(std::string name)
+{
+  char* argv[] = {&name[0], nullptr};
+  simgrid::xbt::replay_runner(1, argv);
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc == 4, "Usage: %s platform_file trace_file text|binary", argv[0]);
+
+  std::string trace = argv[2];
+  if (std::string(argv[3]) == "binary") {
+    trace = "replay_binary_" + std::to_string(getpid()) + ".bin"; // The factories may run concurrently
+    simgrid::xbt::replay_text_to_binary(argv[2], trace.c_str());
+    xbt_assert(simgrid::xbt::replay_is_binary(trace.c_str()), "The converted trace is not binary");
+  }
+
+  e->loadPlatform(argv[1]);
+  simgrid::xbt::replay_action_register("compute", compute);
+  simgrid::xbt::replay_action_register("send", send);
+  simgrid::xbt::replay_action_register("recv", recv);
+  xbt_replay_action_register("sleep", sleep);
+
+  simgrid::s4u::Actor::createActor("p0", simgrid::s4u::Host::by_name("Tremblay"), replayer, "p0");
+  simgrid::s4u::Actor::createActor("p1", simgrid::s4u::Host::by_name("Jupiter"), replayer, "p1");
+
+  simgrid::xbt::replay_open(trace.c_str());
+  e->run();
+  simgrid::xbt::replay_close();
+  if (trace != argv[2])
+    remove(trace.c_str());
+
+  XBT_INFO("Simulation time %g", e->getClock());
+  return 0;
+}
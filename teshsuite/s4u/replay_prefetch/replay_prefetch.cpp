@@ -0,0 +1,82 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Replays a trace shared by all actors, in which the actions of an actor are far ahead of the action that the other
+ * one needs to progress: the trace must be read beyond the bound of the per-actor queues without deadlocking. */
+
+#include "simgrid/s4u.hpp"
+#include "xbt/replay.hpp"
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include <unistd.h>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(replay_prefetch, "Messages specific for this test");
+
+static std::map<std::string, int> computations;
+static int payload = 0; // Never read
+
+static void compute(simgrid::xbt::ReplayArgs const& args)
+{
+  computations[args.actor()]++;
+  simgrid::s4u::this_actor::execute(args.get_double(2));
+}
+
+static void send(simgrid::xbt::ReplayArgs const& args)
+{
+  XBT_INFO("send to %s", args.get_string(2));
+  simgrid::s4u::this_actor::send(
+      simgrid::s4u::Mailbox::byName(std::string(args.actor()) + "_" + args.get_string(2)), &payload,
+      args.get_double(3));
+}
+
+static void recv(simgrid::xbt::ReplayArgs const& args)
+{
+  simgrid::s4u::this_actor::recv(simgrid::s4u::Mailbox::byName(std::string(args.get_string(2)) + "_" + args.actor()));
+  XBT_INFO("received from %s", args.get_string(2));
+}
+
+static void replayer(std::string name)
+{
+  char* argv[] = {&name[0], nullptr};
+  simgrid::xbt::replay_runner(1, argv);
+  XBT_INFO("Replayed %d computations", computations[name]);
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc == 3, "Usage: %s platform_file amount", argv[0]);
+  int amount = atoi(argv[2]);
+
+  /* p1 waits for p0, whose actions come after many actions of p1. The actions of p2 are never consumed. */
+  std::string trace = "replay_prefetch_" + std::to_string(getpid()) + ".txt"; // The factories may run concurrently
+  FILE* file        = fopen(trace.c_str(), "w");
+  xbt_assert(file, "Cannot write %s", trace.c_str());
+  fprintf(file, "# Generated by replay_prefetch\np1 recv p0\n");
+  for (int i = 0; i < amount; i++)
+    fprintf(file, "p1 compute 1e6\n");
+  fprintf(file, "p2 compute 1\np0 compute 1e8\np0 send p1 1e6\n");
+  for (int i = 0; i < amount; i++)
+    fprintf(file, "p0\tcompute  1e6\n");
+  fclose(file);
+
+  e->loadPlatform(argv[1]);
+  simgrid::xbt::replay_action_register("compute", compute);
+  simgrid::xbt::replay_action_register("send", send);
+  simgrid::xbt::replay_action_register("recv", recv);
+
+  simgrid::s4u::Actor::createActor("p0", simgrid::s4u::Host::by_name("Tremblay"), replayer, "p0");
+  simgrid::s4u::Actor::createActor("p1", simgrid::s4u::Host::by_name("Jupiter"), replayer, "p1");
+
+  simgrid::xbt::replay_open(trace.c_str());
+  e->run();
+  simgrid::xbt::replay_close();
+  remove(trace.c_str());
+
+  XBT_INFO("Simulation time %g", e->getClock());
+  return 0;
+}
@@ -0,0 +1,62 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Measures the throughput of the creation and destruction of communications.
+ *
+ * Pairs of actors exchange tiny messages, so that each iteration creates and frees a communication (along with its
+ * network action) without much else to do. Run it with --log=xbt_pool.thres:verbose to see how many of them were
+ * alive at most.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "simgrid/s4u.hpp"
+#include "xbt/xbt_os_time.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(comm_bench, "Messages specific for this benchmark");
+
+static int comms_per_pair = 10000;
+static int payload; /* The same tiny payload is sent over and over */
+
+static void sender(int id)
+{
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("box-" + std::to_string(id));
+  for (int i = 0; i < comms_per_pair; i++)
+    simgrid::s4u::this_actor::isend(mbox, &payload, 1)->wait();
+}
+
+static void receiver(int id)
+{
+  simgrid::s4u::MailboxPtr mbox = simgrid::s4u::Mailbox::byName("box-" + std::to_string(id));
+  void* data;
+  for (int i = 0; i < comms_per_pair; i++)
+    simgrid::s4u::this_actor::irecv(mbox, &data)->wait();
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file [pair_count] [comms_per_pair]", argv[0]);
+  e->loadPlatform(argv[1]);
+  int pair_count = argc > 2 ? atoi(argv[2]) : 10;
+  comms_per_pair = argc > 3 ? atoi(argv[3]) : comms_per_pair;
+
+  for (int i = 0; i < pair_count; i++) {
+    simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Tremblay"), [i] { sender(i); });
+    simgrid::s4u::Actor::createActor("receiver", simgrid::s4u::Host::by_name("Jupiter"), [i] { receiver(i); });
+  }
+
+  double start = xbt_os_time();
+  e->run();
+  double elapsed = xbt_os_time() - start;
+
+  double comms = static_cast<double>(pair_count) * comms_per_pair;
+  XBT_INFO("%d pairs x %d comms done", pair_count, comms_per_pair);
+  printf("%.0f comms in %.3f s: %.0f comms per second\n", comms, elapsed, comms / elapsed);
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Measures the cost of handing control from an actor to maestro and back.
+ *
+ * Each actor first issues a simcall that does nothing in a loop, so that every iteration costs exactly one round-trip
+ * through the context factory. Pick the factory to measure with --cfg=contexts/factory:<name>.
+ *
+ * Then, each actor issues an [[inline]] simcall (that only reads the kernel state) in a loop. These ones do not need
+ * any context switch, unless the model-checker is active.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#include "simgrid/s4u.hpp"
+#include "simgrid/simix.hpp"
+#include "xbt/config.h"
+#include "xbt/xbt_os_time.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(ctx_bench, "Messages specific for this benchmark");
+
+static int calls_per_actor = 10000;
+
+/* Wall-clock bounds of each phase. The phases are separated by a simulated sleep so that they do not overlap. */
+static double yield_end    = 0;
+static double inline_start = -1;
+static double inline_end   = 0;
+
+static void bencher()
+{
+  for (int i = 0; i < calls_per_actor; i++)
+    simgrid::simix::kernelImmediate([] { /* do nothing */ });
+  yield_end = std::max(yield_end, xbt_os_time());
+
+  simgrid::s4u::this_actor::sleep_for(1);
+  if (inline_start < 0)
+    inline_start = xbt_os_time();
+  smx_actor_t self = SIMIX_process_self();
+  for (int i = 0; i < calls_per_actor; i++)
+    simcall_process_is_suspended(self);
+  inline_end = std::max(inline_end, xbt_os_time());
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file [actor_count] [calls_per_actor]", argv[0]);
+  e->loadPlatform(argv[1]);
+  int actor_count = argc > 2 ? atoi(argv[2]) : 10;
+  calls_per_actor = argc > 3 ? atoi(argv[3]) : calls_per_actor;
+
+  simgrid::s4u::Host* host = simgrid::s4u::Host::by_name("Tremblay");
+  for (int i = 0; i < actor_count; i++)
+    simgrid::s4u::Actor::createActor("bencher", host, bencher);
+
+  double start = xbt_os_time();
+  e->run();
+
+  double calls = static_cast<double>(actor_count) * calls_per_actor;
+  printf("%s: %d actors x %d calls: %.3f us per yielding simcall, %.3f us per inline simcall\n",
+         xbt_cfg_get_string("contexts/factory"), actor_count, calls_per_actor, (yield_end - start) * 1e6 / calls,
+         (inline_end - inline_start) * 1e6 / calls);
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* A ping-pong between two actors, to check the counters of the kernel profiler (--cfg=profiling/output) */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(profiler_test, "Messages specific for this test");
+
+static int payload;
+
+static void pinger(int rounds)
+{
+  simgrid::s4u::MailboxPtr ping = simgrid::s4u::Mailbox::byName("ping");
+  simgrid::s4u::MailboxPtr pong = simgrid::s4u::Mailbox::byName("pong");
+  for (int i = 0; i < rounds; i++) {
+    simgrid::s4u::this_actor::isend(ping, &payload, 1e6)->wait();
+    void* data;
+    simgrid::s4u::this_actor::irecv(pong, &data)->wait();
+  }
+  simgrid::s4u::this_actor::execute(1e9);
+}
+
+static void ponger(int rounds)
+{
+  simgrid::s4u::MailboxPtr ping = simgrid::s4u::Mailbox::byName("ping");
+  simgrid::s4u::MailboxPtr pong = simgrid::s4u::Mailbox::byName("pong");
+  for (int i = 0; i < rounds; i++) {
+    void* data;
+    simgrid::s4u::this_actor::irecv(ping, &data)->wait();
+    simgrid::s4u::this_actor::isend(pong, &payload, 1e6)->wait();
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file", argv[0]);
+  e->loadPlatform(argv[1]);
+
+  simgrid::s4u::Actor::createActor("pinger", simgrid::s4u::Host::by_name("Tremblay"), [] { pinger(10); });
+  simgrid::s4u::Actor::createActor("ponger", simgrid::s4u::Host::by_name("Jupiter"), [] { ponger(10); });
+  e->run();
+  XBT_INFO("Simulation done");
+  return 0;
+}
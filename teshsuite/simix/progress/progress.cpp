@@ -0,0 +1,49 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* A few actors sleeping, computing and communicating, to check the counters of the progress reports
+ * (--cfg=progress/period) */
+
+#include "simgrid/s4u.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(progress_test, "Messages specific for this test");
+
+static int payload;
+
+static void sender()
+{
+  simgrid::s4u::MailboxPtr mailbox = simgrid::s4u::Mailbox::byName("mailbox");
+  for (int i = 0; i < 3; i++)
+    simgrid::s4u::this_actor::send(mailbox, &payload, 1e7);
+}
+
+static void receiver()
+{
+  simgrid::s4u::MailboxPtr mailbox = simgrid::s4u::Mailbox::byName("mailbox");
+  for (int i = 0; i < 3; i++) {
+    simgrid::s4u::this_actor::recv(mailbox);
+    simgrid::s4u::this_actor::execute(1e8);
+  }
+}
+
+static void sleeper()
+{
+  for (int i = 0; i < 4; i++)
+    simgrid::s4u::this_actor::sleep_for(1);
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file", argv[0]);
+  e->loadPlatform(argv[1]);
+
+  simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Tremblay"), sender);
+  simgrid::s4u::Actor::createActor("receiver", simgrid::s4u::Host::by_name("Jupiter"), receiver);
+  simgrid::s4u::Actor::createActor("sleeper", simgrid::s4u::Host::by_name("Fafard"), sleeper);
+  e->run();
+  XBT_INFO("Simulation done");
+  return 0;
+}
@@ -0,0 +1,61 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Measures how many short simulations per second a parameter sweep can run with Engine::fork().
+ *
+ * The platform is parsed once, then each run is a branch that deploys its own actors: a sender transfers a message
+ * whose size depends on the branch to a receiver, and reports the date at which it arrived.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "simgrid/s4u.hpp"
+#include "xbt/xbt_os_time.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(sweep_bench, "Messages specific for this benchmark");
+
+static double arrival = -1;
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file [run_count] [parallelism]", argv[0]);
+  double start = xbt_os_time();
+  e->loadPlatform(argv[1]);
+  double parsing = xbt_os_time() - start;
+  int run_count   = argc > 2 ? atoi(argv[2]) : 1000;
+  int parallelism = argc > 3 ? atoi(argv[3]) : 1;
+
+  start = xbt_os_time();
+  std::vector<std::string> results;
+  int run = e->fork(run_count, &results, parallelism);
+  if (run >= 0) {
+    double size = 1e6 * (run + 1);
+    simgrid::s4u::Actor::createActor("sender", simgrid::s4u::Host::by_name("Tremblay"), [size] {
+      simgrid::s4u::this_actor::send(simgrid::s4u::Mailbox::byName("box"), new double(size), size);
+    });
+    simgrid::s4u::Actor::createActor("receiver", simgrid::s4u::Host::by_name("Jupiter"), [] {
+      delete static_cast<double*>(simgrid::s4u::this_actor::recv(simgrid::s4u::Mailbox::byName("box")));
+      arrival = simgrid::s4u::Engine::getClock();
+    });
+    e->run();
+    e->sendToParent(std::to_string(arrival));
+    return 0;
+  }
+  double elapsed = xbt_os_time() - start;
+
+  for (int i = 1; i < run_count; i++)
+    xbt_assert(std::stod(results[i - 1]) < std::stod(results[i]), "Run %d ended at %s, before run %d (at %s)", i,
+               results[i].c_str(), i - 1, results[i - 1].c_str());
+  XBT_INFO("%d runs done, the last one ended at %s", run_count, results.back().c_str());
+  printf("Platform parsed once in %.3f s\n", parsing);
+  printf("%d runs (%d at a time) in %.3f s: %.0f runs per second\n", run_count, parallelism, elapsed,
+         run_count / elapsed);
+
+  return 0;
+}
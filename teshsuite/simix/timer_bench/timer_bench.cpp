@@ -0,0 +1,88 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Measures the cost of the SIMIX timers when most of them get cancelled before firing, as the timeouts do.
+ *
+ * The timers are spread over a long period of simulated time, so that they land on all the levels of the timer wheel
+ * and in its fallback heap. The ones that survive must fire at their date, in date order. Use --log=timer_bench.thres:verbose
+ * to get the timings.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include "simgrid/s4u.hpp"
+#include "simgrid/simix.h"
+#include "xbt/xbt_os_time.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(timer_bench, "Messages specific for this benchmark");
+
+static uint64_t rng_state = 42;
+/* A small xorshift generator, to get the same dates on every platform */
+static double random_date(double max)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return max * static_cast<double>(rng_state >> 11) / static_cast<double>(UINT64_C(1) << 53);
+}
+
+static long fired       = 0;
+static double last_date = 0;
+
+static void on_timer(void* arg)
+{
+  double date = *static_cast<double*>(arg);
+  xbt_assert(date >= last_date, "Timer of date %f fired after the one of date %f", date, last_date);
+  xbt_assert(SIMIX_get_clock() >= date, "Timer of date %f fired too early, at %f", date, SIMIX_get_clock());
+  last_date = date;
+  fired++;
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file [timer_count] [churn_rounds]", argv[0]);
+  e->loadPlatform(argv[1]);
+  int count  = argc > 2 ? atoi(argv[2]) : 100000;
+  int rounds = argc > 3 ? atoi(argv[3]) : 10;
+  const double horizon = 100000; // seconds of simulated time, beyond the span of the wheel
+
+  /* Churn: set timers and cancel them right away, as most timeouts do */
+  std::vector<double> dates(count);
+  std::vector<smx_timer_t> timers(count);
+  double start = xbt_os_time();
+  for (int round = 0; round < rounds; round++) {
+    for (int i = 0; i < count; i++) {
+      dates[i]  = random_date(horizon);
+      timers[i] = SIMIX_timer_set(dates[i], on_timer, &dates[i]);
+    }
+    for (int i = 0; i < count; i++)
+      SIMIX_timer_remove(timers[i]);
+  }
+  double churn = xbt_os_time() - start;
+  XBT_VERB("%.1f ns per timer set and cancelled", churn * 1e9 / (static_cast<double>(count) * rounds));
+
+  /* Keep one timer out of ten, and let the others fire */
+  start = xbt_os_time();
+  for (int i = 0; i < count; i++) {
+    dates[i]  = random_date(horizon);
+    timers[i] = SIMIX_timer_set(dates[i], on_timer, &dates[i]);
+  }
+  long cancelled = 0;
+  for (int i = 0; i < count; i++)
+    if (i % 10 != 0) {
+      SIMIX_timer_remove(timers[i]);
+      cancelled++;
+    }
+  e->run();
+  XBT_VERB("%.1f ns per timer in the firing phase", (xbt_os_time() - start) * 1e9 / count);
+
+  XBT_INFO("%d timers set, %ld cancelled, %ld fired in date order", count, cancelled, fired);
+  xbt_assert(fired + cancelled == count, "Some timers were lost");
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* This test checks that the messages are matched in the order mandated by MPI, even when many receives are posted
+ * with distinct (source, tag) pairs and mixed with wildcard receives. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <mpi.h>
+
+#define N 10000
+
+static void check(const char* phase, int got, int expected)
+{
+  if (got != expected)
+    printf("%s: got %d instead of %d\n", phase, got, expected);
+}
+
+int main(int argc, char* argv[])
+{
+  int rank;
+  int i;
+  int data[N];
+  MPI_Request req[N];
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  /* Phase 1: many receives posted on distinct tags, in the opposite order of the sends */
+  if (rank == 0) {
+    for (i = 0; i < N; i++)
+      MPI_Irecv(&data[i], 1, MPI_INT, 1, N - 1 - i, MPI_COMM_WORLD, &req[i]);
+    for (i = 0; i < N; i++) { /* Waitall would cost O(N^2) to look for the completed requests */
+      MPI_Wait(&req[i], MPI_STATUS_IGNORE);
+      check("distinct tags", data[i], N - 1 - i);
+    }
+    printf("distinct tags: %d messages received\n", N);
+  } else if (rank == 1) {
+    for (i = 0; i < N; i++)
+      MPI_Send(&i, 1, MPI_INT, 0, i, MPI_COMM_WORLD);
+  }
+
+  /* Phase 2: receives posted before the sends, the oldest matching receive gets the message */
+  if (rank == 0) {
+    MPI_Irecv(&data[0], 1, MPI_INT, 1, 5, MPI_COMM_WORLD, &req[0]);
+    MPI_Irecv(&data[1], 1, MPI_INT, MPI_ANY_SOURCE, 5, MPI_COMM_WORLD, &req[1]);
+    MPI_Irecv(&data[2], 1, MPI_INT, 1, MPI_ANY_TAG, MPI_COMM_WORLD, &req[2]);
+    MPI_Irecv(&data[3], 1, MPI_INT, MPI_ANY_SOURCE, MPI_ANY_TAG, MPI_COMM_WORLD, &req[3]);
+    MPI_Irecv(&data[4], 1, MPI_INT, 1, 5, MPI_COMM_WORLD, &req[4]);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(5, req, MPI_STATUSES_IGNORE);
+    for (i = 0; i < 5; i++)
+      check("posted receives", data[i], 100 + i);
+    printf("posted receives: matched in posting order\n");
+  } else if (rank == 1) {
+    int values[5] = {100, 101, 102, 103, 104};
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Send(&values[0], 1, MPI_INT, 0, 5, MPI_COMM_WORLD);
+    MPI_Send(&values[1], 1, MPI_INT, 0, 5, MPI_COMM_WORLD);
+    MPI_Send(&values[2], 1, MPI_INT, 0, 7, MPI_COMM_WORLD);
+    MPI_Send(&values[3], 1, MPI_INT, 0, 5, MPI_COMM_WORLD);
+    MPI_Send(&values[4], 1, MPI_INT, 0, 5, MPI_COMM_WORLD);
+  } else {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
+  /* Phase 3: sends issued before the receives, messages from the same source do not overtake each other */
+  if (rank == 0) {
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Recv(&data[0], 1, MPI_INT, 1, 3, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(&data[1], 1, MPI_INT, 1, MPI_ANY_TAG, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(&data[2], 1, MPI_INT, MPI_ANY_SOURCE, 3, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    MPI_Recv(&data[3], 1, MPI_INT, 1, 4, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    check("unexpected messages", data[0], 201);
+    check("unexpected messages", data[1], 200);
+    check("unexpected messages", data[2], 202);
+    check("unexpected messages", data[3], 203);
+    printf("unexpected messages: matched in sending order\n");
+  } else if (rank == 1) {
+    int values[4] = {200, 201, 202, 203};
+    int tags[4]   = {4, 3, 3, 4};
+    for (i = 0; i < 4; i++)
+      MPI_Isend(&values[i], 1, MPI_INT, 0, tags[i], MPI_COMM_WORLD, &req[i]);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_Waitall(4, req, MPI_STATUSES_IGNORE);
+  } else {
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,68 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* A multi-site workload for the partition analysis (partition/report): in each top-level netzone, a sender sends
+ * messages to a receiver of the same netzone, except one out of ten that goes to the receiver of the next netzone. */
+
+#include "simgrid/s4u.hpp"
+#include "simgrid/s4u/NetZone.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(surf_test, "Messages specific for this test");
+
+static int messages_count = 20;
+static int payload        = 0; // Never read
+
+static void all_hosts(simgrid::s4u::NetZone* zone, std::vector<simgrid::s4u::Host*>* hosts)
+{
+  zone->hosts(hosts);
+  for (auto child : *zone->children())
+    all_hosts(child, hosts);
+}
+
+static void sender(int site, int sites_count)
+{
+  for (int i = 0; i < messages_count; i++) {
+    int destination = i % 10 == 9 ? (site + 1) % sites_count : site;
+    simgrid::s4u::this_actor::send(simgrid::s4u::Mailbox::byName("site-" + std::to_string(destination)), &payload,
+                                   1e6);
+  }
+}
+
+static void receiver(int site)
+{
+  /* One out of ten of the messages of each sender goes to the next site: each receiver gets as many as sent */
+  for (int i = 0; i < messages_count; i++)
+    simgrid::s4u::this_actor::recv(simgrid::s4u::Mailbox::byName("site-" + std::to_string(site)));
+}
+
+int main(int argc, char** argv)
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform.xml [messages]\n", argv[0]);
+  e->loadPlatform(argv[1]);
+  if (argc > 2)
+    messages_count = atoi(argv[2]);
+
+  std::vector<std::vector<simgrid::s4u::Host*>> sites;
+  for (auto zone : *e->netRoot()->children()) {
+    std::vector<simgrid::s4u::Host*> hosts;
+    all_hosts(zone, &hosts);
+    if (hosts.size() >= 2)
+      sites.push_back(hosts);
+  }
+  int sites_count = sites.size();
+  for (int site = 0; site < sites_count; site++) {
+    simgrid::s4u::Actor::createActor("sender", sites[site][0], [site, sites_count] { sender(site, sites_count); });
+    simgrid::s4u::Actor::createActor("receiver", sites[site][1], [site] { receiver(site); });
+  }
+
+  e->run();
+  XBT_INFO("%d sites exchanged their messages in %g seconds", sites_count, e->getClock());
+  return 0;
+}
@@ -0,0 +1,69 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Displays the lookahead of each top-level netzone of a platform, and checks that it is a lower bound of the
+ * latency between the hosts of these netzones. The netzones that cannot be reached have an infinite lookahead. */
+
+#include "simgrid/s4u.hpp"
+#include "src/kernel/routing/NetZoneImpl.hpp"
+
+#include <cmath>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(surf_test, "Messages specific for this test");
+
+static simgrid::s4u::Host* first_host(simgrid::s4u::NetZone* zone)
+{
+  std::vector<simgrid::s4u::Host*> hosts;
+  zone->hosts(&hosts);
+  if (not hosts.empty())
+    return hosts.front();
+  for (auto child : *zone->children()) {
+    simgrid::s4u::Host* host = first_host(child);
+    if (host != nullptr)
+      return host;
+  }
+  return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+  simgrid::s4u::Engine* e = new simgrid::s4u::Engine(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform.xml\n", argv[0]);
+  e->loadPlatform(argv[1]);
+
+  simgrid::kernel::routing::NetZoneImpl* root = static_cast<simgrid::kernel::routing::NetZoneImpl*>(e->netRoot());
+  std::vector<simgrid::s4u::NetZone*>* zones = root->children();
+  std::vector<std::vector<double>> lookahead = root->getChildrenLookahead();
+
+  /* Each netzone could advance that far beyond the others without receiving anything from them */
+  for (unsigned i = 0; i < zones->size(); i++) {
+    int closest = -1;
+    for (unsigned j = 0; j < zones->size(); j++)
+      if (i != j && (closest < 0 || lookahead[j][i] < lookahead[closest][i]))
+        closest = j;
+    if (closest >= 0 && std::isinf(lookahead[closest][i]))
+      XBT_INFO("%s: no route from any other netzone", zones->at(i)->name());
+    else if (closest >= 0)
+      XBT_INFO("%s: lookahead %g (from %s)", zones->at(i)->name(), lookahead[closest][i], zones->at(closest)->name());
+  }
+
+  /* Check the bound on the first host of each netzone */
+  std::vector<simgrid::s4u::Host*> firsts;
+  for (auto zone : *zones)
+    firsts.push_back(first_host(zone));
+  for (unsigned i = 0; i < zones->size(); i++)
+    for (unsigned j = 0; j < zones->size(); j++) {
+      if (i == j || firsts[i] == nullptr || firsts[j] == nullptr || std::isinf(lookahead[i][j]))
+        continue;
+      std::vector<simgrid::surf::LinkImpl*> route;
+      double latency = 0;
+      firsts[i]->routeTo(firsts[j], &route, &latency);
+      xbt_assert(latency >= lookahead[i][j], "Latency from %s to %s (%g) is below the lookahead (%g)",
+                 firsts[i]->cname(), firsts[j]->cname(), latency, lookahead[i][j]);
+    }
+
+  return 0;
+}
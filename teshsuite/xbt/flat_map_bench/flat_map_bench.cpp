@@ -0,0 +1,174 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks simgrid::xbt::FlatMap against std::map, and compares its speed with xbt_dict and std::unordered_map */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "src/xbt/flat_map.hpp"
+#include "xbt/dict.h"
+
+#define MAX_TEST 200000
+
+static void check(bool condition, const char* what)
+{
+  if (not condition) {
+    fprintf(stderr, "Problem: %s!\n", what);
+    exit(1);
+  }
+}
+
+/* Random insertions, erasures and lookups, compared with std::map */
+static void test_validity()
+{
+  std::mt19937 gen(4321);
+  std::uniform_int_distribution<int> keys(0, 5000);
+  simgrid::xbt::FlatMap<int, int> map;
+  std::map<int, int> reference;
+
+  for (int i = 0; i < MAX_TEST; i++) {
+    int key = keys(gen);
+    switch (gen() % 4) {
+      case 0:
+        check(map.emplace(key, i).second == reference.emplace(key, i).second, "emplace");
+        break;
+      case 1:
+        map[key]       = i;
+        reference[key] = i;
+        break;
+      case 2:
+        check(map.erase(key) == reference.erase(key), "erase");
+        break;
+      default: {
+        auto found = map.find(key);
+        auto expected = reference.find(key);
+        check((found == map.end()) == (expected == reference.end()), "find");
+        check(found == map.end() || found->second == expected->second, "value");
+        break;
+      }
+    }
+    check(map.size() == reference.size(), "size");
+  }
+
+  /* Erase half of the elements while iterating, visiting each of them once */
+  size_t size = map.size();
+  size_t seen = 0;
+  for (auto it = map.begin(); it != map.end(); seen++) {
+    check(reference.at(it->first) == it->second, "iteration");
+    if (it->first % 2) {
+      reference.erase(it->first);
+      it = map.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  check(seen == size, "elements visited while erasing");
+  check(map.size() == reference.size(), "size after erasing while iterating");
+  for (auto const& elm : reference)
+    check(map.count(elm.first) == 1, "lookup after erasing while iterating");
+  printf("Validity test complete!\n");
+}
+
+static double now()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void report(const char* map, const char* keys, double insert_time, double lookup_time)
+{
+  printf("%-20s %-7s keys: %6.1f M inserts/s, %6.1f M lookups/s\n", map, keys, MAX_TEST / insert_time / 1e6,
+         MAX_TEST / lookup_time / 1e6);
+}
+
+template <class Map> static void bench_map(const char* name, const char* kind, std::vector<typename Map::key_type> keys)
+{
+  Map map;
+  double date = now();
+  for (size_t i = 0; i < keys.size(); i++)
+    map.emplace(keys[i], static_cast<int>(i));
+  double insert_time = now() - date;
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  long sum = 0;
+  date     = now();
+  for (auto const& key : keys)
+    sum += map.find(key)->second;
+  double lookup_time = now() - date;
+  check(sum == static_cast<long>(keys.size()) * (keys.size() - 1) / 2, "sum of the values");
+  report(name, kind, insert_time, lookup_time);
+}
+
+static void bench_dict(const char* kind, std::vector<std::string> keys)
+{
+  xbt_dict_t dict = xbt_dict_new_homogeneous(nullptr);
+  double date     = now();
+  for (size_t i = 0; i < keys.size(); i++)
+    xbt_dict_set(dict, keys[i].c_str(), reinterpret_cast<void*>(i), nullptr);
+  double insert_time = now() - date;
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  long sum = 0;
+  date     = now();
+  for (auto const& key : keys)
+    sum += reinterpret_cast<long>(xbt_dict_get(dict, key.c_str()));
+  double lookup_time = now() - date;
+  check(sum == static_cast<long>(keys.size()) * (keys.size() - 1) / 2, "sum of the values");
+  xbt_dict_free(&dict);
+  report("xbt_dict", kind, insert_time, lookup_time);
+}
+
+static void bench_dict_ext(const char* kind, std::vector<int> keys)
+{
+  xbt_dict_t dict = xbt_dict_new_homogeneous(nullptr);
+  double date     = now();
+  for (size_t i = 0; i < keys.size(); i++)
+    xbt_dict_set_ext(dict, reinterpret_cast<const char*>(&keys[i]), sizeof(int), reinterpret_cast<void*>(i), nullptr);
+  double insert_time = now() - date;
+
+  std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+  long sum = 0;
+  date     = now();
+  for (auto const& key : keys)
+    sum += reinterpret_cast<long>(xbt_dict_get_ext(dict, reinterpret_cast<const char*>(&key), sizeof(int)));
+  double lookup_time = now() - date;
+  check(sum == static_cast<long>(keys.size()) * (keys.size() - 1) / 2, "sum of the values");
+  xbt_dict_free(&dict);
+  report("xbt_dict", kind, insert_time, lookup_time);
+}
+
+int main(int argc, char** argv)
+{
+  test_validity();
+
+  std::vector<int> ints(MAX_TEST);
+  for (int i = 0; i < MAX_TEST; i++)
+    ints[i] = i * 7919;
+  std::shuffle(ints.begin(), ints.end(), std::mt19937(1234));
+  std::vector<std::string> strings;
+  for (int key : ints)
+    strings.push_back("host-" + std::to_string(key) + ".example.org");
+
+  bench_map<simgrid::xbt::FlatMap<int, int>>("xbt::FlatMap", "int", ints);
+  bench_map<std::unordered_map<int, int>>("std::unordered_map", "int", ints);
+  bench_dict_ext("int", ints);
+  bench_map<simgrid::xbt::FlatMap<std::string, int>>("xbt::FlatMap", "string", strings);
+  bench_map<std::unordered_map<std::string, int>>("std::unordered_map", "string", strings);
+  bench_dict("string", strings);
+
+  simgrid::xbt::FlatMap<int, int> map;
+  for (int i = 0; i < MAX_TEST; i++)
+    map.emplace(i, i);
+  printf("xbt::FlatMap<int, int> uses %.1f bytes per entry (%zu per element)\n",
+         static_cast<double>(map.memory_footprint()) / map.size(), sizeof(std::pair<int, int>));
+  return 0;
+}
@@ -31,5 +31,9 @@ int main(int argc, char *argv[])
   XBT_INFO("Done (strlen>%d)", (int) (10 * strlen(tmp)));
   free(tmp);
 
+  /* The pending messages of the asynchronous appender must not be lost */
+  if (argc > 1 && !strcmp(argv[1], "die"))
+    xbt_die("Dying on request");
+
   return 0;
 }
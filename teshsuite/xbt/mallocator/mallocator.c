@@ -1,5 +1,7 @@
 #include "xbt/mallocator.h"
 #include "xbt.h"
+#include "xbt/xbt_os_thread.h"
+#include "xbt/xbt_os_time.h"
 
 typedef struct element {
   int value;
@@ -32,8 +34,97 @@ static void pprint_elems(xbt_dynar_t elems) {
   printf("\n");
 }
 
+/* Contended throughput: each thread repeatedly takes a batch of objects and gives them back. The objects are tagged
+ * with the id of their thread while it holds them, to detect an object handed out twice. */
+#define BENCH_ROUNDS 200000
+#define BENCH_BATCH 16
+
+static xbt_mallocator_t bench_mallocator;
+static int bench_rounds = BENCH_ROUNDS;
+static int bench_use_malloc;
+static int bench_errors;
+
+static void *bench_thread(void *arg)
+{
+  int id = *(int *)arg;
+  element_t batch[BENCH_BATCH];
+  for (int round = 0; round < bench_rounds; round++) {
+    for (int i = 0; i < BENCH_BATCH; i++) {
+      batch[i] = bench_use_malloc ? element_mallocator_new_f() : xbt_mallocator_get(bench_mallocator);
+      batch[i]->value = id;
+    }
+    for (int i = 0; i < BENCH_BATCH; i++) {
+      if (batch[i]->value != id)
+        __sync_fetch_and_add(&bench_errors, 1);
+      if (bench_use_malloc)
+        element_mallocator_free_f(batch[i]);
+      else
+        xbt_mallocator_release(bench_mallocator, batch[i]);
+    }
+  }
+  return NULL;
+}
+
+static double bench_run(int threads_count)
+{
+  xbt_os_thread_t threads[64];
+  int ids[64];
+  xbt_os_timer_t timer = xbt_os_timer_new();
+
+  xbt_os_walltimer_start(timer);
+  for (int i = 0; i < threads_count; i++) {
+    ids[i] = i + 1;
+    threads[i] = xbt_os_thread_create("bench", bench_thread, &ids[i], NULL);
+  }
+  for (int i = 0; i < threads_count; i++)
+    xbt_os_thread_join(threads[i], NULL);
+  xbt_os_walltimer_stop(timer);
+
+  double elapsed = xbt_os_timer_elapsed(timer);
+  xbt_os_timer_free(timer);
+  return 2.0 * bench_rounds * BENCH_BATCH * threads_count / elapsed;
+}
+
+static int bench(void)
+{
+  xbt_mallocator_initialization_is_done(1); /* protected, as with parallel contexts */
+  bench_mallocator =
+      xbt_mallocator_new(65536, element_mallocator_new_f, element_mallocator_free_f, element_mallocator_reset_f);
+
+  printf("threads  mallocator (ops/s)  malloc/free (ops/s)\n");
+  for (int threads_count = 1; threads_count <= 32; threads_count *= 2) {
+    bench_use_malloc = 0;
+    double mallocator_speed = bench_run(threads_count);
+    bench_use_malloc = 1;
+    double malloc_speed = bench_run(threads_count);
+    printf("%7d  %19.3g  %19.3g\n", threads_count, mallocator_speed, malloc_speed);
+  }
+  xbt_mallocator_free(bench_mallocator);
+  printf("Objects handed out twice: %d\n", bench_errors);
+  return bench_errors != 0;
+}
+
+/* Same contention as the bench, shorter and without timings, for the test suite */
+static int check(void)
+{
+  xbt_mallocator_initialization_is_done(1);
+  bench_mallocator =
+      xbt_mallocator_new(65536, element_mallocator_new_f, element_mallocator_free_f, element_mallocator_reset_f);
+  bench_rounds = BENCH_ROUNDS / 20;
+  for (int threads_count = 1; threads_count <= 8; threads_count *= 2)
+    bench_run(threads_count);
+  xbt_mallocator_free(bench_mallocator);
+  printf("Objects handed out twice: %d\n", bench_errors);
+  return bench_errors != 0;
+}
+
 int main(int argc, char**argv)
 {
+  if (argc > 1 && !strcmp(argv[1], "--bench"))
+    return bench();
+  if (argc > 1 && !strcmp(argv[1], "--check"))
+    return check();
+
   xbt_mallocator_initialization_is_done(1);
   int i = 0;
   xbt_mallocator_t mallocator =
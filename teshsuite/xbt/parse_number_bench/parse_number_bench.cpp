@@ -0,0 +1,194 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks simgrid::xbt::parse_double() and parse_integer() against strtod() and strtoll(), and compares their speed on
+ * large inputs */
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "src/xbt/parse_number.hpp"
+
+#define MAX_TEST 1000000
+
+static void check(bool condition, const char* what, const char* input)
+{
+  if (not condition) {
+    fprintf(stderr, "Problem: %s on '%s'!\n", what, input);
+    exit(1);
+  }
+}
+
+static void check_double(const char* input)
+{
+  double expected;
+  double value;
+  char* expected_end;
+  errno                     = 0;
+  expected                  = strtod(input, &expected_end);
+  bool expected_range_error = errno == ERANGE;
+  errno                     = 0;
+  const char* end           = simgrid::xbt::parse_double(input, &value);
+  check(end == expected_end, "position after the double", input);
+  check((errno == ERANGE) == expected_range_error, "double range error", input);
+  if (std::isnan(expected))
+    check(std::isnan(value), "NaN", input);
+  else
+    check(memcmp(&value, &expected, sizeof value) == 0, "double value", input);
+}
+
+static void check_integer(const char* input)
+{
+  long long expected;
+  long long value;
+  char* expected_end;
+  errno                     = 0;
+  expected                  = strtoll(input, &expected_end, 10);
+  bool expected_range_error = errno == ERANGE;
+  errno                     = 0;
+  const char* end           = simgrid::xbt::parse_integer(input, &value);
+  check(end == expected_end, "position after the integer", input);
+  check((errno == ERANGE) == expected_range_error, "integer range error", input);
+  check(value == expected, "integer value", input);
+}
+
+/* The corner cases, then random numbers of all shapes */
+static void test_validity()
+{
+  const char* corner_cases[] = {"0", "-0", "+0", "  12", "\t-3.5", ".5", "5.", ".", "-.", "e5", "1e", "1e+", "1e-5x",
+                                "12kB", "0x1p3", "0X1A", "inf", "-Infinity", "nan", "1e400", "1e-400", "-1e-400",
+                                "4.9e-324", "1.7976931348623157e308", "9007199254740993", "123456789012345678901",
+                                "0.000000000000000000000000000001", "00000000000000000012", "9223372036854775807",
+                                "9223372036854775808", "-9223372036854775808", "-9223372036854775809", "", " ", "-"};
+  for (const char* input : corner_cases) {
+    check_double(input);
+    check_integer(input);
+  }
+
+  std::mt19937_64 gen(4321);
+  char input[64];
+  for (int i = 0; i < MAX_TEST / 10; i++) {
+    double real;
+    uint64_t bits = gen();
+    memcpy(&real, &bits, sizeof real);
+    switch (i % 4) {
+      case 0:
+        snprintf(input, sizeof input, "%.17g", real);
+        break;
+      case 1:
+        snprintf(input, sizeof input, "%.*g", static_cast<int>(gen() % 19 + 1), std::ldexp(real, -1000));
+        break;
+      case 2:
+        snprintf(input, sizeof input, "%.*f", static_cast<int>(gen() % 10), static_cast<double>(gen() % 100000000) / 7);
+        break;
+      default:
+        snprintf(input, sizeof input, "%lld", static_cast<long long>(gen()) >> (gen() % 64));
+        break;
+    }
+    check_double(input);
+    check_integer(input);
+  }
+  printf("Validity test complete!\n");
+}
+
+static double now()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Numbers separated by spaces, as in the traces and the replay files */
+template <class Print> static std::string make_input(Print print)
+{
+  std::mt19937_64 gen(42);
+  std::string res;
+  char number[64];
+  for (int i = 0; i < MAX_TEST; i++) {
+    print(number, sizeof number, gen);
+    res += number;
+    res += ' ';
+  }
+  return res;
+}
+
+/* Parses every number of the input with both parsers, checks that they agree, and reports their speeds */
+template <class T, class Parse, class Reference>
+static void bench(const char* numbers, std::string const& input, Parse parse, const char* reference_name,
+                  Reference reference)
+{
+  std::vector<T> values(MAX_TEST);
+  std::vector<T> expected(MAX_TEST);
+  const char* end = input.c_str() + input.size();
+
+  double date   = now();
+  const char* p = input.c_str();
+  for (T& value : values)
+    p = parse(p, end, &value);
+  double time = now() - date;
+
+  date = now();
+  p    = input.c_str();
+  for (T& value : expected) {
+    char* next;
+    value = reference(p, &next);
+    p     = next;
+  }
+  double reference_time = now() - date;
+
+  check(memcmp(values.data(), expected.data(), MAX_TEST * sizeof(T)) == 0, "values of the benchmark", numbers);
+  printf("%-12s %-14s %6.1f ns/number, %-8s %6.1f ns/number\n", numbers,
+         std::is_same<T, double>::value ? "parse_double:" : "parse_integer:", time * 1e9 / MAX_TEST, reference_name,
+         reference_time * 1e9 / MAX_TEST);
+}
+
+static void bench_doubles(const char* numbers, std::string const& input)
+{
+  bench<double>(numbers, input,
+                [](const char* begin, const char* end, double* value) {
+                  return simgrid::xbt::parse_double(begin, end, value);
+                },
+                "strtod:", [](const char* str, char** end) { return strtod(str, end); });
+}
+
+static void bench_integers(const char* numbers, std::string const& input)
+{
+  bench<long long>(numbers, input,
+                   [](const char* begin, const char* end, long long* value) {
+                     return simgrid::xbt::parse_integer(begin, end, value);
+                   },
+                   "strtoll:", [](const char* str, char** end) { return strtoll(str, end, 10); });
+}
+
+int main()
+{
+  test_validity();
+
+  std::string integers = make_input([](char* number, size_t size, std::mt19937_64& gen) {
+    snprintf(number, size, "%lld", static_cast<long long>(gen() % 1000000000) - 500000000);
+  });
+  std::string short_reals = make_input([](char* number, size_t size, std::mt19937_64& gen) {
+    snprintf(number, size, "%g", static_cast<double>(gen() % 100000000) / 1000);
+  });
+  std::string scientific = make_input([](char* number, size_t size, std::mt19937_64& gen) {
+    snprintf(number, size, "%.3e", std::ldexp(static_cast<double>(gen() % 1000000), static_cast<int>(gen() % 80) - 60));
+  });
+  std::string long_reals = make_input([](char* number, size_t size, std::mt19937_64& gen) {
+    snprintf(number, size, "%.17g", static_cast<double>(gen() % 1000000000) / 7);
+  });
+
+  bench_integers("integers", integers);
+  bench_doubles("integers", integers);
+  bench_doubles("short reals", short_reals);
+  bench_doubles("scientific", scientific);
+  bench_doubles("long reals", long_reals);
+  return 0;
+}
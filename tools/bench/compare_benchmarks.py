@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2017. The SimGrid Team.
+# All rights reserved.
+
+# This program is free software; you can redistribute it and/or modify it
+# under the terms of the license (GNU LGPL) which comes with this package.
+
+"""
+Compares the results of the kernel microbenchmarks of two builds, as written by run_benchmarks.py.
+
+Durations (in us) are better when lower, throughputs (in something/s) are better when higher. A metric that got worse
+by more than the threshold is flagged as a regression, and the exit status is then 1.
+
+Usage: compare_benchmarks.py [--threshold percent] reference.csv new.csv
+"""
+
+import argparse
+import csv
+import sys
+
+
+def load(filename):
+    with open(filename) as f:
+        return {(row["benchmark"], row["metric"]): (float(row["value"]), row["unit"]) for row in csv.DictReader(f)}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="slowdown (in percent) above which a metric is a regression (default: 10)")
+    parser.add_argument("reference", help="results of the reference build")
+    parser.add_argument("new", help="results of the build to check")
+    options = parser.parse_args()
+
+    reference = load(options.reference)
+    new = load(options.new)
+
+    regressions = 0
+    for key in sorted(set(reference) | set(new)):
+        name = "{}/{}".format(*key)
+        if key not in reference or key not in new:
+            print("{:40} only in {}".format(name, options.reference if key in reference else options.new))
+            continue
+        (old_value, unit) = reference[key]
+        (new_value, _) = new[key]
+        if old_value <= 0 or new_value <= 0:
+            print("{:40} {:>12.6g} -> {:<12.6g} {}".format(name, old_value, new_value, unit))
+            continue
+        # Slowdown in percent, positive when the new build is worse
+        if unit.endswith("/s"):
+            slowdown = (old_value / new_value - 1) * 100
+        else:
+            slowdown = (new_value / old_value - 1) * 100
+        flag = ""
+        if slowdown > options.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        elif slowdown < -options.threshold:
+            flag = "  improvement"
+        print("{:40} {:>12.6g} -> {:<12.6g} {:10} {:+7.1f}%{}".format(name, old_value, new_value, unit, -slowdown,
+                                                                     flag))
+
+    if regressions > 0:
+        print("{} regression(s) above {}%".format(regressions, options.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
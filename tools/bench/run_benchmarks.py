@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2017. The SimGrid Team.
+# All rights reserved.
+
+# This program is free software; you can redistribute it and/or modify it
+# under the terms of the license (GNU LGPL) which comes with this package.
+
+"""
+Runs the kernel microbenchmarks (teshsuite/bench/kernel_bench) and gathers their results in a CSV file.
+
+Each benchmark is run several times, and only its best result is kept to reduce the noise. The context switches are
+measured with every context factory that this build provides, and the route lookups are measured on platforms that
+use each kind of zone. This is what `make bench` does.
+
+Compare the results of two builds with compare_benchmarks.py.
+"""
+
+import argparse
+import os
+import subprocess
+import sys
+
+FACTORIES = ["raw", "ucontext", "boost", "thread"]
+
+# One platform per kind of zone
+ROUTING_PLATFORMS = [
+    "small_platform.xml",     # Full
+    "bypassRoute.xml",        # Dijkstra
+    "data_center.xml",        # Floyd
+    "cluster.xml",            # Cluster
+    "cluster_fat_tree.xml",   # FatTree
+    "cluster_torus.xml",      # Torus
+    "cluster_dragonfly.xml",  # Dragonfly
+    "vivaldi.xml",            # Vivaldi
+    "g5k.xml",                # Hierarchy of Full, Floyd and Cluster zones
+]
+
+
+def run(bindir, args):
+    """Runs kernel_bench once, and returns its rows as a list of (benchmark, metric, value, unit)"""
+    cmd = [os.path.join(bindir, "kernel_bench")] + args
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True)
+    if proc.returncode != 0:
+        return None
+    rows = []
+    for line in proc.stdout.splitlines():
+        fields = line.split(",")
+        if len(fields) == 4:
+            rows.append((fields[0], fields[1], float(fields[2]), fields[3]))
+    return rows
+
+
+def best(values, unit):
+    return max(values) if unit.endswith("/s") else min(values)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--bindir", default=".", help="directory containing the kernel_bench binary")
+    parser.add_argument("--platforms", required=True, help="directory containing the platforms (examples/platforms)")
+    parser.add_argument("--output", default="bench-results.csv", help="CSV file to write")
+    parser.add_argument("--repeat", type=int, default=3, help="amount of runs of each benchmark")
+    parser.add_argument("--scale", type=float, default=1.0, help="factor applied to the size of each benchmark")
+    options = parser.parse_args()
+
+    def platform(name):
+        return os.path.join(options.platforms, name)
+
+    def size(n):
+        return str(max(1, int(n * options.scale)))
+
+    runs = [["context-switch", platform("small_platform.xml"), size(100000), "--cfg=contexts/factory:" + f]
+            for f in FACTORIES]
+    runs += [["simcalls", platform("small_platform.xml"), size(100000)],
+             ["comms", platform("small_platform.xml"), size(20000)],
+             ["lmm", platform("small_platform.xml"), size(20000)]]
+    runs += [["routing", platform(p), size(100000)] for p in ROUTING_PLATFORMS]
+    runs += [["actors", platform("small_platform.xml"), size(20000)],
+             ["mailboxes", platform("small_platform.xml"), size(1000000)],
+             ["multisite", platform("g5k.xml"), size(20000)],
+             ["tracing", platform("small_platform.xml"), size(200000)]]
+
+    results = {}  # (benchmark, metric) -> (values, unit), in the order of the runs
+    for args in runs:
+        for _ in range(options.repeat):
+            rows = run(options.bindir, args + ["--log=root.thres:critical"])
+            if rows is None:
+                print("Skipping benchmark '{}' (failed or not supported by this build)".format(" ".join(args)))
+                break
+            for (benchmark, metric, value, unit) in rows:
+                results.setdefault((benchmark, metric), ([], unit))[0].append(value)
+
+    with open(options.output, "w") as out:
+        out.write("benchmark,metric,value,unit\n")
+        for (benchmark, metric), (values, unit) in results.items():
+            out.write("{},{},{:.6g},{}\n".format(benchmark, metric, best(values, unit), unit))
+            print("{:16} {:24} {:>14.6g} {}".format(benchmark, metric, best(values, unit), unit))
+    print("Results written to " + options.output)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
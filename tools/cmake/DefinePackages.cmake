@@ -30,6 +30,7 @@ set(EXTRA_DIST
   src/simix/smx_network_private.h
   src/simix/smx_private.h
   src/simix/smx_synchro_private.h
+  src/simix/smx_timer_private.h
   src/smpi/colls/coll_tuned_topo.h
   src/smpi/colls/colls_private.h
   src/smpi/colls/smpi_mvapich2_selector_stampede.h
@@ -84,6 +85,8 @@ set(EXTRA_DIST
   src/xbt/mmalloc/mmorecore.c
   src/xbt/mmalloc/mmprivate.h
   src/xbt/mmalloc/mrealloc.c
+  tools/bench/compare_benchmarks.py
+  tools/bench/run_benchmarks.py
   tools/tesh/generate_tesh
   tools/lualib.patch
   teshsuite/lua/lua_platforms.tesh
@@ -263,14 +266,24 @@ set(XBT_SRC
   src/xbt/exception.cpp
   src/xbt/graph.c
   src/xbt/heap.c
+  src/xbt/interned_string.cpp
   src/xbt/log.c
   src/xbt/mallocator.c
   src/xbt/memory_map.cpp
+  src/xbt/flat_map.hpp
   src/xbt/memory_map.hpp
   src/xbt/parmap.cpp
+  src/xbt/parse_number.cpp
+  src/xbt/parse_number.hpp
+  src/xbt/pool.cpp
+  src/xbt/pool.hpp
+  src/xbt/random.cpp
+  src/xbt/replay_binary.cpp
+  src/xbt/replay_binary.hpp
   src/xbt/snprintf.c
   src/xbt/string.cpp
   src/xbt/swag.c
+  src/xbt/xbt_log_appender_async.cpp
   src/xbt/xbt_log_appender_file.c
   src/xbt/xbt_log_layout_format.c
   src/xbt/xbt_log_layout_simple.c
@@ -319,6 +332,14 @@ set(SURF_SRC
   
   src/kernel/EngineImpl.cpp
   src/kernel/EngineImpl.hpp
+  src/kernel/MemoryAccounting.cpp
+  src/kernel/MemoryAccounting.hpp
+  src/kernel/PartitionAnalysis.cpp
+  src/kernel/PartitionAnalysis.hpp
+  src/kernel/Profiler.cpp
+  src/kernel/Profiler.hpp
+  src/kernel/ProgressReporter.cpp
+  src/kernel/ProgressReporter.hpp
 
   src/surf/cpu_cas01.cpp
   src/surf/cpu_interface.cpp
@@ -375,9 +396,12 @@ set(SIMIX_SRC
   src/simix/ActorImpl.cpp
   src/simix/ActorImpl.hpp
   src/simix/smx_synchro.cpp
+  src/simix/smx_timer.cpp
   src/simix/popping.cpp
   src/kernel/activity/ActivityImpl.cpp
   src/kernel/activity/ActivityImpl.hpp
+  src/kernel/activity/ActivitySetImpl.cpp
+  src/kernel/activity/ActivitySetImpl.hpp
   src/kernel/activity/CommImpl.cpp
   src/kernel/activity/CommImpl.hpp
   src/kernel/activity/ExecImpl.cpp
@@ -410,6 +434,7 @@ endif()
 set(S4U_SRC
   src/s4u/s4u_actor.cpp
   src/s4u/s4u_activity.cpp
+  src/s4u/s4u_activityset.cpp
   src/s4u/s4u_conditionVariable.cpp
   src/s4u/s4u_comm.cpp
   src/s4u/s4u_engine.cpp  
@@ -668,6 +693,7 @@ set(headers_to_install
   include/simgrid/link.h
   include/simgrid/s4u/forward.hpp
   include/simgrid/s4u/Activity.hpp
+  include/simgrid/s4u/ActivitySet.hpp
   include/simgrid/s4u/Actor.hpp
   include/simgrid/s4u/Comm.hpp
   include/simgrid/s4u/ConditionVariable.hpp
@@ -714,6 +740,7 @@ set(headers_to_install
   include/xbt/future.hpp
   include/xbt/graph.h
   include/xbt/heap.h
+  include/xbt/interned_string.hpp
   include/xbt/Extendable.hpp
   include/xbt/log.h
   include/xbt/log.hpp
@@ -722,6 +749,7 @@ set(headers_to_install
   include/xbt/mmalloc.h
   include/xbt/module.h
   include/xbt/parmap.h
+  include/xbt/random.hpp
   include/xbt/range.hpp
   include/xbt/replay.hpp
   include/xbt/str.h
@@ -964,6 +992,7 @@ set(CMAKEFILES_TXT
     examples/smpi/energy/f77/CMakeLists.txt
     examples/smpi/energy/f90/CMakeLists.txt
 
+  teshsuite/bench/CMakeLists.txt
   teshsuite/java/CMakeLists.txt
   teshsuite/mc/CMakeLists.txt
   teshsuite/msg/CMakeLists.txt
@@ -1008,6 +1037,7 @@ set(CMAKEFILES_TXT
   
   tools/CMakeLists.txt
   tools/graphicator/CMakeLists.txt
+  tools/replay_convert/CMakeLists.txt
   tools/tesh/CMakeLists.txt
   )
 
@@ -12,6 +12,7 @@ set(FILES_CONTAINING_UNITTESTS
   src/xbt/swag.c
   src/xbt/xbt_str.cpp
   src/xbt/config.cpp
+  src/xbt/interned_string.cpp
 )
 
 if(SIMGRID_HAVE_MC)
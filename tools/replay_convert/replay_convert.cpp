@@ -0,0 +1,27 @@
+/* Copyright (c) 2017. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Converts a time-independent trace from the text format to the binary one, or the other way around. */
+
+#include "xbt/asserts.h"
+#include "xbt/log.h"
+#include "xbt/module.h"
+#include "xbt/replay.hpp"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(replay_convert, "Replay trace converter");
+
+int main(int argc, char** argv)
+{
+  xbt_init(&argc, argv);
+  xbt_assert(argc == 3, "Usage: %s <input_trace> <output_trace>\n"
+                        "Converts a text trace to the binary format, or a binary one to the text format.",
+             argv[0]);
+
+  if (simgrid::xbt::replay_is_binary(argv[1]))
+    simgrid::xbt::replay_binary_to_text(argv[1], argv[2]);
+  else
+    simgrid::xbt::replay_text_to_binary(argv[1], argv[2]);
+  return 0;
+}